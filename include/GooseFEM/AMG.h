@@ -0,0 +1,105 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_AMG_H
+#define GOOSEFEM_AMG_H
+
+#include "config.h"
+#include "Multigrid.h"
+
+#include <Eigen/Eigen>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+namespace GooseFEM {
+
+/*
+  Smoothed-aggregation algebraic multigrid (symmetric V-cycle), for use as preconditioner of
+  "PCG" (follows Eigen's preconditioner concept), e.g.:
+
+    GooseFEM::MatrixPartitionedSolver<GooseFEM::PCG<GooseFEM::AMG>> Solver;
+    Solver.solver().preconditioner().setRigidBodyModes(mesh.coor(), K.dofs(), K.iiu());
+    Solver.solve(K, f, x);
+
+  -   Near-nullspace: the rigid body modes (translations and rotations), which are evaluated from
+      the nodal coordinates for the unknown DOFs "iiu" (the rows of the matrix that is solved,
+      e.g. "A_uu" of "MatrixPartitioned", or "A'_uu" of "MatrixPartitionedTyings"). The DOFs of
+      one node are always aggregated together. By default (no near-nullspace set) a constant
+      vector is used, and each DOF is aggregated individually.
+
+  -   Aggregation: (standard) three-phase aggregation based on the strength of connection of the
+      nodal blocks "|| A_ij ||_F^2 > theta^2 * || A_ii ||_F * || A_jj ||_F".
+
+  -   Prolongation: the tentative prolongator (from the near-nullspace, orthonormalized per
+      aggregate), smoothed by one damped Jacobi step.
+
+  -   Smoother and coarsest level: see "MultigridBase".
+*/
+
+class AMG : public MultigridBase {
+public:
+    // Constructors
+    AMG() = default;
+
+    template <class T>
+    explicit AMG(const T& A);
+
+    // Near-nullspace "B" [n, nb] and the node (or group) of each DOF [n], for the "n" rows of the
+    // matrix. The DOFs of one node are always aggregated together.
+    void setNullspace(const Eigen::MatrixXd& B, const std::vector<size_t>& node);
+
+    // Near-nullspace from the rigid body modes: row "r" of the matrix corresponds to DOF
+    // "iiu(r)", which is "dofs(m, i)" for node "m" and direction "i" (for periodic DOFs the
+    // first such node is used). Omit "iiu" if all DOFs are unknown ("iiu = arange(max(dofs) + 1)").
+    void setRigidBodyModes(
+        const xt::xtensor<double, 2>& coor,
+        const xt::xtensor<size_t, 2>& dofs,
+        const xt::xtensor<size_t, 1>& iiu);
+
+    void setRigidBodyModes(const xt::xtensor<double, 2>& coor, const xt::xtensor<size_t, 2>& dofs);
+
+    // Settings
+    void setThreshold(double theta);  // strength of connection (default: 0.08, halved per level)
+    void setCoarseSize(size_t n);     // maximum size of the coarsest level (default: 1000)
+    void setMaxLevels(size_t n);      // maximum number of levels (default: 20)
+
+    // Preconditioner concept
+    template <class T>
+    AMG& analyzePattern(const T& A);
+
+    template <class T>
+    AMG& factorize(const T& A);
+
+    template <class T>
+    AMG& compute(const T& A);
+
+private:
+    // Build the hierarchy
+    void setup(const Eigen::SparseMatrix<double>& A);
+
+    // Aggregate the nodes "node" [n] (using the strength of connection of "A", with threshold
+    // "theta"). Returns the aggregate of each node.
+    std::vector<size_t> aggregate(
+        const Eigen::SparseMatrix<double>& A,
+        const std::vector<size_t>& node,
+        size_t nnode,
+        double theta) const;
+
+    // Settings
+    double m_theta = 0.08;
+    size_t m_coarse_size = 1000;
+    size_t m_max_levels = 20;
+
+    // Near-nullspace (empty if not set)
+    Eigen::MatrixXd m_B;
+    std::vector<size_t> m_node;
+};
+
+} // namespace GooseFEM
+
+#include "AMG.hpp"
+
+#endif
@@ -0,0 +1,360 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_AMG_HPP
+#define GOOSEFEM_AMG_HPP
+
+#include "AMG.h"
+
+namespace GooseFEM {
+
+template <class T>
+inline AMG::AMG(const T& A)
+{
+    this->compute(A);
+}
+
+inline void AMG::setNullspace(const Eigen::MatrixXd& B, const std::vector<size_t>& node)
+{
+    GOOSEFEM_ASSERT(static_cast<size_t>(B.rows()) == node.size());
+    m_B = B;
+    m_node = node;
+}
+
+inline void AMG::setRigidBodyModes(
+    const xt::xtensor<double, 2>& coor,
+    const xt::xtensor<size_t, 2>& dofs,
+    const xt::xtensor<size_t, 1>& iiu)
+{
+    GOOSEFEM_ASSERT(coor.shape(0) == dofs.shape(0));
+    GOOSEFEM_ASSERT(coor.shape(1) == dofs.shape(1));
+
+    size_t nnode = dofs.shape(0);
+    size_t ndim = dofs.shape(1);
+    size_t ndof = xt::amax(dofs)() + 1;
+    size_t n = iiu.size();
+
+    // rotations: in-plane pairs of directions
+    std::vector<std::array<size_t, 2>> planes;
+
+    if (ndim == 2) {
+        planes = {{0, 1}};
+    }
+    else if (ndim == 3) {
+        planes = {{0, 1}, {1, 2}, {2, 0}};
+    }
+
+    size_t nb = ndim + planes.size();
+
+    std::vector<ptrdiff_t> row(ndof, -1);
+
+    for (size_t r = 0; r < n; ++r) {
+        GOOSEFEM_ASSERT(iiu(r) < ndof);
+        row[iiu(r)] = r;
+    }
+
+    // coordinates relative to the centre (for the conditioning of the rotations)
+    xt::xtensor<double, 1> centre = xt::mean(coor, 0);
+
+    Eigen::MatrixXd B = Eigen::MatrixXd::Zero(n, nb);
+    std::vector<size_t> node(n, nnode);
+
+    for (size_t m = 0; m < nnode; ++m) {
+        for (size_t i = 0; i < ndim; ++i) {
+            ptrdiff_t r = row[dofs(m, i)];
+            if (r < 0 || node[r] != nnode) {
+                continue;
+            }
+            node[r] = m;
+            B(r, i) = 1.0;
+            for (size_t k = 0; k < planes.size(); ++k) {
+                if (planes[k][0] == i) {
+                    B(r, ndim + k) = -(coor(m, planes[k][1]) - centre(planes[k][1]));
+                }
+                else if (planes[k][1] == i) {
+                    B(r, ndim + k) = coor(m, planes[k][0]) - centre(planes[k][0]);
+                }
+            }
+        }
+    }
+
+    this->setNullspace(B, node);
+}
+
+inline void
+AMG::setRigidBodyModes(const xt::xtensor<double, 2>& coor, const xt::xtensor<size_t, 2>& dofs)
+{
+    size_t ndof = xt::amax(dofs)() + 1;
+    this->setRigidBodyModes(coor, dofs, xt::arange<size_t>(ndof));
+}
+
+inline void AMG::setThreshold(double theta)
+{
+    m_theta = theta;
+}
+
+inline void AMG::setCoarseSize(size_t n)
+{
+    m_coarse_size = n;
+}
+
+inline void AMG::setMaxLevels(size_t n)
+{
+    GOOSEFEM_CHECK(n > 0);
+    m_max_levels = n;
+}
+
+template <class T>
+inline AMG& AMG::analyzePattern(const T&)
+{
+    return *this;
+}
+
+template <class T>
+inline AMG& AMG::factorize(const T& A)
+{
+    return this->compute(A);
+}
+
+template <class T>
+inline AMG& AMG::compute(const T& A)
+{
+    this->setup(Eigen::SparseMatrix<double>(A));
+    return *this;
+}
+
+inline std::vector<size_t> AMG::aggregate(
+    const Eigen::SparseMatrix<double>& A,
+    const std::vector<size_t>& node,
+    size_t nnode,
+    double theta) const
+{
+    using SpMat = Eigen::SparseMatrix<double>;
+
+    // strength of connection between nodes: squared Frobenius norm of the nodal blocks
+
+    SpMat G(nnode, nnode);
+    {
+        std::vector<Eigen::Triplet<double>> triplets;
+        triplets.reserve(A.nonZeros());
+
+        for (Eigen::Index k = 0; k < A.outerSize(); ++k) {
+            for (SpMat::InnerIterator it(A, k); it; ++it) {
+                triplets.emplace_back(node[it.row()], node[k], it.value() * it.value());
+            }
+        }
+
+        G.setFromTriplets(triplets.begin(), triplets.end());
+    }
+
+    Eigen::VectorXd g = G.diagonal().cwiseSqrt();
+    double theta2 = theta * theta;
+
+    std::vector<size_t> ptr(nnode + 1, 0);
+    std::vector<size_t> strong;
+    std::vector<double> strength;
+
+    for (size_t j = 0; j < nnode; ++j) {
+        for (SpMat::InnerIterator it(G, j); it; ++it) {
+            size_t i = it.row();
+            if (i != j && it.value() > theta2 * g(i) * g(j)) {
+                strong.push_back(i);
+                strength.push_back(it.value() / (g(i) * g(j)));
+            }
+        }
+        ptr[j + 1] = strong.size();
+    }
+
+    // three-phase aggregation
+
+    size_t none = std::numeric_limits<size_t>::max();
+    std::vector<size_t> ret(nnode, none);
+    size_t nagg = 0;
+
+    // phase 1: a node and its strong neighbours, if none of them is aggregated
+    for (size_t i = 0; i < nnode; ++i) {
+        if (ret[i] != none) {
+            continue;
+        }
+        bool free = true;
+        for (size_t k = ptr[i]; k < ptr[i + 1]; ++k) {
+            if (ret[strong[k]] != none) {
+                free = false;
+                break;
+            }
+        }
+        if (!free) {
+            continue;
+        }
+        ret[i] = nagg;
+        for (size_t k = ptr[i]; k < ptr[i + 1]; ++k) {
+            ret[strong[k]] = nagg;
+        }
+        nagg++;
+    }
+
+    // phase 2: join the aggregate of the strongest aggregated neighbour
+    std::vector<size_t> phase1 = ret;
+
+    for (size_t i = 0; i < nnode; ++i) {
+        if (ret[i] != none) {
+            continue;
+        }
+        double max = 0.0;
+        for (size_t k = ptr[i]; k < ptr[i + 1]; ++k) {
+            if (phase1[strong[k]] != none && strength[k] > max) {
+                max = strength[k];
+                ret[i] = phase1[strong[k]];
+            }
+        }
+    }
+
+    // phase 3: aggregate the remaining nodes with their non-aggregated strong neighbours
+    for (size_t i = 0; i < nnode; ++i) {
+        if (ret[i] != none) {
+            continue;
+        }
+        ret[i] = nagg;
+        for (size_t k = ptr[i]; k < ptr[i + 1]; ++k) {
+            if (ret[strong[k]] == none) {
+                ret[strong[k]] = nagg;
+            }
+        }
+        nagg++;
+    }
+
+    return ret;
+}
+
+inline void AMG::setup(const Eigen::SparseMatrix<double>& A)
+{
+    using SpMat = Eigen::SparseMatrix<double>;
+
+    size_t n = static_cast<size_t>(A.rows());
+
+    // near-nullspace and nodes of the finest level (renumbered to "0 <= node < nnode")
+
+    Eigen::MatrixXd B;
+    std::vector<size_t> node(n);
+    size_t nnode = 0;
+
+    if (m_B.size() == 0) {
+        B = Eigen::MatrixXd::Ones(n, 1);
+        std::iota(node.begin(), node.end(), 0);
+        nnode = n;
+    }
+    else {
+        GOOSEFEM_CHECK(static_cast<size_t>(m_B.rows()) == n);
+        B = m_B;
+        std::unordered_map<size_t, size_t> renum;
+        for (size_t r = 0; r < n; ++r) {
+            auto it = renum.emplace(m_node[r], renum.size()).first;
+            node[r] = it->second;
+        }
+        nnode = renum.size();
+    }
+
+    this->init(A);
+
+    while (true) {
+
+        const Level& level = m_levels.back();
+        size_t nl = static_cast<size_t>(level.A.rows());
+
+        if (nl <= m_coarse_size || m_levels.size() >= m_max_levels) {
+            break;
+        }
+
+        double theta = m_theta * std::pow(0.5, static_cast<double>(m_levels.size()));
+        std::vector<size_t> agg = this->aggregate(level.A, node, nnode, theta);
+        size_t nagg = *std::max_element(agg.begin(), agg.end()) + 1;
+
+        if (nagg == nnode) {
+            break;
+        }
+
+        // DOFs per aggregate
+
+        std::vector<size_t> ptr(nagg + 1, 0);
+        std::vector<size_t> rows(nl);
+
+        for (size_t r = 0; r < nl; ++r) {
+            ptr[agg[node[r]] + 1]++;
+        }
+
+        std::partial_sum(ptr.begin(), ptr.end(), ptr.begin());
+
+        {
+            std::vector<size_t> cursor(ptr.begin(), ptr.end() - 1);
+            for (size_t r = 0; r < nl; ++r) {
+                rows[cursor[agg[node[r]]]++] = r;
+            }
+        }
+
+        // coarse DOFs per aggregate, and entries of the tentative prolongator
+
+        size_t nb = static_cast<size_t>(B.cols());
+        std::vector<size_t> cptr(nagg + 1, 0);
+        std::vector<size_t> tptr(nagg + 1, 0);
+
+        for (size_t a = 0; a < nagg; ++a) {
+            size_t r = ptr[a + 1] - ptr[a];
+            cptr[a + 1] = cptr[a] + std::min(r, nb);
+            tptr[a + 1] = tptr[a] + r * std::min(r, nb);
+        }
+
+        size_t nc = cptr[nagg];
+        Eigen::MatrixXd Bc = Eigen::MatrixXd::Zero(nc, nb);
+        std::vector<size_t> cnode(nc);
+        std::vector<Eigen::Triplet<double>> triplets(tptr[nagg]);
+
+        // tentative prolongator: orthonormalize the near-nullspace per aggregate, "B_a = Q * R",
+        // with "Q" the prolongator and "R" the coarse near-nullspace
+
+        #pragma omp parallel for schedule(dynamic, 64)
+        for (size_t a = 0; a < nagg; ++a) {
+            size_t r = ptr[a + 1] - ptr[a];
+            size_t k = cptr[a + 1] - cptr[a];
+            Eigen::MatrixXd Ba(r, nb);
+
+            for (size_t i = 0; i < r; ++i) {
+                Ba.row(i) = B.row(rows[ptr[a] + i]);
+            }
+
+            Eigen::HouseholderQR<Eigen::MatrixXd> qr(Ba);
+            Eigen::MatrixXd Q = qr.householderQ() * Eigen::MatrixXd::Identity(r, k);
+            Bc.middleRows(cptr[a], k) =
+                qr.matrixQR().topRows(k).triangularView<Eigen::Upper>().toDenseMatrix();
+
+            for (size_t c = 0; c < k; ++c) {
+                cnode[cptr[a] + c] = a;
+                for (size_t i = 0; i < r; ++i) {
+                    triplets[tptr[a] + c * r + i] =
+                        Eigen::Triplet<double>(rows[ptr[a] + i], cptr[a] + c, Q(i, c));
+                }
+            }
+        }
+
+        SpMat T(nl, nc);
+        T.setFromTriplets(triplets.begin(), triplets.end());
+
+        // smoothed prolongator (and Galerkin coarse operator)
+
+        Eigen::VectorXd w = (4.0 / (3.0 * level.rho)) * level.invdiag;
+        SpMat AT = level.A * T;
+        this->coarsen(T - w.asDiagonal() * AT);
+
+        B = std::move(Bc);
+        node = std::move(cnode);
+        nnode = nagg;
+    }
+
+    this->finalize();
+}
+
+} // namespace GooseFEM
+
+#endif
@@ -217,7 +217,12 @@ inline size_t Quadrature::nip() const
 
 inline xt::xtensor<double, 4> Quadrature::GradN() const
 {
-    return m_dNx;
+    if (!m_parent) {
+        return m_dNx;
+    }
+
+    xt::xtensor<double, 4> ret = xt::view(m_parent->m_dNx, xt::keep(m_elem));
+    return ret;
 }
 
 template <size_t rank>
@@ -230,16 +235,53 @@ Quadrature::asTensor(const xt::xtensor<double, 2>& arg, xt::xtensor<double, 2 +
 
 inline xt::xtensor<double, 2> Quadrature::dV() const
 {
-    return m_vol;
+    if (!m_parent) {
+        return m_vol;
+    }
+
+    xt::xtensor<double, 2> ret = xt::view(m_parent->m_vol, xt::keep(m_elem));
+    return ret;
 }
 
 inline void Quadrature::update_x(const xt::xtensor<double, 3>& x)
 {
+    GOOSEFEM_CHECK(!m_parent);
     GOOSEFEM_ASSERT(x.shape() == m_x.shape());
     xt::noalias(m_x) = x;
     compute_dN();
 }
 
+inline Quadrature Quadrature::Subset(const xt::xtensor<size_t, 1>& elements) const
+{
+    GOOSEFEM_ASSERT(elements.size() == 0 || xt::amax(elements)() < m_nelem);
+
+    Quadrature ret;
+    ret.m_nelem = elements.size();
+    ret.m_nip = m_nip;
+    ret.m_w = m_w;
+    ret.m_xi = m_xi;
+    ret.m_N = m_N;
+    ret.m_dNxi = m_dNxi;
+    ret.m_parent = &this->geometry();
+    ret.m_elem = xt::empty<size_t>({elements.size()});
+
+    for (size_t e = 0; e < elements.size(); ++e) {
+        ret.m_elem(e) = this->elem(elements(e));
+    }
+
+    return ret;
+}
+
+inline size_t Quadrature::elem(size_t e) const
+{
+    return m_parent ? m_elem(e) : e;
+}
+
+inline const Quadrature& Quadrature::geometry() const
+{
+    return m_parent ? *m_parent : *this;
+}
+
 inline void Quadrature::compute_dN()
 {
     #pragma omp parallel
@@ -294,7 +336,8 @@ inline void Quadrature::gradN_vector(
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(
+                &this->geometry().m_dNx(this->elem(e), q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto gradu = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_ndim, m_ndim>());
 
             // gradu(i,j) += dNx(m,i) * u(m,j)
@@ -323,7 +366,8 @@ inline void Quadrature::gradN_vector_T(
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(
+                &this->geometry().m_dNx(this->elem(e), q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto gradu = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_ndim, m_ndim>());
 
             // gradu(j,i) += dNx(m,i) * u(m,j)
@@ -352,7 +396,8 @@ inline void Quadrature::symGradN_vector(
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(
+                &this->geometry().m_dNx(this->elem(e), q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto eps = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_ndim, m_ndim>());
 
             // gradu(i,j) += dNx(m,i) * u(m,j)
@@ -385,7 +430,7 @@ inline void Quadrature::int_N_scalar_NT_dV(
         for (size_t q = 0; q < m_nip; ++q) {
 
             auto N = xt::adapt(&m_N(q, 0), xt::xshape<m_nne>());
-            auto& vol = m_vol(e, q);
+            auto& vol = this->geometry().m_vol(this->elem(e), q);
             auto& rho = qscalar(e, q);
 
             // M(m*ndim+i,n*ndim+i) += N(m) * scalar * N(n) * dV
@@ -414,9 +459,10 @@ inline void Quadrature::int_gradN_dot_tensor2_dV(
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(
+                &this->geometry().m_dNx(this->elem(e), q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto sig = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_ndim, m_ndim>());
-            auto& vol = m_vol(e, q);
+            auto& vol = this->geometry().m_vol(this->elem(e), q);
 
             for (size_t m = 0; m < m_nne; ++m) {
                 f(m, 0) += (dNx(m, 0) * sig(0, 0) + dNx(m, 1) * sig(1, 0)) * vol;
@@ -441,9 +487,10 @@ inline void Quadrature::int_gradN_dot_tensor4_dot_gradNT_dV(
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(
+                &this->geometry().m_dNx(this->elem(e), q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto C = xt::adapt(&qtensor(e, q, 0, 0, 0, 0), xt::xshape<m_ndim, m_ndim, m_ndim, m_ndim>());
-            auto& vol = m_vol(e, q);
+            auto& vol = this->geometry().m_vol(this->elem(e), q);
 
             for (size_t m = 0; m < m_nne; ++m) {
                 for (size_t n = 0; n < m_nne; ++n) {
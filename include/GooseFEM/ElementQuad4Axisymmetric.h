@@ -36,7 +36,15 @@ public:
         const xt::xtensor<double, 2>& xi,
         const xt::xtensor<double, 1>& w);
 
+    // View on a subset of elements: the geometry ("x", shape function gradients, and
+    // integration volume) of this object is used (no copy), this object should outlive the view.
+    // Copies of the view are views on the same object (whereas copies of a full object are
+    // independent). Update the geometry using the full object, the view sees the update.
+    // All "elemvec", "elemmat", "qtensor", and "qscalar" of the subset have "nelem = elements.size()".
+    QuadratureAxisymmetric Subset(const xt::xtensor<size_t, 1>& elements) const;
+
     // Update the nodal positions (shape of "x" should match the earlier definition)
+    // Not allowed for a subset (update the full object instead)
     void update_x(const xt::xtensor<double, 3>& x);
 
     // Return dimensions
@@ -105,6 +113,12 @@ private:
     // Compute "vol" and "B" based on current "x"
     void compute_dN();
 
+    // Index of element "e" in the data arrays per element (only differs from "e" for a subset)
+    size_t elem(size_t e) const;
+
+    // Object that holds the data arrays per element ("m_parent" for a subset, otherwise "this")
+    const QuadratureAxisymmetric& geometry() const;
+
 private:
     // Dimensions (flexible)
     size_t m_nelem; // number of elements
@@ -116,13 +130,19 @@ private:
     static const size_t m_tdim = 3; // number of dimensions of tensors
 
     // Data arrays
-    xt::xtensor<double, 3> m_x;    // nodal positions stored per element [nelem, nne, ndim]
     xt::xtensor<double, 1> m_w;    // weight of each integration point [nip]
     xt::xtensor<double, 2> m_xi;   // local coordinate of each integration point [nip, ndim]
     xt::xtensor<double, 2> m_N;    // shape functions [nip, nne]
     xt::xtensor<double, 3> m_dNxi; // shape function grad. wrt local  coor. [nip, nne, ndim]
-    xt::xtensor<double, 6> m_B;    // B-matrix [nelem, nne, tdim, tdim, tdim]
-    xt::xtensor<double, 2> m_vol;  // integration point volume [nelem, nip]
+
+    // Data arrays per element
+    xt::xtensor<double, 3> m_x;   // nodal positions stored per element [nelem, nne, ndim]
+    xt::xtensor<double, 6> m_B;   // B-matrix [nelem, nip, nne, tdim, tdim, tdim]
+    xt::xtensor<double, 2> m_vol; // integration point volume [nelem, nip]
+
+    // Subset: the data arrays per element of the full object are used (not owned)
+    const QuadratureAxisymmetric* m_parent = nullptr; // full object ("nullptr" if not a subset)
+    xt::xtensor<size_t, 1> m_elem;                    // element numbers in the full object [nelem]
 };
 
 } // namespace Quad4
@@ -92,16 +92,53 @@ QuadratureAxisymmetric::asTensor(const xt::xtensor<double, 2>& arg, xt::xtensor<
 
 inline xt::xtensor<double, 2> QuadratureAxisymmetric::dV() const
 {
-    return m_vol;
+    if (!m_parent) {
+        return m_vol;
+    }
+
+    xt::xtensor<double, 2> ret = xt::view(m_parent->m_vol, xt::keep(m_elem));
+    return ret;
 }
 
 inline void QuadratureAxisymmetric::update_x(const xt::xtensor<double, 3>& x)
 {
+    GOOSEFEM_CHECK(!m_parent);
     GOOSEFEM_ASSERT(x.shape() == m_x.shape());
     xt::noalias(m_x) = x;
     compute_dN();
 }
 
+inline QuadratureAxisymmetric QuadratureAxisymmetric::Subset(const xt::xtensor<size_t, 1>& elements) const
+{
+    GOOSEFEM_ASSERT(elements.size() == 0 || xt::amax(elements)() < m_nelem);
+
+    QuadratureAxisymmetric ret;
+    ret.m_nelem = elements.size();
+    ret.m_nip = m_nip;
+    ret.m_w = m_w;
+    ret.m_xi = m_xi;
+    ret.m_N = m_N;
+    ret.m_dNxi = m_dNxi;
+    ret.m_parent = &this->geometry();
+    ret.m_elem = xt::empty<size_t>({elements.size()});
+
+    for (size_t e = 0; e < elements.size(); ++e) {
+        ret.m_elem(e) = this->elem(elements(e));
+    }
+
+    return ret;
+}
+
+inline size_t QuadratureAxisymmetric::elem(size_t e) const
+{
+    return m_parent ? m_elem(e) : e;
+}
+
+inline const QuadratureAxisymmetric& QuadratureAxisymmetric::geometry() const
+{
+    return m_parent ? *m_parent : *this;
+}
+
 inline void QuadratureAxisymmetric::compute_dN()
 {
     // most components remain zero, and are not written
@@ -173,7 +210,9 @@ inline void QuadratureAxisymmetric::gradN_vector(
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto B = xt::adapt(&m_B(e, q, 0, 0, 0, 0), xt::xshape<m_nne, m_tdim, m_tdim, m_tdim>());
+            auto B = xt::adapt(
+                &this->geometry().m_B(this->elem(e), q, 0, 0, 0, 0),
+                xt::xshape<m_nne, m_tdim, m_tdim, m_tdim>());
             auto gradu = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_tdim, m_tdim>());
 
             // gradu(i,j) += B(m,i,j,k) * u(m,perm(k))
@@ -207,7 +246,9 @@ inline void QuadratureAxisymmetric::gradN_vector_T(
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto B = xt::adapt(&m_B(e, q, 0, 0, 0, 0), xt::xshape<m_nne, m_tdim, m_tdim, m_tdim>());
+            auto B = xt::adapt(
+                &this->geometry().m_B(this->elem(e), q, 0, 0, 0, 0),
+                xt::xshape<m_nne, m_tdim, m_tdim, m_tdim>());
             auto gradu = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_tdim, m_tdim>());
 
             // gradu(j,i) += B(m,i,j,k) * u(m,perm(k))
@@ -241,7 +282,9 @@ inline void QuadratureAxisymmetric::symGradN_vector(
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto B = xt::adapt(&m_B(e, q, 0, 0, 0, 0), xt::xshape<m_nne, m_tdim, m_tdim, m_tdim>());
+            auto B = xt::adapt(
+                &this->geometry().m_B(this->elem(e), q, 0, 0, 0, 0),
+                xt::xshape<m_nne, m_tdim, m_tdim, m_tdim>());
             auto eps = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_tdim, m_tdim>());
 
             // gradu(j,i) += B(m,i,j,k) * u(m,perm(k))
@@ -278,7 +321,7 @@ inline void QuadratureAxisymmetric::int_N_scalar_NT_dV(
         for (size_t q = 0; q < m_nip; ++q) {
 
             auto N = xt::adapt(&m_N(q, 0), xt::xshape<m_nne>());
-            auto& vol = m_vol(e, q);
+            auto& vol = this->geometry().m_vol(this->elem(e), q);
             auto& rho = qscalar(e, q);
 
             // M(m*ndim+i,n*ndim+i) += N(m) * scalar * N(n) * dV
@@ -307,9 +350,11 @@ inline void QuadratureAxisymmetric::int_gradN_dot_tensor2_dV(
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto B = xt::adapt(&m_B(e, q, 0, 0, 0, 0), xt::xshape<m_nne, m_tdim, m_tdim, m_tdim>());
+            auto B = xt::adapt(
+                &this->geometry().m_B(this->elem(e), q, 0, 0, 0, 0),
+                xt::xshape<m_nne, m_tdim, m_tdim, m_tdim>());
             auto sig = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_tdim, m_tdim>());
-            auto& vol = m_vol(e, q);
+            auto& vol = this->geometry().m_vol(this->elem(e), q);
 
             // f(m,i) += B(m,i,j,perm(k)) * sig(i,j) * dV
             // (where perm(0) = 1, perm(2) = 0)
@@ -337,9 +382,11 @@ inline void QuadratureAxisymmetric::int_gradN_dot_tensor4_dot_gradNT_dV(
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto B = xt::adapt(&m_B(e, q, 0, 0, 0, 0), xt::xshape<m_nne, m_tdim, m_tdim, m_tdim>());
+            auto B = xt::adapt(
+                &this->geometry().m_B(this->elem(e), q, 0, 0, 0, 0),
+                xt::xshape<m_nne, m_tdim, m_tdim, m_tdim>());
             auto C = xt::adapt(&qtensor(e, q, 0, 0, 0, 0), xt::xshape<m_tdim, m_tdim, m_tdim, m_tdim>());
-            auto& vol = m_vol(e, q);
+            auto& vol = this->geometry().m_vol(this->elem(e), q);
 
             // K(m*m_ndim+perm(c), n*m_ndim+perm(f)) = B(m,a,b,c) * C(a,b,d,e) * B(n,e,d,f) * vol;
             // (where perm(0) = 1, perm(2) = 0)
@@ -85,7 +85,12 @@ inline size_t QuadraturePlanar::nip() const
 
 inline xt::xtensor<double, 4> QuadraturePlanar::GradN() const
 {
-    return m_dNx;
+    if (!m_parent) {
+        return m_dNx;
+    }
+
+    xt::xtensor<double, 4> ret = xt::view(m_parent->m_dNx, xt::keep(m_elem));
+    return ret;
 }
 
 template <size_t rank>
@@ -98,16 +103,54 @@ QuadraturePlanar::asTensor(const xt::xtensor<double, 2>& arg, xt::xtensor<double
 
 inline xt::xtensor<double, 2> QuadraturePlanar::dV() const
 {
-    return m_vol;
+    if (!m_parent) {
+        return m_vol;
+    }
+
+    xt::xtensor<double, 2> ret = xt::view(m_parent->m_vol, xt::keep(m_elem));
+    return ret;
 }
 
 inline void QuadraturePlanar::update_x(const xt::xtensor<double, 3>& x)
 {
+    GOOSEFEM_CHECK(!m_parent);
     GOOSEFEM_ASSERT(x.shape() == m_x.shape());
     xt::noalias(m_x) = x;
     compute_dN();
 }
 
+inline QuadraturePlanar QuadraturePlanar::Subset(const xt::xtensor<size_t, 1>& elements) const
+{
+    GOOSEFEM_ASSERT(elements.size() == 0 || xt::amax(elements)() < m_nelem);
+
+    QuadraturePlanar ret;
+    ret.m_nelem = elements.size();
+    ret.m_nip = m_nip;
+    ret.m_w = m_w;
+    ret.m_xi = m_xi;
+    ret.m_N = m_N;
+    ret.m_dNxi = m_dNxi;
+    ret.m_thick = m_thick;
+    ret.m_parent = &this->geometry();
+    ret.m_elem = xt::empty<size_t>({elements.size()});
+
+    for (size_t e = 0; e < elements.size(); ++e) {
+        ret.m_elem(e) = this->elem(elements(e));
+    }
+
+    return ret;
+}
+
+inline size_t QuadraturePlanar::elem(size_t e) const
+{
+    return m_parent ? m_elem(e) : e;
+}
+
+inline const QuadraturePlanar& QuadraturePlanar::geometry() const
+{
+    return m_parent ? *m_parent : *this;
+}
+
 inline void QuadraturePlanar::compute_dN()
 {
     #pragma omp parallel
@@ -164,7 +207,8 @@ inline void QuadraturePlanar::gradN_vector(
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(
+                &this->geometry().m_dNx(this->elem(e), q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto gradu = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_tdim, m_tdim>());
 
             // gradu(i,j) += dNx(m,i) * u(m,j)
@@ -195,7 +239,8 @@ inline void QuadraturePlanar::gradN_vector_T(
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(
+                &this->geometry().m_dNx(this->elem(e), q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto gradu = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_tdim, m_tdim>());
 
             // gradu(j,i) += dNx(m,i) * u(m,j)
@@ -226,7 +271,8 @@ inline void QuadraturePlanar::symGradN_vector(
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(
+                &this->geometry().m_dNx(this->elem(e), q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto eps = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_tdim, m_tdim>());
 
             // gradu(i,j) += dNx(m,i) * u(m,j)
@@ -259,7 +305,7 @@ inline void QuadraturePlanar::int_N_scalar_NT_dV(
         for (size_t q = 0; q < m_nip; ++q) {
 
             auto N = xt::adapt(&m_N(q, 0), xt::xshape<m_nne>());
-            auto& vol = m_vol(e, q);
+            auto& vol = this->geometry().m_vol(this->elem(e), q);
             auto& rho = qscalar(e, q);
 
             // M(m*ndim+i,n*ndim+i) += N(m) * scalar * N(n) * dV
@@ -288,9 +334,10 @@ inline void QuadraturePlanar::int_gradN_dot_tensor2_dV(
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(
+                &this->geometry().m_dNx(this->elem(e), q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto sig = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_tdim, m_tdim>());
-            auto& vol = m_vol(e, q);
+            auto& vol = this->geometry().m_vol(this->elem(e), q);
 
             for (size_t m = 0; m < m_nne; ++m) {
                 f(m, 0) += (dNx(m, 0) * sig(0, 0) + dNx(m, 1) * sig(1, 0)) * vol;
@@ -315,9 +362,10 @@ inline void QuadraturePlanar::int_gradN_dot_tensor4_dot_gradNT_dV(
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(
+                &this->geometry().m_dNx(this->elem(e), q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto C = xt::adapt(&qtensor(e, q, 0, 0, 0, 0), xt::xshape<m_tdim, m_tdim, m_tdim, m_tdim>());
-            auto& vol = m_vol(e, q);
+            auto& vol = this->geometry().m_vol(this->elem(e), q);
 
             for (size_t m = 0; m < m_nne; ++m) {
                 for (size_t n = 0; n < m_nne; ++n) {
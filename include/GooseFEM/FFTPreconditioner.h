@@ -0,0 +1,135 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_FFTPRECONDITIONER_H
+#define GOOSEFEM_FFTPRECONDITIONER_H
+
+#include "config.h"
+
+#include <complex>
+#include <Eigen/Eigen>
+#include <Eigen/Sparse>
+
+namespace GooseFEM {
+
+namespace detail {
+
+    // Discrete Fourier transform of a fixed length "n" (unnormalized, "exp(-2 pi i j k / n)"):
+    // iterative radix-2 if "n" is a power of two, Bluestein's algorithm otherwise
+    class FFT {
+    public:
+        FFT() = default;
+        explicit FFT(size_t n);
+
+        size_t size() const;
+
+        // In-place transform of "x" [n], using "work" as workspace (resized as needed)
+        void forward(std::complex<double>* x, std::vector<std::complex<double>>& work) const;
+        void inverse(std::complex<double>* x, std::vector<std::complex<double>>& work) const;
+
+    private:
+        // Radix-2 transform of "x" [m] (forward)
+        void radix2(std::complex<double>* x) const;
+
+        size_t m_n = 0;
+        size_t m_m = 0;                              // size of the radix-2 transform
+        std::vector<std::complex<double>> m_twiddle; // radix-2 twiddle factors [m / 2]
+        std::vector<std::complex<double>> m_chirp;   // Bluestein: "exp(-i pi k^2 / n)" [n]
+        std::vector<std::complex<double>> m_kernel;  // Bluestein: transform of the kernel [m]
+    };
+
+} // namespace detail
+
+/*
+  Preconditioner for periodic problems on Regular meshes (e.g. "Mesh::Quad4::Regular" or
+  "Mesh::Hex8::Regular" with "dofsPeriodic()"): the exact inverse of the stiffness of a
+  homogeneous reference medium, which is block-circulant and is therefore inverted in Fourier
+  space (per wave-vector a "ndim x ndim" system). For use as preconditioner of "PCG" for
+  heterogeneous RVEs, e.g.:
+
+    GooseFEM::MatrixPartitionedSolver<GooseFEM::PCG<GooseFEM::FFTPreconditioner>> Solver;
+    Solver.solver().preconditioner().setReference(mesh, K.dofs(), K.iiu(), Ke);
+    Solver.solve(K, f, x);
+
+  with "Ke" the element stiffness of the reference medium (e.g. the average element stiffness).
+  The number of iterations depends on the contrast between the elements and the reference medium,
+  but not on the number of elements. Applying the preconditioner costs "O(N log N)".
+
+  -   Row "r" of the matrix corresponds to DOF "iiu(r)", which is "dofs(m, i)" for node "m" and
+      direction "i".
+  -   The reference stiffness is singular (the rigid body translations). The matrix should be
+      made non-singular by prescribing the displacement of (at least) one node, as usual. The
+      reaction force is applied at the prescribed DOFs, and the translation is chosen such that
+      their (average) displacement is zero. For one prescribed node this is the exact inverse of
+      the partitioned reference stiffness.
+
+  Follows Eigen's preconditioner concept.
+*/
+
+class FFTPreconditioner {
+public:
+    using StorageIndex = typename Eigen::SparseMatrix<double>::StorageIndex;
+    enum { ColsAtCompileTime = Eigen::Dynamic, MaxColsAtCompileTime = Eigen::Dynamic };
+
+    // Constructors
+    FFTPreconditioner() = default;
+
+    // Reference medium: element stiffness "Ke" [nne * ndim, nne * ndim] of the elements of
+    // "mesh" (which should be Regular, with periodic "dofs"). Omit "iiu" if all DOFs are unknown.
+    template <class Mesh>
+    void setReference(
+        const Mesh& mesh,
+        const xt::xtensor<size_t, 2>& dofs,
+        const xt::xtensor<size_t, 1>& iiu,
+        const xt::xtensor<double, 2>& Ke);
+
+    template <class Mesh>
+    void setReference(
+        const Mesh& mesh, const xt::xtensor<size_t, 2>& dofs, const xt::xtensor<double, 2>& Ke);
+
+    // Dimensions
+    Eigen::Index rows() const;
+    Eigen::Index cols() const;
+
+    // Preconditioner concept (the preconditioner does not depend on the matrix)
+    template <class T>
+    FFTPreconditioner& analyzePattern(const T& A);
+
+    template <class T>
+    FFTPreconditioner& factorize(const T& A);
+
+    template <class T>
+    FFTPreconditioner& compute(const T& A);
+
+    // Apply the preconditioner
+    template <class Rhs>
+    Eigen::VectorXd solve(const Eigen::MatrixBase<Rhs>& b) const;
+
+    Eigen::ComputationInfo info() const;
+
+    // Number of grid points per direction
+    std::vector<size_t> shape() const;
+
+private:
+    // Multi-dimensional (unnormalized) transform of "x" [ngrid]
+    void transform(std::complex<double>* x, bool inverse) const;
+
+    size_t m_ndim = 0;
+    size_t m_ngrid = 0;
+    Eigen::Index m_n = 0;
+    std::vector<size_t> m_shape;              // grid points per direction
+    std::vector<detail::FFT> m_fft;           // transform per direction
+    std::vector<size_t> m_index;              // row -> "direction * ngrid + grid point" [n]
+    std::vector<std::vector<size_t>> m_fixed; // prescribed grid points per direction
+    std::vector<std::complex<double>> m_inv;  // inverse reference stiffness [ngrid, ndim, ndim]
+    Eigen::ComputationInfo m_info = Eigen::InvalidInput;
+};
+
+} // namespace GooseFEM
+
+#include "FFTPreconditioner.hpp"
+
+#endif
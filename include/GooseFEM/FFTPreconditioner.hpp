@@ -0,0 +1,435 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_FFTPRECONDITIONER_HPP
+#define GOOSEFEM_FFTPRECONDITIONER_HPP
+
+#include "FFTPreconditioner.h"
+
+namespace GooseFEM {
+
+namespace detail {
+
+    inline FFT::FFT(size_t n) : m_n(n)
+    {
+        GOOSEFEM_ASSERT(n > 0);
+
+        bool pow2 = (n & (n - 1)) == 0;
+        size_t target = pow2 ? n : 2 * n - 1;
+
+        m_m = 1;
+        while (m_m < target) {
+            m_m *= 2;
+        }
+
+        m_twiddle.resize(m_m / 2);
+
+        for (size_t k = 0; k < m_m / 2; ++k) {
+            m_twiddle[k] = std::polar(1.0, -2.0 * M_PI * static_cast<double>(k) / m_m);
+        }
+
+        if (pow2) {
+            return;
+        }
+
+        // Bluestein: "X_k = c_k * sum_j (x_j c_j) conj(c_{k - j})" with "c_k = exp(-i pi k^2 / n)",
+        // the convolution is evaluated using radix-2 transforms of size "m >= 2 n - 1"
+
+        m_chirp.resize(n);
+
+        for (size_t k = 0; k < n; ++k) {
+            size_t k2 = (k * k) % (2 * n);
+            m_chirp[k] = std::polar(1.0, -M_PI * static_cast<double>(k2) / n);
+        }
+
+        m_kernel.assign(m_m, 0.0);
+        m_kernel[0] = std::conj(m_chirp[0]);
+
+        for (size_t k = 1; k < n; ++k) {
+            m_kernel[k] = std::conj(m_chirp[k]);
+            m_kernel[m_m - k] = std::conj(m_chirp[k]);
+        }
+
+        this->radix2(m_kernel.data());
+    }
+
+    inline size_t FFT::size() const
+    {
+        return m_n;
+    }
+
+    inline void FFT::radix2(std::complex<double>* x) const
+    {
+        // bit-reversal permutation
+        for (size_t i = 1, j = 0; i < m_m; ++i) {
+            size_t bit = m_m >> 1;
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+            j ^= bit;
+            if (i < j) {
+                std::swap(x[i], x[j]);
+            }
+        }
+
+        // butterflies
+        for (size_t len = 2; len <= m_m; len *= 2) {
+            size_t half = len / 2;
+            size_t step = m_m / len;
+            for (size_t i = 0; i < m_m; i += len) {
+                for (size_t j = 0; j < half; ++j) {
+                    std::complex<double> u = x[i + j];
+                    std::complex<double> v = x[i + j + half] * m_twiddle[j * step];
+                    x[i + j] = u + v;
+                    x[i + j + half] = u - v;
+                }
+            }
+        }
+    }
+
+    inline void FFT::forward(std::complex<double>* x, std::vector<std::complex<double>>& work) const
+    {
+        if (m_chirp.size() == 0) {
+            this->radix2(x);
+            return;
+        }
+
+        work.assign(m_m, 0.0);
+
+        for (size_t k = 0; k < m_n; ++k) {
+            work[k] = x[k] * m_chirp[k];
+        }
+
+        this->radix2(work.data());
+
+        // convolution: inverse transform of the product, using "ifft(y) = conj(fft(conj(y))) / m"
+        for (size_t k = 0; k < m_m; ++k) {
+            work[k] = std::conj(work[k] * m_kernel[k]);
+        }
+
+        this->radix2(work.data());
+
+        double scale = 1.0 / static_cast<double>(m_m);
+
+        for (size_t k = 0; k < m_n; ++k) {
+            x[k] = m_chirp[k] * std::conj(work[k]) * scale;
+        }
+    }
+
+    inline void FFT::inverse(std::complex<double>* x, std::vector<std::complex<double>>& work) const
+    {
+        for (size_t k = 0; k < m_n; ++k) {
+            x[k] = std::conj(x[k]);
+        }
+
+        this->forward(x, work);
+
+        for (size_t k = 0; k < m_n; ++k) {
+            x[k] = std::conj(x[k]);
+        }
+    }
+
+} // namespace detail
+
+template <class Mesh>
+inline void FFTPreconditioner::setReference(
+    const Mesh& mesh,
+    const xt::xtensor<size_t, 2>& dofs,
+    const xt::xtensor<size_t, 1>& iiu,
+    const xt::xtensor<double, 2>& Ke)
+{
+    xt::xtensor<double, 2> coor = mesh.coor();
+    xt::xtensor<size_t, 2> conn = mesh.conn();
+    double h = mesh.h();
+
+    size_t nnode = coor.shape(0);
+    size_t ndim = coor.shape(1);
+    size_t nne = conn.shape(1);
+    size_t ndof = xt::amax(dofs)() + 1;
+    size_t none = std::numeric_limits<size_t>::max();
+
+    GOOSEFEM_ASSERT(ndim <= 3);
+    GOOSEFEM_ASSERT(dofs.shape(0) == nnode);
+    GOOSEFEM_ASSERT(dofs.shape(1) == ndim);
+    GOOSEFEM_ASSERT(Ke.shape(0) == nne * ndim);
+    GOOSEFEM_ASSERT(Ke.shape(1) == nne * ndim);
+
+    // grid: the nodes of the periodic mesh (without the periodic images)
+
+    m_ndim = ndim;
+    m_shape.resize(ndim);
+    m_fft.resize(ndim);
+    m_ngrid = 1;
+
+    for (size_t d = 0; d < ndim; ++d) {
+        double l = 0.0;
+        for (size_t m = 0; m < nnode; ++m) {
+            l = std::max(l, coor(m, d));
+        }
+        m_shape[d] = static_cast<size_t>(std::round(l / h));
+        m_fft[d] = detail::FFT(m_shape[d]);
+        m_ngrid *= m_shape[d];
+    }
+
+    // position of each DOF on the grid: "direction * ngrid + grid point"
+
+    std::vector<size_t> slot(ndof, none);
+    std::vector<size_t> owner(m_ngrid * ndim, none);
+
+    for (size_t m = 0; m < nnode; ++m) {
+        size_t g = 0;
+        size_t stride = 1;
+        for (size_t d = 0; d < ndim; ++d) {
+            g += (static_cast<size_t>(std::round(coor(m, d) / h)) % m_shape[d]) * stride;
+            stride *= m_shape[d];
+        }
+        for (size_t i = 0; i < ndim; ++i) {
+            size_t dof = dofs(m, i);
+            size_t s = i * m_ngrid + g;
+            GOOSEFEM_CHECK(slot[dof] == none || slot[dof] == s);
+            GOOSEFEM_CHECK(owner[s] == none || owner[s] == dof);
+            slot[dof] = s;
+            owner[s] = dof;
+        }
+    }
+
+    m_n = static_cast<Eigen::Index>(iiu.size());
+    m_index.resize(iiu.size());
+
+    std::vector<bool> unknown(m_ngrid * ndim, false);
+
+    for (size_t r = 0; r < iiu.size(); ++r) {
+        GOOSEFEM_ASSERT(iiu(r) < ndof);
+        GOOSEFEM_ASSERT(slot[iiu(r)] != none);
+        m_index[r] = slot[iiu(r)];
+        unknown[m_index[r]] = true;
+    }
+
+    m_fixed.assign(ndim, {});
+
+    for (size_t i = 0; i < ndim; ++i) {
+        for (size_t g = 0; g < m_ngrid; ++g) {
+            if (!unknown[i * m_ngrid + g]) {
+                m_fixed[i].push_back(g);
+            }
+        }
+    }
+
+    // offset (in grid points) of the nodes of the (first) element
+
+    std::vector<std::array<double, 3>> offset(nne);
+
+    for (size_t a = 0; a < nne; ++a) {
+        offset[a] = {0.0, 0.0, 0.0};
+        for (size_t d = 0; d < ndim; ++d) {
+            offset[a][d] = std::round((coor(conn(0, a), d) - coor(conn(0, 0), d)) / h);
+        }
+    }
+
+    // inverse reference stiffness per wave-vector:
+    // "K(q)_ij = sum_ab Ke(a i, b j) exp(i q . (x_b - x_a))" (pseudo-inverse: "K(0) = 0")
+
+    double tol = 1e-12 * static_cast<double>(nne) * xt::amax(xt::abs(Ke))();
+    m_inv.resize(m_ngrid * ndim * ndim);
+
+    #pragma omp parallel for
+    for (size_t g = 0; g < m_ngrid; ++g) {
+        std::array<double, 3> q = {0.0, 0.0, 0.0};
+        size_t rem = g;
+        for (size_t d = 0; d < ndim; ++d) {
+            q[d] = 2.0 * M_PI * static_cast<double>(rem % m_shape[d]) / m_shape[d];
+            rem /= m_shape[d];
+        }
+
+        Eigen::MatrixXcd K = Eigen::MatrixXcd::Zero(ndim, ndim);
+
+        for (size_t a = 0; a < nne; ++a) {
+            for (size_t b = 0; b < nne; ++b) {
+                double phase = 0.0;
+                for (size_t d = 0; d < ndim; ++d) {
+                    phase += q[d] * (offset[b][d] - offset[a][d]);
+                }
+                std::complex<double> e = std::polar(1.0, phase);
+                for (size_t i = 0; i < ndim; ++i) {
+                    for (size_t j = 0; j < ndim; ++j) {
+                        K(i, j) += Ke(a * ndim + i, b * ndim + j) * e;
+                    }
+                }
+            }
+        }
+
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> eig(K);
+        Eigen::VectorXd lambda = eig.eigenvalues();
+
+        for (size_t k = 0; k < ndim; ++k) {
+            lambda(k) = std::abs(lambda(k)) > tol ? 1.0 / lambda(k) : 0.0;
+        }
+
+        Eigen::MatrixXcd inv =
+            eig.eigenvectors() * lambda.asDiagonal() * eig.eigenvectors().adjoint();
+
+        for (size_t i = 0; i < ndim; ++i) {
+            for (size_t j = 0; j < ndim; ++j) {
+                m_inv[(g * ndim + i) * ndim + j] = inv(i, j);
+            }
+        }
+    }
+
+    m_info = Eigen::Success;
+}
+
+template <class Mesh>
+inline void FFTPreconditioner::setReference(
+    const Mesh& mesh, const xt::xtensor<size_t, 2>& dofs, const xt::xtensor<double, 2>& Ke)
+{
+    size_t ndof = xt::amax(dofs)() + 1;
+    this->setReference(mesh, dofs, xt::arange<size_t>(ndof), Ke);
+}
+
+inline Eigen::Index FFTPreconditioner::rows() const
+{
+    return m_n;
+}
+
+inline Eigen::Index FFTPreconditioner::cols() const
+{
+    return m_n;
+}
+
+template <class T>
+inline FFTPreconditioner& FFTPreconditioner::analyzePattern(const T&)
+{
+    return *this;
+}
+
+template <class T>
+inline FFTPreconditioner& FFTPreconditioner::factorize(const T& A)
+{
+    return this->compute(A);
+}
+
+template <class T>
+inline FFTPreconditioner& FFTPreconditioner::compute(const T& A)
+{
+    GOOSEFEM_CHECK(A.rows() == m_n);
+    return *this;
+}
+
+inline void FFTPreconditioner::transform(std::complex<double>* x, bool inverse) const
+{
+    size_t stride = 1;
+
+    for (size_t d = 0; d < m_ndim; ++d) {
+        size_t n = m_shape[d];
+        size_t nline = m_ngrid / n;
+
+        if (n > 1) {
+            #pragma omp parallel
+            {
+                std::vector<std::complex<double>> line(n);
+                std::vector<std::complex<double>> work;
+
+                #pragma omp for
+                for (size_t l = 0; l < nline; ++l) {
+                    size_t begin = (l / stride) * stride * n + l % stride;
+                    for (size_t k = 0; k < n; ++k) {
+                        line[k] = x[begin + k * stride];
+                    }
+                    if (inverse) {
+                        m_fft[d].inverse(line.data(), work);
+                    }
+                    else {
+                        m_fft[d].forward(line.data(), work);
+                    }
+                    for (size_t k = 0; k < n; ++k) {
+                        x[begin + k * stride] = line[k];
+                    }
+                }
+            }
+        }
+
+        stride *= n;
+    }
+}
+
+template <class Rhs>
+inline Eigen::VectorXd FFTPreconditioner::solve(const Eigen::MatrixBase<Rhs>& b) const
+{
+    GOOSEFEM_ASSERT(b.rows() == m_n);
+
+    size_t ndim = m_ndim;
+    std::vector<std::complex<double>> u(m_ngrid * ndim, 0.0);
+    std::array<double, 3> sum = {0.0, 0.0, 0.0};
+
+    for (Eigen::Index r = 0; r < m_n; ++r) {
+        u[m_index[r]] = b(r);
+        sum[m_index[r] / m_ngrid] += b(r);
+    }
+
+    // reaction force at the prescribed DOFs
+
+    for (size_t i = 0; i < ndim; ++i) {
+        for (auto& g : m_fixed[i]) {
+            u[i * m_ngrid + g] = -sum[i] / static_cast<double>(m_fixed[i].size());
+        }
+    }
+
+    for (size_t i = 0; i < ndim; ++i) {
+        this->transform(&u[i * m_ngrid], false);
+    }
+
+    #pragma omp parallel for
+    for (size_t g = 0; g < m_ngrid; ++g) {
+        std::array<std::complex<double>, 3> f;
+        for (size_t i = 0; i < ndim; ++i) {
+            f[i] = u[i * m_ngrid + g];
+        }
+        for (size_t i = 0; i < ndim; ++i) {
+            std::complex<double> v = 0.0;
+            for (size_t j = 0; j < ndim; ++j) {
+                v += m_inv[(g * ndim + i) * ndim + j] * f[j];
+            }
+            u[i * m_ngrid + g] = v;
+        }
+    }
+
+    for (size_t i = 0; i < ndim; ++i) {
+        this->transform(&u[i * m_ngrid], true);
+    }
+
+    // translation such that the (average) displacement of the prescribed DOFs is zero
+
+    std::array<double, 3> shift = {0.0, 0.0, 0.0};
+
+    for (size_t i = 0; i < ndim; ++i) {
+        for (auto& g : m_fixed[i]) {
+            shift[i] += u[i * m_ngrid + g].real() / static_cast<double>(m_fixed[i].size());
+        }
+    }
+
+    Eigen::VectorXd ret(m_n);
+    double scale = 1.0 / static_cast<double>(m_ngrid);
+
+    for (Eigen::Index r = 0; r < m_n; ++r) {
+        ret(r) = (u[m_index[r]].real() - shift[m_index[r] / m_ngrid]) * scale;
+    }
+
+    return ret;
+}
+
+inline Eigen::ComputationInfo FFTPreconditioner::info() const
+{
+    return m_info;
+}
+
+inline std::vector<size_t> FFTPreconditioner::shape() const
+{
+    return m_shape;
+}
+
+} // namespace GooseFEM
+
+#endif
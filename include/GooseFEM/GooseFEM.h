@@ -24,13 +24,22 @@
 #include "MeshHex8.h"
 #include "MeshQuad4.h"
 #include "MeshTri3.h"
+#include "Topology.h"
 #include "Vector.h"
 #include "VectorPartitioned.h"
 
 #ifdef GOOSEFEM_EIGEN
+#include "AMG.h"
+#include "FFTPreconditioner.h"
+#include "IterativeSolver.h"
+#include "LowRankUpdate.h"
 #include "Matrix.h"
 #include "MatrixPartitioned.h"
 #include "MatrixPartitionedTyings.h"
+#include "MixedPrecision.h"
+#include "Multigrid.h"
+#include "SparseSolver.h"
+#include "SupernodalLDLT.h"
 #include "TyingsPeriodic.h"
 #include "VectorPartitionedTyings.h"
 #endif
@@ -0,0 +1,121 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_ITERATIVESOLVER_H
+#define GOOSEFEM_ITERATIVESOLVER_H
+
+#include "config.h"
+
+#include <Eigen/Eigen>
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+namespace GooseFEM {
+
+/*
+  Preconditioner that uses a (direct) factorization of a previous matrix. The factorization is
+  only recomputed on the first "compute", when the size of the matrix changes, or after
+  "refresh()". This allows a modified-Newton style scheme in which the tangent is only
+  factorized occasionally, while the preconditioned CG converges to the current tangent, e.g.:
+
+    GooseFEM::MatrixPartitionedSolver<GooseFEM::PCG<GooseFEM::FactorizationPreconditioner<>>> S;
+    ...
+    S.solve(K, f, x);                         // converges in a few iterations
+    S.solver().preconditioner().refresh();    // factorize on the next solve
+
+  Follows Eigen's preconditioner concept.
+*/
+
+template <class Solver = Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>>
+class FactorizationPreconditioner {
+public:
+    using StorageIndex = typename Eigen::SparseMatrix<double>::StorageIndex;
+    enum { ColsAtCompileTime = Eigen::Dynamic, MaxColsAtCompileTime = Eigen::Dynamic };
+
+    // Constructors
+    FactorizationPreconditioner() = default;
+
+    template <class T>
+    explicit FactorizationPreconditioner(const T& A);
+
+    // Dimensions
+    Eigen::Index rows() const;
+    Eigen::Index cols() const;
+
+    // Preconditioner concept (only "factorize" and "compute" act, see above)
+    template <class T>
+    FactorizationPreconditioner& analyzePattern(const T& A);
+
+    template <class T>
+    FactorizationPreconditioner& factorize(const T& A);
+
+    template <class T>
+    FactorizationPreconditioner& compute(const T& A);
+
+    // Apply the preconditioner: solve using the stored factorization
+    template <class Rhs>
+    Eigen::VectorXd solve(const Eigen::MatrixBase<Rhs>& b) const;
+
+    Eigen::ComputationInfo info() const;
+
+    // Signal to factorize on the next "compute"
+    void refresh();
+
+    // Number of factorizations so far
+    size_t nfactor() const;
+
+    // The underlying solver
+    const Solver& solver() const;
+
+private:
+    Solver m_solver;
+    Eigen::Index m_n = 0;
+    bool m_refresh = true;
+    size_t m_nfactor = 0;
+};
+
+/*
+  Preconditioned conjugate gradient, on the full (symmetric) matrix. The preconditioner is
+  selected by the template argument, in particular:
+
+  -   "Eigen::DiagonalPreconditioner<double>" (default): Jacobi.
+  -   "Eigen::IncompleteCholesky<double>": incomplete Cholesky without fill-in, IC(0).
+  -   "GooseFEM::FactorizationPreconditioner<...>": (direct) factorization of a previous matrix.
+
+  Use "setTolerance" and "setMaxIterations" to change the convergence criterion, and
+  "iterations()" and "error()" to read the statistics of the last solve.
+  "MatrixPartitionedSolver" and "MatrixPartitionedTyingsSolver" use the current value of "x_u"
+  as initial guess (warm start).
+*/
+
+template <class Preconditioner = Eigen::DiagonalPreconditioner<double>>
+using PCG = Eigen::ConjugateGradient<
+    Eigen::SparseMatrix<double>,
+    Eigen::Lower | Eigen::Upper,
+    Preconditioner>;
+
+namespace detail {
+
+    // Solve "A * x = b" using "x0" as initial guess if "Solver" supports it,
+    // or ignore "x0" for direct solvers
+    template <class Solver, class Rhs, class Guess>
+    inline Eigen::Matrix<double, Eigen::Dynamic, Rhs::ColsAtCompileTime>
+    solve_with_guess(Solver& solver, const Rhs& b, const Guess& x0);
+
+    // Solve "A * X = B" for all columns of "B" (with initial guess "X0"): using blocked solves
+    // if "Solver" accepts a matrix as right-hand side, or column-by-column otherwise
+    template <class Solver>
+    inline Eigen::MatrixXd
+    solve_batch(Solver& solver, const Eigen::MatrixXd& B, const Eigen::MatrixXd& X0);
+
+} // namespace detail
+
+} // namespace GooseFEM
+
+#include "IterativeSolver.hpp"
+
+#endif
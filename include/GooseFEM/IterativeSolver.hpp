@@ -0,0 +1,158 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_ITERATIVESOLVER_HPP
+#define GOOSEFEM_ITERATIVESOLVER_HPP
+
+#include "IterativeSolver.h"
+
+namespace GooseFEM {
+
+namespace detail {
+
+    template <class Rhs>
+    using solve_type = Eigen::Matrix<double, Eigen::Dynamic, Rhs::ColsAtCompileTime>;
+
+    template <class Solver, class Rhs, class Guess>
+    inline auto solve_with_guess_impl(Solver& solver, const Rhs& b, const Guess& x0, int)
+        -> decltype(solver.solveWithGuess(b, x0), solve_type<Rhs>())
+    {
+        return solver.solveWithGuess(b, x0);
+    }
+
+    template <class Solver, class Rhs, class Guess>
+    inline solve_type<Rhs> solve_with_guess_impl(Solver& solver, const Rhs& b, const Guess&, long)
+    {
+        return solver.solve(b);
+    }
+
+    template <class Solver, class Rhs, class Guess>
+    inline solve_type<Rhs> solve_with_guess(Solver& solver, const Rhs& b, const Guess& x0)
+    {
+        return solve_with_guess_impl(solver, b, x0, 0);
+    }
+
+    // blocked: "Solver" returns a matrix for a matrix right-hand side
+    template <class Solver>
+    inline auto solve_batch_impl(
+        Solver& solver, const Eigen::MatrixXd& B, const Eigen::MatrixXd& X0, int) ->
+        typename std::enable_if<
+            std::decay<decltype(solver.solve(B))>::type::ColsAtCompileTime != 1,
+            Eigen::MatrixXd>::type
+    {
+        return solve_with_guess(solver, B, X0);
+    }
+
+    // column-by-column: "Solver" only accepts a vector as right-hand side
+    template <class Solver>
+    inline Eigen::MatrixXd
+    solve_batch_impl(Solver& solver, const Eigen::MatrixXd& B, const Eigen::MatrixXd& X0, long)
+    {
+        Eigen::MatrixXd X(B.rows(), B.cols());
+
+        for (Eigen::Index k = 0; k < B.cols(); ++k) {
+            X.col(k) = solve_with_guess(
+                solver, Eigen::VectorXd(B.col(k)), Eigen::VectorXd(X0.col(k)));
+        }
+
+        return X;
+    }
+
+    template <class Solver>
+    inline Eigen::MatrixXd
+    solve_batch(Solver& solver, const Eigen::MatrixXd& B, const Eigen::MatrixXd& X0)
+    {
+        return solve_batch_impl(solver, B, X0, 0);
+    }
+
+} // namespace detail
+
+template <class Solver>
+template <class T>
+inline FactorizationPreconditioner<Solver>::FactorizationPreconditioner(const T& A)
+{
+    this->compute(A);
+}
+
+template <class Solver>
+inline Eigen::Index FactorizationPreconditioner<Solver>::rows() const
+{
+    return m_n;
+}
+
+template <class Solver>
+inline Eigen::Index FactorizationPreconditioner<Solver>::cols() const
+{
+    return m_n;
+}
+
+template <class Solver>
+template <class T>
+inline FactorizationPreconditioner<Solver>& FactorizationPreconditioner<Solver>::analyzePattern(
+    const T&)
+{
+    return *this;
+}
+
+template <class Solver>
+template <class T>
+inline FactorizationPreconditioner<Solver>& FactorizationPreconditioner<Solver>::factorize(
+    const T& A)
+{
+    return this->compute(A);
+}
+
+template <class Solver>
+template <class T>
+inline FactorizationPreconditioner<Solver>& FactorizationPreconditioner<Solver>::compute(
+    const T& A)
+{
+    if (!m_refresh && A.rows() == m_n) {
+        return *this;
+    }
+
+    m_solver.compute(Eigen::SparseMatrix<double>(A));
+    m_n = A.rows();
+    m_refresh = false;
+    m_nfactor++;
+    return *this;
+}
+
+template <class Solver>
+template <class Rhs>
+inline Eigen::VectorXd
+FactorizationPreconditioner<Solver>::solve(const Eigen::MatrixBase<Rhs>& b) const
+{
+    return m_solver.solve(Eigen::VectorXd(b));
+}
+
+template <class Solver>
+inline Eigen::ComputationInfo FactorizationPreconditioner<Solver>::info() const
+{
+    return m_solver.info();
+}
+
+template <class Solver>
+inline void FactorizationPreconditioner<Solver>::refresh()
+{
+    m_refresh = true;
+}
+
+template <class Solver>
+inline size_t FactorizationPreconditioner<Solver>::nfactor() const
+{
+    return m_nfactor;
+}
+
+template <class Solver>
+inline const Solver& FactorizationPreconditioner<Solver>::solver() const
+{
+    return m_solver;
+}
+
+} // namespace GooseFEM
+
+#endif
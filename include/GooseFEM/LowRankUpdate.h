@@ -0,0 +1,108 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_LOWRANKUPDATE_H
+#define GOOSEFEM_LOWRANKUPDATE_H
+
+#include "config.h"
+#include "IterativeSolver.h"
+
+#include <algorithm>
+
+#include <Eigen/Eigen>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+namespace GooseFEM {
+
+/*
+  Direct solver that avoids re-factorizing when only a few elements change their stiffness (e.g.
+  the elements that yield in an avalanche of an elasto-plastic simulation). The change of the
+  matrix with respect to the last factorization, "A = A_0 + D", is applied as a correction
+  (Sherman-Morrison-Woodbury):
+
+    A^{-1} b = y - Z (I + C Z_k)^{-1} C y_k
+
+  with "y = A_0^{-1} b", "Z = A_0^{-1} U", "C" the dense change "D" on the "k" affected DOFs,
+  "U" the corresponding columns of the identity, and "_k" the rows of these DOFs. On "compute"
+  only the columns of "Z" of newly affected DOFs are solved for (using the existing
+  factorization); the cost of a solve is that of "Solver" plus "O(n k)". The matrix is
+  factorized again on the first "compute", when its size changes, after "refresh()", or when
+  the number of DOFs affected since the last factorization exceeds "maxRank()". E.g.:
+
+    GooseFEM::MatrixPartitionedSolver<GooseFEM::LowRankUpdate<>> Solver;
+    Solver.solver().setMaxRank(100);
+    ...
+    K.assemble(Ke);        // a few elements changed
+    Solver.solve(K, f, x); // no factorization
+
+  -   "D" is the difference of the assembled matrices, such that any matrix class (and the
+      usual "assemble") can be used. Entries that do not change are exactly equal, as the
+      assembly is deterministic.
+  -   "Solver" should follow Eigen's sparse solver concept (with a "const" "solve").
+  -   "Z" is dense: it takes "n * maxRank()" doubles (e.g. 256 MB for a million DOFs and
+      "maxRank() = 32"), on top of the factorization. Its columns are kept until the next
+      factorization, also for DOFs that are no longer affected (e.g. an element that changed
+      back), such that these count towards "maxRank()" as well. Choose "maxRank()" according to
+      the available memory.
+*/
+
+template <class Solver = Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>>
+class LowRankUpdate {
+public:
+    // Constructors
+    LowRankUpdate() = default;
+
+    // Settings
+    void setMaxRank(size_t n); // maximum number of affected DOFs (default: 32)
+    size_t maxRank() const;
+
+    // Dimensions
+    Eigen::Index rows() const;
+    Eigen::Index cols() const;
+
+    // Solver concept: factorize, or update the correction (see above)
+    template <class T>
+    LowRankUpdate& compute(const T& A);
+
+    template <class Rhs>
+    Eigen::Matrix<double, Eigen::Dynamic, Rhs::ColsAtCompileTime>
+    solve(const Eigen::MatrixBase<Rhs>& b) const;
+
+    Eigen::ComputationInfo info() const;
+
+    // Signal to factorize on the next "compute"
+    void refresh();
+
+    // Statistics
+    size_t nfactor() const; // number of factorizations so far
+    size_t rank() const;    // number of DOFs affected by the current correction
+
+    // The underlying solver
+    const Solver& solver() const;
+
+private:
+    // Factorize "A", and reset the correction
+    void factorize(Eigen::SparseMatrix<double>&& A);
+
+    Solver m_solver;
+    Eigen::SparseMatrix<double> m_A;       // factorized matrix
+    Eigen::MatrixXd m_Z;                   // "A_0^{-1} U" of each DOF affected so far (cache)
+    std::vector<Eigen::Index> m_col;       // DOF -> column of "m_Z" ("-1" if not cached) [n]
+    std::vector<Eigen::Index> m_dofs;      // affected DOFs [k]
+    Eigen::MatrixXd m_C;                   // change of the matrix on the affected DOFs [k, k]
+    Eigen::FullPivLU<Eigen::MatrixXd> m_S; // factorization of "I + C Z_k"
+    size_t m_maxrank = 32;
+    size_t m_nfactor = 0;
+    bool m_refresh = true;
+    Eigen::ComputationInfo m_info = Eigen::InvalidInput;
+};
+
+} // namespace GooseFEM
+
+#include "LowRankUpdate.hpp"
+
+#endif
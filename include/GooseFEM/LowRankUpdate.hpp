@@ -0,0 +1,219 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_LOWRANKUPDATE_HPP
+#define GOOSEFEM_LOWRANKUPDATE_HPP
+
+#include "LowRankUpdate.h"
+
+namespace GooseFEM {
+
+template <class Solver>
+inline void LowRankUpdate<Solver>::setMaxRank(size_t n)
+{
+    m_maxrank = n;
+}
+
+template <class Solver>
+inline size_t LowRankUpdate<Solver>::maxRank() const
+{
+    return m_maxrank;
+}
+
+template <class Solver>
+inline Eigen::Index LowRankUpdate<Solver>::rows() const
+{
+    return m_A.rows();
+}
+
+template <class Solver>
+inline Eigen::Index LowRankUpdate<Solver>::cols() const
+{
+    return m_A.cols();
+}
+
+template <class Solver>
+inline void LowRankUpdate<Solver>::factorize(Eigen::SparseMatrix<double>&& A)
+{
+    m_solver.compute(A);
+    m_A = std::move(A);
+    m_Z.resize(m_A.rows(), 0);
+    m_col.assign(m_A.rows(), -1);
+    m_dofs.clear();
+    m_C.resize(0, 0);
+    m_info = m_solver.info();
+    m_refresh = false;
+    m_nfactor++;
+}
+
+template <class Solver>
+template <class T>
+inline LowRankUpdate<Solver>& LowRankUpdate<Solver>::compute(const T& A)
+{
+    Eigen::SparseMatrix<double> B(A);
+
+    if (m_refresh || m_info != Eigen::Success || B.rows() != m_A.rows()) {
+        this->factorize(std::move(B));
+        return *this;
+    }
+
+    // change with respect to the factorized matrix: affected DOFs
+
+    Eigen::SparseMatrix<double> D = B - m_A;
+    std::vector<Eigen::Index> local(D.rows(), -1);
+    std::vector<Eigen::Index> dofs;
+    size_t nnew = 0;
+
+    for (Eigen::Index j = 0; j < D.outerSize(); ++j) {
+        for (Eigen::SparseMatrix<double>::InnerIterator it(D, j); it; ++it) {
+            if (it.value() == 0.0) {
+                continue;
+            }
+            for (Eigen::Index i : {it.row(), it.col()}) {
+                if (local[i] < 0) {
+                    local[i] = 0;
+                    dofs.push_back(i);
+                    nnew += m_col[i] < 0 ? 1 : 0;
+                }
+            }
+        }
+    }
+
+    if (static_cast<size_t>(m_Z.cols()) + nnew > m_maxrank) {
+        this->factorize(std::move(B));
+        return *this;
+    }
+
+    // no change with respect to the factorized matrix: no correction
+    if (dofs.empty()) {
+        m_dofs.clear();
+        m_C.resize(0, 0);
+        return *this;
+    }
+
+    std::sort(dofs.begin(), dofs.end());
+
+    Eigen::Index k = static_cast<Eigen::Index>(dofs.size());
+
+    for (Eigen::Index i = 0; i < k; ++i) {
+        local[dofs[i]] = i;
+    }
+
+    // solve for the columns of "Z" of the newly affected DOFs (using the factorization)
+
+    if (nnew > 0) {
+        Eigen::Index ncache = m_Z.cols();
+        Eigen::MatrixXd E = Eigen::MatrixXd::Zero(m_A.rows(), nnew);
+        Eigen::Index c = 0;
+
+        for (auto& i : dofs) {
+            if (m_col[i] < 0) {
+                m_col[i] = ncache + c;
+                E(i, c) = 1.0;
+                ++c;
+            }
+        }
+
+        m_Z.conservativeResize(Eigen::NoChange, ncache + nnew);
+        m_Z.rightCols(nnew) =
+            detail::solve_batch(m_solver, E, Eigen::MatrixXd::Zero(E.rows(), nnew));
+    }
+
+    // dense change on the affected DOFs, and "I + C Z_k"
+
+    m_C = Eigen::MatrixXd::Zero(k, k);
+
+    for (Eigen::Index j = 0; j < D.outerSize(); ++j) {
+        for (Eigen::SparseMatrix<double>::InnerIterator it(D, j); it; ++it) {
+            if (it.value() != 0.0) {
+                m_C(local[it.row()], local[it.col()]) = it.value();
+            }
+        }
+    }
+
+    Eigen::MatrixXd Zk(k, k);
+
+    for (Eigen::Index i = 0; i < k; ++i) {
+        for (Eigen::Index j = 0; j < k; ++j) {
+            Zk(i, j) = m_Z(dofs[i], m_col[dofs[j]]);
+        }
+    }
+
+    m_dofs = std::move(dofs);
+    m_S.compute(Eigen::MatrixXd::Identity(k, k) + m_C * Zk);
+
+    // the correction is (numerically) singular: factorize the current matrix instead
+    if (!m_S.isInvertible()) {
+        this->factorize(std::move(B));
+    }
+
+    return *this;
+}
+
+template <class Solver>
+template <class Rhs>
+inline Eigen::Matrix<double, Eigen::Dynamic, Rhs::ColsAtCompileTime>
+LowRankUpdate<Solver>::solve(const Eigen::MatrixBase<Rhs>& b) const
+{
+    GOOSEFEM_ASSERT(b.rows() == m_A.rows());
+
+    Eigen::Matrix<double, Eigen::Dynamic, Rhs::ColsAtCompileTime> y = m_solver.solve(b);
+
+    if (m_dofs.empty()) {
+        return y;
+    }
+
+    Eigen::Index k = static_cast<Eigen::Index>(m_dofs.size());
+    Eigen::MatrixXd yk(k, y.cols());
+
+    for (Eigen::Index i = 0; i < k; ++i) {
+        yk.row(i) = y.row(m_dofs[i]);
+    }
+
+    Eigen::MatrixXd w = m_S.solve(m_C * yk);
+    Eigen::MatrixXd W = Eigen::MatrixXd::Zero(m_Z.cols(), y.cols());
+
+    for (Eigen::Index i = 0; i < k; ++i) {
+        W.row(m_col[m_dofs[i]]) = w.row(i);
+    }
+
+    y.noalias() -= m_Z * W;
+    return y;
+}
+
+template <class Solver>
+inline Eigen::ComputationInfo LowRankUpdate<Solver>::info() const
+{
+    return m_info;
+}
+
+template <class Solver>
+inline void LowRankUpdate<Solver>::refresh()
+{
+    m_refresh = true;
+}
+
+template <class Solver>
+inline size_t LowRankUpdate<Solver>::nfactor() const
+{
+    return m_nfactor;
+}
+
+template <class Solver>
+inline size_t LowRankUpdate<Solver>::rank() const
+{
+    return m_dofs.size();
+}
+
+template <class Solver>
+inline const Solver& LowRankUpdate<Solver>::solver() const
+{
+    return m_solver;
+}
+
+} // namespace GooseFEM
+
+#endif
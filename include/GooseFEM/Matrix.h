@@ -8,6 +8,7 @@
 #define GOOSEFEM_MATRIX_H
 
 #include "config.h"
+#include "Topology.h"
 
 #include <Eigen/Eigen>
 #include <Eigen/Sparse>
@@ -24,6 +25,9 @@ public:
     Matrix() = default;
     Matrix(const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 2>& dofs);
 
+    // Constructor: share the topology with other objects (no copy)
+    Matrix(std::shared_ptr<const Topology> topology);
+
     // Dimensions
     size_t nelem() const; // number of elements
     size_t nne() const;   // number of nodes per element
@@ -34,6 +38,9 @@ public:
     // DOF lists
     xt::xtensor<size_t, 2> dofs() const; // DOFs
 
+    // Topology (can be shared with other objects)
+    std::shared_ptr<const Topology> topology() const;
+
     // Assemble from matrices stored per element [nelem, nne*ndim, nne*ndim]
     void assemble(const xt::xtensor<double, 3>& elemmat);
 
@@ -72,9 +79,8 @@ private:
     // Signal changes to data
     bool m_changed = true;
 
-    // Bookkeeping
-    xt::xtensor<size_t, 2> m_conn; // connectivity [nelem, nne]
-    xt::xtensor<size_t, 2> m_dofs; // DOF-numbers per node [nnode, ndim]
+    // Bookkeeping: connectivity, DOF-numbers (shared with other objects)
+    std::shared_ptr<const Topology> m_topo;
 
     // Dimensions
     size_t m_nelem; // number of elements
@@ -108,6 +114,19 @@ public:
     xt::xtensor<double, 2> Solve(Matrix& matrix, const xt::xtensor<double, 2>& b);
     xt::xtensor<double, 1> Solve(Matrix& matrix, const xt::xtensor<double, 1>& b);
 
+    // The underlying solver, e.g. to change its settings or to read its statistics.
+    // Accessing it does not trigger a new factorization: settings are used on the next
+    // factorization, which is done if the matrix changed or after "refactorize()".
+    Solver& solver();
+    const Solver& solver() const;
+
+    // Replace the underlying solver (forces a new factorization on the next "solve")
+    void set_solver(Solver solver);
+
+    // Force a new factorization on the next "solve" (e.g. after changing settings of the solver
+    // that apply to the factorization, while the matrix did not change)
+    void refactorize();
+
 private:
     Solver m_solver; // solver
     bool m_factor = true; // signal to force factorization
@@ -12,18 +12,20 @@
 namespace GooseFEM {
 
 inline Matrix::Matrix(const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 2>& dofs)
-    : m_conn(conn), m_dofs(dofs)
+    : Matrix(std::make_shared<const Topology>(conn, dofs))
 {
-    m_nelem = m_conn.shape(0);
-    m_nne = m_conn.shape(1);
-    m_nnode = m_dofs.shape(0);
-    m_ndim = m_dofs.shape(1);
-    m_ndof = xt::amax(m_dofs)() + 1;
+}
+
+inline Matrix::Matrix(std::shared_ptr<const Topology> topology)
+    : m_topo(std::move(topology))
+{
+    m_nelem = m_topo->nelem();
+    m_nne = m_topo->nne();
+    m_nnode = m_topo->nnode();
+    m_ndim = m_topo->ndim();
+    m_ndof = m_topo->ndof();
     m_T.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
     m_A.resize(m_ndof, m_ndof);
-
-    GOOSEFEM_ASSERT(xt::amax(m_conn)() + 1 <= m_nnode);
-    GOOSEFEM_ASSERT(m_ndof <= m_nnode * m_ndim);
 }
 
 inline size_t Matrix::nelem() const
@@ -53,13 +55,20 @@ inline size_t Matrix::ndof() const
 
 inline xt::xtensor<size_t, 2> Matrix::dofs() const
 {
-    return m_dofs;
+    return m_topo->dofs();
+}
+
+inline std::shared_ptr<const Topology> Matrix::topology() const
+{
+    return m_topo;
 }
 
 inline void Matrix::assemble(const xt::xtensor<double, 3>& elemmat)
 {
     GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
 
+    const auto& topo = *m_topo;
+
     m_T.clear();
 
     for (size_t e = 0; e < m_nelem; ++e) {
@@ -68,8 +77,8 @@ inline void Matrix::assemble(const xt::xtensor<double, 3>& elemmat)
                 for (size_t n = 0; n < m_nne; ++n) {
                     for (size_t j = 0; j < m_ndim; ++j) {
                         m_T.push_back(Eigen::Triplet<double>(
-                            m_dofs(m_conn(e, m), i),
-                            m_dofs(m_conn(e, n), j),
+                            topo.elemdofs(e, m, i),
+                            topo.elemdofs(e, n, j),
                             elemmat(e, m * m_ndim + i, n * m_ndim + j)));
                     }
                 }
@@ -182,12 +191,14 @@ inline Eigen::VectorXd Matrix::AsDofs(const xt::xtensor<double, 2>& nodevec) con
 {
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& dofs = m_topo->dofs();
+
     Eigen::VectorXd dofval = Eigen::VectorXd::Zero(m_ndof, 1);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            dofval(m_dofs(m, i)) = nodevec(m, i);
+            dofval(dofs(m, i)) = nodevec(m, i);
         }
     }
 
@@ -199,14 +210,41 @@ inline void Matrix::asNode(const Eigen::VectorXd& dofval, xt::xtensor<double, 2>
     GOOSEFEM_ASSERT(static_cast<size_t>(dofval.size()) == m_ndof);
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& dofs = m_topo->dofs();
+
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            nodevec(m, i) = dofval(m_dofs(m, i));
+            nodevec(m, i) = dofval(dofs(m, i));
         }
     }
 }
 
+template <class Solver>
+inline Solver& MatrixSolver<Solver>::solver()
+{
+    return m_solver;
+}
+
+template <class Solver>
+inline const Solver& MatrixSolver<Solver>::solver() const
+{
+    return m_solver;
+}
+
+template <class Solver>
+inline void MatrixSolver<Solver>::set_solver(Solver solver)
+{
+    m_solver = std::move(solver);
+    m_factor = true;
+}
+
+template <class Solver>
+inline void MatrixSolver<Solver>::refactorize()
+{
+    m_factor = true;
+}
+
 template <class Solver>
 inline void MatrixSolver<Solver>::factorize(Matrix& matrix)
 {
@@ -8,6 +8,7 @@
 #define GOOSEFEM_MATRIXDIAGONAL_H
 
 #include "config.h"
+#include "Topology.h"
 
 namespace GooseFEM {
 
@@ -17,6 +18,9 @@ public:
     MatrixDiagonal() = default;
     MatrixDiagonal(const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 2>& dofs);
 
+    // Constructor: share the topology with other objects (no copy)
+    MatrixDiagonal(std::shared_ptr<const Topology> topology);
+
     // Dimensions
     size_t nelem() const; // number of elements
     size_t nne() const;   // number of nodes per element
@@ -27,6 +31,9 @@ public:
     // DOF lists
     xt::xtensor<size_t, 2> dofs() const; // DOFs
 
+    // Topology (can be shared with other objects)
+    std::shared_ptr<const Topology> topology() const;
+
     // Set matrix components
     void set(const xt::xtensor<double, 1>& A);
 
@@ -61,9 +68,8 @@ private:
     // Signal changes to data compare to the last inverse
     bool m_factor = true;
 
-    // Bookkeeping
-    xt::xtensor<size_t, 2> m_conn; // connectivity [nelem, nne]
-    xt::xtensor<size_t, 2> m_dofs; // DOF-numbers per node [nnode, ndim]
+    // Bookkeeping: connectivity, DOF-numbers (shared with other objects)
+    std::shared_ptr<const Topology> m_topo;
 
     // Dimensions
     size_t m_nelem; // number of elements
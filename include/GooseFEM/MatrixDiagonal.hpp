@@ -13,18 +13,20 @@ namespace GooseFEM {
 
 inline MatrixDiagonal::MatrixDiagonal(
     const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 2>& dofs)
-    : m_conn(conn), m_dofs(dofs)
+    : MatrixDiagonal(std::make_shared<const Topology>(conn, dofs))
 {
-    m_nelem = m_conn.shape(0);
-    m_nne = m_conn.shape(1);
-    m_nnode = m_dofs.shape(0);
-    m_ndim = m_dofs.shape(1);
-    m_ndof = xt::amax(m_dofs)() + 1;
+}
+
+inline MatrixDiagonal::MatrixDiagonal(std::shared_ptr<const Topology> topology)
+    : m_topo(std::move(topology))
+{
+    m_nelem = m_topo->nelem();
+    m_nne = m_topo->nne();
+    m_nnode = m_topo->nnode();
+    m_ndim = m_topo->ndim();
+    m_ndof = m_topo->ndof();
     m_A = xt::empty<double>({m_ndof});
     m_inv = xt::empty<double>({m_ndof});
-
-    GOOSEFEM_ASSERT(xt::amax(m_conn)() + 1 <= m_nnode);
-    GOOSEFEM_ASSERT(m_ndof <= m_nnode * m_ndim);
 }
 
 inline size_t MatrixDiagonal::nelem() const
@@ -54,7 +56,12 @@ inline size_t MatrixDiagonal::ndof() const
 
 inline xt::xtensor<size_t, 2> MatrixDiagonal::dofs() const
 {
-    return m_dofs;
+    return m_topo->dofs();
+}
+
+inline std::shared_ptr<const Topology> MatrixDiagonal::topology() const
+{
+    return m_topo;
 }
 
 inline void MatrixDiagonal::factorize()
@@ -83,12 +90,14 @@ inline void MatrixDiagonal::assemble(const xt::xtensor<double, 3>& elemmat)
     GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
     GOOSEFEM_ASSERT(Element::isDiagonal(elemmat));
 
+    const auto& topo = *m_topo;
+
     m_A.fill(0.0);
 
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                m_A(m_dofs(m_conn(e, m), i)) += elemmat(e, m * m_ndim + i, m * m_ndim + i);
+                m_A(topo.elemdofs(e, m, i)) += elemmat(e, m * m_ndim + i, m * m_ndim + i);
             }
         }
     }
@@ -101,10 +110,12 @@ inline void MatrixDiagonal::dot(const xt::xtensor<double, 2>& x, xt::xtensor<dou
     GOOSEFEM_ASSERT(xt::has_shape(x, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(b, {m_nnode, m_ndim}));
 
+    const auto& dofs = m_topo->dofs();
+
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            b(m, i) = m_A(m_dofs(m, i)) * x(m, i);
+            b(m, i) = m_A(dofs(m, i)) * x(m, i);
         }
     }
 }
@@ -122,12 +133,14 @@ inline void MatrixDiagonal::solve(const xt::xtensor<double, 2>& b, xt::xtensor<d
     GOOSEFEM_ASSERT(xt::has_shape(b, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(x, {m_nnode, m_ndim}));
 
+    const auto& dofs = m_topo->dofs();
+
     this->factorize();
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            x(m, i) = m_inv(m_dofs(m, i)) * b(m, i);
+            x(m, i) = m_inv(dofs(m, i)) * b(m, i);
         }
     }
 }
@@ -8,6 +8,7 @@
 #define GOOSEFEM_MATRIXDIAGONALPARTITIONED_H
 
 #include "config.h"
+#include "Topology.h"
 
 namespace GooseFEM {
 
@@ -21,6 +22,9 @@ public:
         const xt::xtensor<size_t, 2>& dofs,
         const xt::xtensor<size_t, 1>& iip);
 
+    // Constructor: share the topology with other objects (no copy), it must be partitioned
+    MatrixDiagonalPartitioned(std::shared_ptr<const Topology> topology);
+
     // Dimensions
     size_t nelem() const; // number of elements
     size_t nne() const;   // number of nodes per element
@@ -35,6 +39,9 @@ public:
     xt::xtensor<size_t, 1> iiu() const;  // unknown DOFs
     xt::xtensor<size_t, 1> iip() const;  // prescribed DOFs
 
+    // Topology (can be shared with other objects)
+    std::shared_ptr<const Topology> topology() const;
+
     // Assemble from matrices stored per element [nelem, nne*ndim, nne*ndim]
     // WARNING: ignores any off-diagonal terms
     void assemble(const xt::xtensor<double, 3>& elemmat);
@@ -115,12 +122,8 @@ private:
     // Signal changes to data compare to the last inverse
     bool m_factor = true;
 
-    // Bookkeeping
-    xt::xtensor<size_t, 2> m_conn; // connectivity                      [nelem, nne ]
-    xt::xtensor<size_t, 2> m_dofs; // DOF-numbers per node              [nnode, ndim]
-    xt::xtensor<size_t, 2> m_part; // DOF-numbers per node, renumbered  [nnode, ndim]
-    xt::xtensor<size_t, 1> m_iiu;  // DOF-numbers that are unknown      [nnu]
-    xt::xtensor<size_t, 1> m_iip;  // DOF-numbers that are prescribed   [nnp]
+    // Bookkeeping: connectivity, DOF-numbers, and partitioning (shared with other objects)
+    std::shared_ptr<const Topology> m_topo;
 
     // Dimensions
     size_t m_nelem; // number of elements
@@ -8,6 +8,8 @@
 #define GOOSEFEM_MATRIXPARTITIONED_H
 
 #include "config.h"
+#include "IterativeSolver.h"
+#include "Topology.h"
 
 #include <Eigen/Eigen>
 #include <Eigen/Sparse>
@@ -28,6 +30,9 @@ public:
         const xt::xtensor<size_t, 2>& dofs,
         const xt::xtensor<size_t, 1>& iip);
 
+    // Constructor: share the topology with other objects (no copy), it must be partitioned
+    MatrixPartitioned(std::shared_ptr<const Topology> topology);
+
     // Dimensions
     size_t nelem() const; // number of elements
     size_t nne() const;   // number of nodes per element
@@ -42,6 +47,9 @@ public:
     xt::xtensor<size_t, 1> iiu() const;  // unknown DOFs
     xt::xtensor<size_t, 1> iip() const;  // prescribed DOFs
 
+    // Topology (can be shared with other objects)
+    std::shared_ptr<const Topology> topology() const;
+
     // Assemble from matrices stored per element [nelem, nne*ndim, nne*ndim]
     void assemble(const xt::xtensor<double, 3>& elemmat);
 
@@ -107,12 +115,8 @@ private:
     // Signal changes to data compare to the last inverse
     bool m_changed = true;
 
-    // Bookkeeping
-    xt::xtensor<size_t, 2> m_conn; // connectivity                      [nelem, nne ]
-    xt::xtensor<size_t, 2> m_dofs; // DOF-numbers per node              [nnode, ndim]
-    xt::xtensor<size_t, 2> m_part; // DOF-numbers per node, renumbered  [nnode, ndim]
-    xt::xtensor<size_t, 1> m_iiu;  // unknown    DOFs                   [nnu]
-    xt::xtensor<size_t, 1> m_iip;  // prescribed DOFs                   [nnp]
+    // Bookkeeping: connectivity, DOF-numbers, and partitioning (shared with other objects)
+    std::shared_ptr<const Topology> m_topo;
 
     // Dimensions
     size_t m_nelem; // number of elements
@@ -141,6 +145,7 @@ public:
 
     // Solve:
     // x_u = A_uu \ ( b_u - A_up * x_p )
+    // The input "x_u" is used as initial guess by iterative solvers (e.g. "PCG")
     void solve(
         MatrixPartitioned& matrix,
         const xt::xtensor<double, 2>& b,
@@ -172,6 +177,19 @@ public:
         const xt::xtensor<double, 1>& b_u,
         const xt::xtensor<double, 1>& x_p);
 
+    // The underlying solver, e.g. to change its settings or to read its statistics.
+    // Accessing it does not trigger a new factorization: settings are used on the next
+    // factorization, which is done if the matrix changed or after "refactorize()".
+    Solver& solver();
+    const Solver& solver() const;
+
+    // Replace the underlying solver (forces a new factorization on the next "solve")
+    void set_solver(Solver solver);
+
+    // Force a new factorization on the next "solve" (e.g. after changing settings of the solver
+    // that apply to the factorization, while the matrix did not change)
+    void refactorize();
+
 private:
     Solver m_solver; // solver
     bool m_factor = true; // signal to force factorization
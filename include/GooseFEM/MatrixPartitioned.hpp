@@ -16,17 +16,22 @@ inline MatrixPartitioned::MatrixPartitioned(
     const xt::xtensor<size_t, 2>& conn,
     const xt::xtensor<size_t, 2>& dofs,
     const xt::xtensor<size_t, 1>& iip)
-    : m_conn(conn), m_dofs(dofs), m_iip(iip)
-{
-    m_nelem = m_conn.shape(0);
-    m_nne = m_conn.shape(1);
-    m_nnode = m_dofs.shape(0);
-    m_ndim = m_dofs.shape(1);
-    m_iiu = xt::setdiff1d(dofs, iip);
-    m_ndof = xt::amax(m_dofs)() + 1;
-    m_nnp = m_iip.size();
-    m_nnu = m_iiu.size();
-    m_part = Mesh::Reorder({m_iiu, m_iip}).get(m_dofs);
+    : MatrixPartitioned(std::make_shared<const Topology>(conn, dofs, iip))
+{
+}
+
+inline MatrixPartitioned::MatrixPartitioned(std::shared_ptr<const Topology> topology)
+    : m_topo(std::move(topology))
+{
+    GOOSEFEM_CHECK(m_topo->partitioned());
+
+    m_nelem = m_topo->nelem();
+    m_nne = m_topo->nne();
+    m_nnode = m_topo->nnode();
+    m_ndim = m_topo->ndim();
+    m_ndof = m_topo->ndof();
+    m_nnu = m_topo->nnu();
+    m_nnp = m_topo->nnp();
     m_Tuu.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
     m_Tup.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
     m_Tpu.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
@@ -35,10 +40,6 @@ inline MatrixPartitioned::MatrixPartitioned(
     m_Aup.resize(m_nnu, m_nnp);
     m_Apu.resize(m_nnp, m_nnu);
     m_App.resize(m_nnp, m_nnp);
-
-    GOOSEFEM_ASSERT(xt::amax(m_conn)() + 1 <= m_nnode);
-    GOOSEFEM_ASSERT(xt::amax(m_iip)() <= xt::amax(m_dofs)());
-    GOOSEFEM_ASSERT(m_ndof <= m_nnode * m_ndim);
 }
 
 inline size_t MatrixPartitioned::nelem() const
@@ -78,23 +79,30 @@ inline size_t MatrixPartitioned::nnp() const
 
 inline xt::xtensor<size_t, 2> MatrixPartitioned::dofs() const
 {
-    return m_dofs;
+    return m_topo->dofs();
+}
+
+inline std::shared_ptr<const Topology> MatrixPartitioned::topology() const
+{
+    return m_topo;
 }
 
 inline xt::xtensor<size_t, 1> MatrixPartitioned::iiu() const
 {
-    return m_iiu;
+    return m_topo->iiu();
 }
 
 inline xt::xtensor<size_t, 1> MatrixPartitioned::iip() const
 {
-    return m_iip;
+    return m_topo->iip();
 }
 
 inline void MatrixPartitioned::assemble(const xt::xtensor<double, 3>& elemmat)
 {
     GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
 
+    const auto& topo = *m_topo;
+
     m_Tuu.clear();
     m_Tup.clear();
     m_Tpu.clear();
@@ -104,12 +112,12 @@ inline void MatrixPartitioned::assemble(const xt::xtensor<double, 3>& elemmat)
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
 
-                size_t di = m_part(m_conn(e, m), i);
+                size_t di = topo.elempart(e, m, i);
 
                 for (size_t n = 0; n < m_nne; ++n) {
                     for (size_t j = 0; j < m_ndim; ++j) {
 
-                        size_t dj = m_part(m_conn(e, n), j);
+                        size_t dj = topo.elempart(e, n, j);
 
                         if (di < m_nnu && dj < m_nnu) {
                             m_Tuu.push_back(Eigen::Triplet<double>(
@@ -280,6 +288,8 @@ inline void MatrixPartitioned::dot(const xt::xtensor<double, 2>& x, xt::xtensor<
     GOOSEFEM_ASSERT(xt::has_shape(b, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(x, {m_nnode, m_ndim}));
 
+    const auto& part = m_topo->part();
+
     Eigen::VectorXd X_u = this->AsDofs_u(x);
     Eigen::VectorXd X_p = this->AsDofs_p(x);
     Eigen::VectorXd B_u = m_Auu * X_u + m_Aup * X_p;
@@ -288,11 +298,11 @@ inline void MatrixPartitioned::dot(const xt::xtensor<double, 2>& x, xt::xtensor<
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) < m_nnu) {
-                b(m, i) = B_u(m_part(m, i));
+            if (part(m, i) < m_nnu) {
+                b(m, i) = B_u(part(m, i));
             }
             else{
-                b(m, i) = B_p(m_part(m, i) - m_nnu);
+                b(m, i) = B_p(part(m, i) - m_nnu);
             }
         }
     }
@@ -303,11 +313,31 @@ inline void MatrixPartitioned::dot(const xt::xtensor<double, 1>& x, xt::xtensor<
     GOOSEFEM_ASSERT(b.size() == m_ndof);
     GOOSEFEM_ASSERT(x.size() == m_ndof);
 
+    if (m_topo->contiguous()) {
+        Eigen::Map<const Eigen::VectorXd> X_u(x.data(), m_nnu);
+        Eigen::Map<const Eigen::VectorXd> X_p(x.data() + m_nnu, m_nnp);
+        Eigen::Map<Eigen::VectorXd>(b.data(), m_nnu).noalias() = m_Auu * X_u + m_Aup * X_p;
+        Eigen::Map<Eigen::VectorXd>(b.data() + m_nnu, m_nnp).noalias() = m_Apu * X_u + m_App * X_p;
+        return;
+    }
+
+    const auto& iiu = m_topo->iiu();
+    const auto& iip = m_topo->iip();
+
     Eigen::VectorXd X_u = this->AsDofs_u(x);
     Eigen::VectorXd X_p = this->AsDofs_p(x);
+    Eigen::VectorXd B_u = m_Auu * X_u + m_Aup * X_p;
+    Eigen::VectorXd B_p = m_Apu * X_u + m_App * X_p;
+
+    #pragma omp parallel for
+    for (size_t d = 0; d < m_nnu; ++d) {
+        b(iiu(d)) = B_u(d);
+    }
 
-    Eigen::Map<Eigen::VectorXd>(b.data(), m_nnu).noalias() = m_Auu * X_u + m_Aup * X_p;
-    Eigen::Map<Eigen::VectorXd>(b.data() + m_nnu, m_ndof).noalias() = m_Auu * X_u + m_Aup * X_p;
+    #pragma omp parallel for
+    for (size_t d = 0; d < m_nnp; ++d) {
+        b(iip(d)) = B_p(d);
+    }
 }
 
 inline xt::xtensor<double, 2> MatrixPartitioned::Dot(const xt::xtensor<double, 2>& x) const
@@ -330,6 +360,8 @@ MatrixPartitioned::reaction(const xt::xtensor<double, 2>& x, xt::xtensor<double,
     GOOSEFEM_ASSERT(xt::has_shape(x, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(b, {m_nnode, m_ndim}));
 
+    const auto& part = m_topo->part();
+
     Eigen::VectorXd X_u = this->AsDofs_u(x);
     Eigen::VectorXd X_p = this->AsDofs_p(x);
     Eigen::VectorXd B_p = m_Apu * X_u + m_App * X_p;
@@ -337,8 +369,8 @@ MatrixPartitioned::reaction(const xt::xtensor<double, 2>& x, xt::xtensor<double,
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) >= m_nnu) {
-                b(m, i) = B_p(m_part(m, i) - m_nnu);
+            if (part(m, i) >= m_nnu) {
+                b(m, i) = B_p(part(m, i) - m_nnu);
             }
         }
     }
@@ -350,13 +382,22 @@ MatrixPartitioned::reaction(const xt::xtensor<double, 1>& x, xt::xtensor<double,
     GOOSEFEM_ASSERT(x.size() == m_ndof);
     GOOSEFEM_ASSERT(b.size() == m_ndof);
 
+    if (m_topo->contiguous()) {
+        Eigen::Map<const Eigen::VectorXd> X_u(x.data(), m_nnu);
+        Eigen::Map<const Eigen::VectorXd> X_p(x.data() + m_nnu, m_nnp);
+        Eigen::Map<Eigen::VectorXd>(b.data() + m_nnu, m_nnp).noalias() = m_Apu * X_u + m_App * X_p;
+        return;
+    }
+
+    const auto& iip = m_topo->iip();
+
     Eigen::VectorXd X_u = this->AsDofs_u(x);
     Eigen::VectorXd X_p = this->AsDofs_p(x);
     Eigen::VectorXd B_p = m_Apu * X_u + m_App * X_p;
 
     #pragma omp parallel for
     for (size_t d = 0; d < m_nnp; ++d) {
-        b(m_iip(d)) = B_p(d);
+        b(iip(d)) = B_p(d);
     }
 }
 
@@ -402,11 +443,13 @@ inline Eigen::VectorXd MatrixPartitioned::AsDofs_u(const xt::xtensor<double, 1>&
 {
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    const auto& iiu = m_topo->iiu();
+
     Eigen::VectorXd dofval_u(m_nnu, 1);
 
     #pragma omp parallel for
     for (size_t d = 0; d < m_nnu; ++d) {
-        dofval_u(d) = dofval(m_iiu(d));
+        dofval_u(d) = dofval(iiu(d));
     }
 
     return dofval_u;
@@ -416,13 +459,15 @@ inline Eigen::VectorXd MatrixPartitioned::AsDofs_u(const xt::xtensor<double, 2>&
 {
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& part = m_topo->part();
+
     Eigen::VectorXd dofval_u = Eigen::VectorXd::Zero(m_nnu, 1);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) < m_nnu) {
-                dofval_u(m_part(m, i)) = nodevec(m, i);
+            if (part(m, i) < m_nnu) {
+                dofval_u(part(m, i)) = nodevec(m, i);
             }
         }
     }
@@ -434,11 +479,13 @@ inline Eigen::VectorXd MatrixPartitioned::AsDofs_p(const xt::xtensor<double, 1>&
 {
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    const auto& iip = m_topo->iip();
+
     Eigen::VectorXd dofval_p(m_nnp, 1);
 
     #pragma omp parallel for
     for (size_t d = 0; d < m_nnp; ++d) {
-        dofval_p(d) = dofval(m_iip(d));
+        dofval_p(d) = dofval(iip(d));
     }
 
     return dofval_p;
@@ -448,13 +495,15 @@ inline Eigen::VectorXd MatrixPartitioned::AsDofs_p(const xt::xtensor<double, 2>&
 {
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& part = m_topo->part();
+
     Eigen::VectorXd dofval_p = Eigen::VectorXd::Zero(m_nnp, 1);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) >= m_nnu) {
-                dofval_p(m_part(m, i) - m_nnu) = nodevec(m, i);
+            if (part(m, i) >= m_nnu) {
+                dofval_p(part(m, i) - m_nnu) = nodevec(m, i);
             }
         }
     }
@@ -462,6 +511,31 @@ inline Eigen::VectorXd MatrixPartitioned::AsDofs_p(const xt::xtensor<double, 2>&
     return dofval_p;
 }
 
+template <class Solver>
+inline Solver& MatrixPartitionedSolver<Solver>::solver()
+{
+    return m_solver;
+}
+
+template <class Solver>
+inline const Solver& MatrixPartitionedSolver<Solver>::solver() const
+{
+    return m_solver;
+}
+
+template <class Solver>
+inline void MatrixPartitionedSolver<Solver>::set_solver(Solver solver)
+{
+    m_solver = std::move(solver);
+    m_factor = true;
+}
+
+template <class Solver>
+inline void MatrixPartitionedSolver<Solver>::refactorize()
+{
+    m_factor = true;
+}
+
 template <class Solver>
 inline void MatrixPartitionedSolver<Solver>::factorize(MatrixPartitioned& matrix)
 {
@@ -480,16 +554,19 @@ inline void MatrixPartitionedSolver<Solver>::solve(
     GOOSEFEM_ASSERT(xt::has_shape(b, {matrix.m_nnode, matrix.m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(x, {matrix.m_nnode, matrix.m_ndim}));
 
+    const auto& part = matrix.m_topo->part();
+
     this->factorize(matrix);
     Eigen::VectorXd B_u = matrix.AsDofs_u(b);
     Eigen::VectorXd X_p = matrix.AsDofs_p(x);
-    Eigen::VectorXd X_u = m_solver.solve(Eigen::VectorXd(B_u - matrix.m_Aup * X_p));
+    Eigen::VectorXd X_u = detail::solve_with_guess(
+        m_solver, Eigen::VectorXd(B_u - matrix.m_Aup * X_p), matrix.AsDofs_u(x));
 
     #pragma omp parallel for
     for (size_t m = 0; m < matrix.m_nnode; ++m) {
         for (size_t i = 0; i < matrix.m_ndim; ++i) {
-            if (matrix.m_part(m, i) < matrix.m_nnu) {
-                x(m, i) = X_u(matrix.m_part(m, i));
+            if (part(m, i) < matrix.m_nnu) {
+                x(m, i) = X_u(part(m, i));
             }
         }
     }
@@ -503,13 +580,26 @@ inline void MatrixPartitionedSolver<Solver>::solve(
     GOOSEFEM_ASSERT(x.size() == matrix.m_ndof);
 
     this->factorize(matrix);
+
+    if (matrix.m_topo->contiguous()) {
+        Eigen::Map<const Eigen::VectorXd> B_u(b.data(), matrix.m_nnu);
+        Eigen::Map<const Eigen::VectorXd> X_p(x.data() + matrix.m_nnu, matrix.m_nnp);
+        Eigen::Map<const Eigen::VectorXd> X_u(x.data(), matrix.m_nnu);
+        Eigen::Map<Eigen::VectorXd>(x.data(), matrix.m_nnu) =
+            detail::solve_with_guess(m_solver, Eigen::VectorXd(B_u - matrix.m_Aup * X_p), X_u);
+        return;
+    }
+
+    const auto& iiu = matrix.m_topo->iiu();
+
     Eigen::VectorXd B_u = matrix.AsDofs_u(b);
     Eigen::VectorXd X_p = matrix.AsDofs_p(x);
-    Eigen::VectorXd X_u = m_solver.solve(Eigen::VectorXd(B_u - matrix.m_Aup * X_p));
+    Eigen::VectorXd X_u = detail::solve_with_guess(
+        m_solver, Eigen::VectorXd(B_u - matrix.m_Aup * X_p), matrix.AsDofs_u(x));
 
     #pragma omp parallel for
     for (size_t d = 0; d < matrix.m_nnu; ++d) {
-        x(matrix.m_iiu(d)) = X_u(d);
+        x(iiu(d)) = X_u(d);
     }
 }
 
@@ -526,9 +616,14 @@ inline void MatrixPartitionedSolver<Solver>::solve_u(
 
     this->factorize(matrix);
 
-    Eigen::Map<Eigen::VectorXd>(x_u.data(), x_u.size()).noalias() = m_solver.solve(Eigen::VectorXd(
-        Eigen::Map<const Eigen::VectorXd>(b_u.data(), b_u.size()) -
-        matrix.m_Aup * Eigen::Map<const Eigen::VectorXd>(x_p.data(), x_p.size())));
+    Eigen::Map<Eigen::VectorXd> X_u(x_u.data(), x_u.size());
+
+    X_u = detail::solve_with_guess(
+        m_solver,
+        Eigen::VectorXd(
+            Eigen::Map<const Eigen::VectorXd>(b_u.data(), b_u.size()) -
+            matrix.m_Aup * Eigen::Map<const Eigen::VectorXd>(x_p.data(), x_p.size())),
+        X_u);
 }
 
 template <class Solver>
@@ -553,7 +648,7 @@ template <class Solver>
 inline xt::xtensor<double, 1> MatrixPartitionedSolver<Solver>::Solve_u(
     MatrixPartitioned& matrix, const xt::xtensor<double, 1>& b_u, const xt::xtensor<double, 1>& x_p)
 {
-    xt::xtensor<double, 1> x_u = xt::empty<double>({matrix.m_nnu});
+    xt::xtensor<double, 1> x_u = xt::zeros<double>({matrix.m_nnu});
     this->solve_u(matrix, b_u, x_p, x_u);
     return x_u;
 }
@@ -8,6 +8,8 @@
 #define GOOSEFEM_MATRIXPARTITIONEDTYINGS_H
 
 #include "config.h"
+#include "IterativeSolver.h"
+#include "Topology.h"
 
 #include <Eigen/Eigen>
 #include <Eigen/Sparse>
@@ -29,6 +31,12 @@ public:
         const Eigen::SparseMatrix<double>& Cdu,
         const Eigen::SparseMatrix<double>& Cdp);
 
+    // Constructor: share the topology with other objects (no copy)
+    MatrixPartitionedTyings(
+        std::shared_ptr<const Topology> topology,
+        const Eigen::SparseMatrix<double>& Cdu,
+        const Eigen::SparseMatrix<double>& Cdp);
+
     // Dimensions
     size_t nelem() const; // number of elements
     size_t nne() const;   // number of nodes per element
@@ -47,47 +55,31 @@ public:
     xt::xtensor<size_t, 1> iii() const;  // independent DOFs
     xt::xtensor<size_t, 1> iid() const;  // dependent DOFs
 
+    // Topology (can be shared with other objects)
+    std::shared_ptr<const Topology> topology() const;
+
     // Assemble from matrices stored per element [nelem, nne*ndim, nne*ndim]
+    // The tyings are applied while assembling: each entry of an element matrix is added to the
+    // independent DOFs on which its DOFs depend, i.e. "A' = C^T * A * C" (see "solve")
     void assemble(const xt::xtensor<double, 3>& elemmat);
 
 private:
-    // The matrix
-    Eigen::SparseMatrix<double> m_Auu;
-    Eigen::SparseMatrix<double> m_Aup;
-    Eigen::SparseMatrix<double> m_Apu;
-    Eigen::SparseMatrix<double> m_App;
-    Eigen::SparseMatrix<double> m_Aud;
-    Eigen::SparseMatrix<double> m_Apd;
-    Eigen::SparseMatrix<double> m_Adu;
-    Eigen::SparseMatrix<double> m_Adp;
-    Eigen::SparseMatrix<double> m_Add;
-
-    // The matrix for which the tyings have been applied
+    // The matrix for which the tyings have been applied (assembled directly, see "assemble")
     Eigen::SparseMatrix<double> m_ACuu;
     Eigen::SparseMatrix<double> m_ACup;
-    Eigen::SparseMatrix<double> m_ACpu;
-    Eigen::SparseMatrix<double> m_ACpp;
 
     // Matrix entries
     std::vector<Eigen::Triplet<double>> m_Tuu;
     std::vector<Eigen::Triplet<double>> m_Tup;
-    std::vector<Eigen::Triplet<double>> m_Tpu;
-    std::vector<Eigen::Triplet<double>> m_Tpp;
-    std::vector<Eigen::Triplet<double>> m_Tud;
-    std::vector<Eigen::Triplet<double>> m_Tpd;
-    std::vector<Eigen::Triplet<double>> m_Tdu;
-    std::vector<Eigen::Triplet<double>> m_Tdp;
-    std::vector<Eigen::Triplet<double>> m_Tdd;
 
     // Signal changes to data
     bool m_changed = true;
 
     // Bookkeeping
-    xt::xtensor<size_t, 2> m_conn; // connectivity          [nelem, nne ]
-    xt::xtensor<size_t, 2> m_dofs; // DOF-numbers per node  [nnode, ndim]
-    xt::xtensor<size_t, 1> m_iiu;  // unknown     DOFs      [nnu]
-    xt::xtensor<size_t, 1> m_iip;  // prescribed  DOFs      [nnp]
-    xt::xtensor<size_t, 1> m_iid;  // dependent   DOFs      [nnd]
+    std::shared_ptr<const Topology> m_topo; // connectivity and DOF-numbers (shared)
+    xt::xtensor<index_type, 1> m_iiu;  // unknown     DOFs      [nnu]
+    xt::xtensor<index_type, 1> m_iip;  // prescribed  DOFs      [nnp]
+    xt::xtensor<index_type, 1> m_iid;  // dependent   DOFs      [nnd]
 
     // Dimensions
     size_t m_nelem; // number of elements
@@ -104,7 +96,10 @@ private:
     Eigen::SparseMatrix<double> m_Cdu;
     Eigen::SparseMatrix<double> m_Cdp;
     Eigen::SparseMatrix<double> m_Cud;
-    Eigen::SparseMatrix<double> m_Cpd;
+
+    // Independent DOFs (and coefficients) of each DOF [ndof, nni]:
+    // "x = C * x_i", with "C = [I; C_di]" and "C_di = [C_du, C_dp]"
+    Eigen::SparseMatrix<double, Eigen::RowMajor> m_C;
 
     // grant access to solver class
     template <class> friend class MatrixPartitionedTyingsSolver;
@@ -130,6 +125,7 @@ public:
     // x_u = A'_uu \ ( b'_u - A'_up * x_p )
     // x_i = [x_u, x_p]
     // x_d = C_di * x_i
+    // The input "x_u" is used as initial guess by iterative solvers (e.g. "PCG")
     void solve(
         MatrixPartitionedTyings& matrix,
         const xt::xtensor<double, 2>& b,
@@ -147,6 +143,22 @@ public:
         const xt::xtensor<double, 1>& x_p,
         xt::xtensor<double, 1>& x_u);
 
+    // Solve for a batch of right-hand sides (e.g. load cases) using one factorization, with
+    // blocked solves if the solver supports them ("SimplicialLDLT", "SupernodalLDLT", ...):
+    // "b" and "x" [nrhs, nnode, ndim], "b_u" and "x_u" [nrhs, nnu], "b_d" [nrhs, nnd],
+    // "x_p" [nrhs, nnp]
+    void solve(
+        MatrixPartitionedTyings& matrix,
+        const xt::xtensor<double, 3>& b,
+        xt::xtensor<double, 3>& x); // updates x_u and x_d
+
+    void solve_u(
+        MatrixPartitionedTyings& matrix,
+        const xt::xtensor<double, 2>& b_u,
+        const xt::xtensor<double, 2>& b_d,
+        const xt::xtensor<double, 2>& x_p,
+        xt::xtensor<double, 2>& x_u);
+
     // Auto-allocation of the functions above
     xt::xtensor<double, 2> Solve(
         MatrixPartitionedTyings& matrix,
@@ -164,6 +176,30 @@ public:
         const xt::xtensor<double, 1>& b_d,
         const xt::xtensor<double, 1>& x_p);
 
+    xt::xtensor<double, 3> Solve(
+        MatrixPartitionedTyings& matrix,
+        const xt::xtensor<double, 3>& b,
+        const xt::xtensor<double, 3>& x);
+
+    xt::xtensor<double, 2> Solve_u(
+        MatrixPartitionedTyings& matrix,
+        const xt::xtensor<double, 2>& b_u,
+        const xt::xtensor<double, 2>& b_d,
+        const xt::xtensor<double, 2>& x_p);
+
+    // The underlying solver, e.g. to change its settings or to read its statistics.
+    // Accessing it does not trigger a new factorization: settings are used on the next
+    // factorization, which is done if the matrix changed or after "refactorize()".
+    Solver& solver();
+    const Solver& solver() const;
+
+    // Replace the underlying solver (forces a new factorization on the next "solve")
+    void set_solver(Solver solver);
+
+    // Force a new factorization on the next "solve" (e.g. after changing settings of the solver
+    // that apply to the factorization, while the matrix did not change)
+    void refactorize();
+
 private:
     Solver m_solver; // solver
     bool m_factor = true; // signal to force factorization
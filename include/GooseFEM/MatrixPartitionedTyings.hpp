@@ -16,7 +16,15 @@ inline MatrixPartitionedTyings::MatrixPartitionedTyings(
     const xt::xtensor<size_t, 2>& dofs,
     const Eigen::SparseMatrix<double>& Cdu,
     const Eigen::SparseMatrix<double>& Cdp)
-    : m_conn(conn), m_dofs(dofs), m_Cdu(Cdu), m_Cdp(Cdp)
+    : MatrixPartitionedTyings(std::make_shared<const Topology>(conn, dofs), Cdu, Cdp)
+{
+}
+
+inline MatrixPartitionedTyings::MatrixPartitionedTyings(
+    std::shared_ptr<const Topology> topology,
+    const Eigen::SparseMatrix<double>& Cdu,
+    const Eigen::SparseMatrix<double>& Cdp)
+    : m_topo(std::move(topology)), m_Cdu(Cdu), m_Cdp(Cdp)
 {
     GOOSEFEM_ASSERT(Cdu.rows() == Cdp.rows());
 
@@ -28,33 +36,42 @@ inline MatrixPartitionedTyings::MatrixPartitionedTyings(
     m_iiu = xt::arange<size_t>(m_nnu);
     m_iip = xt::arange<size_t>(m_nnu, m_nnu + m_nnp);
     m_iid = xt::arange<size_t>(m_nni, m_nni + m_nnd);
-    m_nelem = m_conn.shape(0);
-    m_nne = m_conn.shape(1);
-    m_nnode = m_dofs.shape(0);
-    m_ndim = m_dofs.shape(1);
+    m_nelem = m_topo->nelem();
+    m_nne = m_topo->nne();
+    m_nnode = m_topo->nnode();
+    m_ndim = m_topo->ndim();
     m_Cud = m_Cdu.transpose();
-    m_Cpd = m_Cdp.transpose();
     m_Tuu.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
     m_Tup.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Tpu.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Tpp.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Tud.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Tpd.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Tdu.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Tdp.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Tdd.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Auu.resize(m_nnu, m_nnu);
-    m_Aup.resize(m_nnu, m_nnp);
-    m_Apu.resize(m_nnp, m_nnu);
-    m_App.resize(m_nnp, m_nnp);
-    m_Aud.resize(m_nnu, m_nnd);
-    m_Apd.resize(m_nnp, m_nnd);
-    m_Adu.resize(m_nnd, m_nnu);
-    m_Adp.resize(m_nnd, m_nnp);
-    m_Add.resize(m_nnd, m_nnd);
+    m_ACuu.resize(m_nnu, m_nnu);
+    m_ACup.resize(m_nnu, m_nnp);
+
+    // "C = [I; C_du, C_dp]"
+
+    std::vector<Eigen::Triplet<double>> T;
+    T.reserve(m_nni + m_Cdu.nonZeros() + m_Cdp.nonZeros());
+
+    for (size_t i = 0; i < m_nni; ++i) {
+        T.push_back(Eigen::Triplet<double>(i, i, 1.0));
+    }
+
+    for (int k = 0; k < m_Cdu.outerSize(); ++k) {
+        for (Eigen::SparseMatrix<double>::InnerIterator it(m_Cdu, k); it; ++it) {
+            T.push_back(Eigen::Triplet<double>(m_nni + it.row(), it.col(), it.value()));
+        }
+    }
+
+    for (int k = 0; k < m_Cdp.outerSize(); ++k) {
+        for (Eigen::SparseMatrix<double>::InnerIterator it(m_Cdp, k); it; ++it) {
+            T.push_back(Eigen::Triplet<double>(m_nni + it.row(), m_nnu + it.col(), it.value()));
+        }
+    }
+
+    m_C.resize(m_ndof, m_nni);
+    m_C.setFromTriplets(T.begin(), T.end());
 
     GOOSEFEM_ASSERT(m_ndof <= m_nnode * m_ndim);
-    GOOSEFEM_ASSERT(m_ndof == xt::amax(m_dofs)() + 1);
+    GOOSEFEM_ASSERT(m_ndof == m_topo->ndof());
 }
 
 inline size_t MatrixPartitionedTyings::nelem() const
@@ -104,7 +121,12 @@ inline size_t MatrixPartitionedTyings::nnd() const
 
 inline xt::xtensor<size_t, 2> MatrixPartitionedTyings::dofs() const
 {
-    return m_dofs;
+    return m_topo->dofs();
+}
+
+inline std::shared_ptr<const Topology> MatrixPartitionedTyings::topology() const
+{
+    return m_topo;
 }
 
 inline xt::xtensor<size_t, 1> MatrixPartitionedTyings::iiu() const
@@ -131,70 +153,36 @@ inline void MatrixPartitionedTyings::assemble(const xt::xtensor<double, 3>& elem
 {
     GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
 
+    using Iterator = Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator;
+
+    const auto& topo = *m_topo;
+    size_t n = m_nne * m_ndim;
+
     m_Tuu.clear();
     m_Tup.clear();
-    m_Tpu.clear();
-    m_Tpp.clear();
-    m_Tud.clear();
-    m_Tpd.clear();
-    m_Tdu.clear();
-    m_Tdp.clear();
-    m_Tdd.clear();
+
+    // "A'_ab = C_ia * A_ij * C_jb", with "C_ia" non-zero only for the independent DOFs "a" of
+    // DOF "i" (one for an independent DOF, a few for a dependent DOF); only rows "a < nnu"
+    // are needed
 
     for (size_t e = 0; e < m_nelem; ++e) {
-        for (size_t m = 0; m < m_nne; ++m) {
-            for (size_t i = 0; i < m_ndim; ++i) {
+        for (size_t r = 0; r < n; ++r) {
+            for (Iterator a(m_C, topo.elemdofs(e, r / m_ndim, r % m_ndim)); a; ++a) {
 
-                size_t di = m_dofs(m_conn(e, m), i);
+                if (static_cast<size_t>(a.col()) >= m_nnu) {
+                    continue;
+                }
 
-                for (size_t n = 0; n < m_nne; ++n) {
-                    for (size_t j = 0; j < m_ndim; ++j) {
+                for (size_t c = 0; c < n; ++c) {
+                    for (Iterator b(m_C, topo.elemdofs(e, c / m_ndim, c % m_ndim)); b; ++b) {
 
-                        size_t dj = m_dofs(m_conn(e, n), j);
+                        double v = a.value() * elemmat(e, r, c) * b.value();
 
-                        if (di < m_nnu && dj < m_nnu) {
-                            m_Tuu.push_back(Eigen::Triplet<double>(
-                                di, dj, elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else if (di < m_nnu && dj < m_nni) {
-                            m_Tup.push_back(Eigen::Triplet<double>(
-                                di, dj - m_nnu, elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else if (di < m_nnu) {
-                            m_Tud.push_back(Eigen::Triplet<double>(
-                                di, dj - m_nni, elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else if (di < m_nni && dj < m_nnu) {
-                            m_Tpu.push_back(Eigen::Triplet<double>(
-                                di - m_nnu, dj, elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else if (di < m_nni && dj < m_nni) {
-                            m_Tpp.push_back(Eigen::Triplet<double>(
-                                di - m_nnu,
-                                dj - m_nnu,
-                                elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else if (di < m_nni) {
-                            m_Tpd.push_back(Eigen::Triplet<double>(
-                                di - m_nnu,
-                                dj - m_nni,
-                                elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else if (dj < m_nnu) {
-                            m_Tdu.push_back(Eigen::Triplet<double>(
-                                di - m_nni, dj, elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else if (dj < m_nni) {
-                            m_Tdp.push_back(Eigen::Triplet<double>(
-                                di - m_nni,
-                                dj - m_nnu,
-                                elemmat(e, m * m_ndim + i, n * m_ndim + j)));
+                        if (static_cast<size_t>(b.col()) < m_nnu) {
+                            m_Tuu.push_back(Eigen::Triplet<double>(a.col(), b.col(), v));
                         }
                         else {
-                            m_Tdd.push_back(Eigen::Triplet<double>(
-                                di - m_nni,
-                                dj - m_nni,
-                                elemmat(e, m * m_ndim + i, n * m_ndim + j)));
+                            m_Tup.push_back(Eigen::Triplet<double>(a.col(), b.col() - m_nnu, v));
                         }
                     }
                 }
@@ -202,15 +190,8 @@ inline void MatrixPartitionedTyings::assemble(const xt::xtensor<double, 3>& elem
         }
     }
 
-    m_Auu.setFromTriplets(m_Tuu.begin(), m_Tuu.end());
-    m_Aup.setFromTriplets(m_Tup.begin(), m_Tup.end());
-    m_Apu.setFromTriplets(m_Tpu.begin(), m_Tpu.end());
-    m_App.setFromTriplets(m_Tpp.begin(), m_Tpp.end());
-    m_Aud.setFromTriplets(m_Tud.begin(), m_Tud.end());
-    m_Apd.setFromTriplets(m_Tpd.begin(), m_Tpd.end());
-    m_Adu.setFromTriplets(m_Tdu.begin(), m_Tdu.end());
-    m_Adp.setFromTriplets(m_Tdp.begin(), m_Tdp.end());
-    m_Add.setFromTriplets(m_Tdd.begin(), m_Tdd.end());
+    m_ACuu.setFromTriplets(m_Tuu.begin(), m_Tuu.end());
+    m_ACup.setFromTriplets(m_Tup.begin(), m_Tup.end());
     m_changed = true;
 }
 
@@ -233,13 +214,15 @@ MatrixPartitionedTyings::AsDofs_u(const xt::xtensor<double, 2>& nodevec) const
 {
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& dofs = m_topo->dofs();
+
     Eigen::VectorXd dofval_u = Eigen::VectorXd::Zero(m_nnu, 1);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_dofs(m, i) < m_nnu) {
-                dofval_u(m_dofs(m, i)) = nodevec(m, i);
+            if (dofs(m, i) < m_nnu) {
+                dofval_u(dofs(m, i)) = nodevec(m, i);
             }
         }
     }
@@ -266,13 +249,15 @@ MatrixPartitionedTyings::AsDofs_p(const xt::xtensor<double, 2>& nodevec) const
 {
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& dofs = m_topo->dofs();
+
     Eigen::VectorXd dofval_p = Eigen::VectorXd::Zero(m_nnp, 1);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_dofs(m, i) >= m_nnu && m_dofs(m, i) < m_nni) {
-                dofval_p(m_dofs(m, i) - m_nnu) = nodevec(m, i);
+            if (dofs(m, i) >= m_nnu && dofs(m, i) < m_nni) {
+                dofval_p(dofs(m, i) - m_nnu) = nodevec(m, i);
             }
         }
     }
@@ -299,13 +284,15 @@ MatrixPartitionedTyings::AsDofs_d(const xt::xtensor<double, 2>& nodevec) const
 {
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& dofs = m_topo->dofs();
+
     Eigen::VectorXd dofval_d = Eigen::VectorXd::Zero(m_nnd, 1);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_dofs(m, i) >= m_nni) {
-                dofval_d(m_dofs(m, i) - m_nni) = nodevec(m, i);
+            if (dofs(m, i) >= m_nni) {
+                dofval_d(dofs(m, i) - m_nni) = nodevec(m, i);
             }
         }
     }
@@ -314,23 +301,36 @@ MatrixPartitionedTyings::AsDofs_d(const xt::xtensor<double, 2>& nodevec) const
 }
 
 template <class Solver>
-inline void MatrixPartitionedTyingsSolver<Solver>::factorize(MatrixPartitionedTyings& matrix)
+inline Solver& MatrixPartitionedTyingsSolver<Solver>::solver()
 {
-    if (!matrix.m_changed && !m_factor) {
-        return;
-    }
+    return m_solver;
+}
 
-    matrix.m_ACuu = matrix.m_Auu + matrix.m_Aud * matrix.m_Cdu + matrix.m_Cud * matrix.m_Adu +
-                    matrix.m_Cud * matrix.m_Add * matrix.m_Cdu;
+template <class Solver>
+inline const Solver& MatrixPartitionedTyingsSolver<Solver>::solver() const
+{
+    return m_solver;
+}
 
-    matrix.m_ACup = matrix.m_Aup + matrix.m_Aud * matrix.m_Cdp + matrix.m_Cud * matrix.m_Adp +
-                    matrix.m_Cud * matrix.m_Add * matrix.m_Cdp;
+template <class Solver>
+inline void MatrixPartitionedTyingsSolver<Solver>::set_solver(Solver solver)
+{
+    m_solver = std::move(solver);
+    m_factor = true;
+}
 
-    // matrix.m_ACpu = matrix.m_Apu + matrix.m_Apd * matrix.m_Cdu + matrix.m_Cpd * matrix.m_Adu
-    //     + matrix.m_Cpd * matrix.m_Add * matrix.m_Cdu;
+template <class Solver>
+inline void MatrixPartitionedTyingsSolver<Solver>::refactorize()
+{
+    m_factor = true;
+}
 
-    // matrix.m_ACpp = matrix.m_App + matrix.m_Apd * matrix.m_Cdp + matrix.m_Cpd * matrix.m_Adp
-    //     + matrix.m_Cpd * matrix.m_Add * matrix.m_Cdp;
+template <class Solver>
+inline void MatrixPartitionedTyingsSolver<Solver>::factorize(MatrixPartitionedTyings& matrix)
+{
+    if (!matrix.m_changed && !m_factor) {
+        return;
+    }
 
     m_solver.compute(matrix.m_ACuu);
     m_factor = false;
@@ -344,6 +344,8 @@ inline void MatrixPartitionedTyingsSolver<Solver>::solve(
     GOOSEFEM_ASSERT(xt::has_shape(b, {matrix.m_nnode, matrix.m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(x, {matrix.m_nnode, matrix.m_ndim}));
 
+    const auto& dofs = matrix.m_topo->dofs();
+
     this->factorize(matrix);
 
     Eigen::VectorXd B_u = matrix.AsDofs_u(b);
@@ -352,17 +354,18 @@ inline void MatrixPartitionedTyingsSolver<Solver>::solve(
 
     B_u += matrix.m_Cud * B_d;
 
-    Eigen::VectorXd X_u = m_solver.solve(Eigen::VectorXd(B_u - matrix.m_ACup * X_p));
+    Eigen::VectorXd X_u = detail::solve_with_guess(
+        m_solver, Eigen::VectorXd(B_u - matrix.m_ACup * X_p), matrix.AsDofs_u(x));
     Eigen::VectorXd X_d = matrix.m_Cdu * X_u + matrix.m_Cdp * X_p;
 
     #pragma omp parallel for
     for (size_t m = 0; m < matrix.m_nnode; ++m) {
         for (size_t i = 0; i < matrix.m_ndim; ++i) {
-            if (matrix.m_dofs(m, i) < matrix.m_nnu) {
-                x(m, i) = X_u(matrix.m_dofs(m, i));
+            if (dofs(m, i) < matrix.m_nnu) {
+                x(m, i) = X_u(dofs(m, i));
             }
-            else if (matrix.m_dofs(m, i) >= matrix.m_nni) {
-                x(m, i) = X_d(matrix.m_dofs(m, i) - matrix.m_nni);
+            else if (dofs(m, i) >= matrix.m_nni) {
+                x(m, i) = X_d(dofs(m, i) - matrix.m_nni);
             }
         }
     }
@@ -381,7 +384,8 @@ inline void MatrixPartitionedTyingsSolver<Solver>::solve(
     Eigen::VectorXd B_d = matrix.AsDofs_d(b);
     Eigen::VectorXd X_p = matrix.AsDofs_p(x);
 
-    Eigen::VectorXd X_u = m_solver.solve(Eigen::VectorXd(B_u - matrix.m_ACup * X_p));
+    Eigen::VectorXd X_u = detail::solve_with_guess(
+        m_solver, Eigen::VectorXd(B_u - matrix.m_ACup * X_p), matrix.AsDofs_u(x));
     Eigen::VectorXd X_d = matrix.m_Cdu * X_u + matrix.m_Cdp * X_p;
 
     #pragma omp parallel for
@@ -411,9 +415,99 @@ inline void MatrixPartitionedTyingsSolver<Solver>::solve_u(
 
     this->factorize(matrix);
 
-    Eigen::Map<Eigen::VectorXd>(x_u.data(), x_u.size()).noalias() = m_solver.solve(Eigen::VectorXd(
-        Eigen::Map<const Eigen::VectorXd>(b_u.data(), b_u.size()) -
-        matrix.m_ACup * Eigen::Map<const Eigen::VectorXd>(x_p.data(), x_p.size())));
+    Eigen::Map<Eigen::VectorXd> X_u(x_u.data(), x_u.size());
+
+    X_u = detail::solve_with_guess(
+        m_solver,
+        Eigen::VectorXd(
+            Eigen::Map<const Eigen::VectorXd>(b_u.data(), b_u.size()) -
+            matrix.m_ACup * Eigen::Map<const Eigen::VectorXd>(x_p.data(), x_p.size())),
+        X_u);
+}
+
+template <class Solver>
+inline void MatrixPartitionedTyingsSolver<Solver>::solve(
+    MatrixPartitionedTyings& matrix, const xt::xtensor<double, 3>& b, xt::xtensor<double, 3>& x)
+{
+    GOOSEFEM_ASSERT(b.shape(1) == matrix.m_nnode && b.shape(2) == matrix.m_ndim);
+    GOOSEFEM_ASSERT(xt::has_shape(x, b.shape()));
+
+    const auto& dofs = matrix.m_topo->dofs();
+    size_t nrhs = b.shape(0);
+
+    this->factorize(matrix);
+
+    Eigen::MatrixXd B_u(matrix.m_nnu, nrhs);
+    Eigen::MatrixXd B_d(matrix.m_nnd, nrhs);
+    Eigen::MatrixXd X_u(matrix.m_nnu, nrhs);
+    Eigen::MatrixXd X_p(matrix.m_nnp, nrhs);
+
+    #pragma omp parallel for
+    for (size_t m = 0; m < matrix.m_nnode; ++m) {
+        for (size_t i = 0; i < matrix.m_ndim; ++i) {
+            size_t d = dofs(m, i);
+            for (size_t k = 0; k < nrhs; ++k) {
+                if (d < matrix.m_nnu) {
+                    B_u(d, k) = b(k, m, i);
+                    X_u(d, k) = x(k, m, i);
+                }
+                else if (d < matrix.m_nni) {
+                    X_p(d - matrix.m_nnu, k) = x(k, m, i);
+                }
+                else {
+                    B_d(d - matrix.m_nni, k) = b(k, m, i);
+                }
+            }
+        }
+    }
+
+    B_u += matrix.m_Cud * B_d;
+    B_u -= matrix.m_ACup * X_p;
+
+    X_u = detail::solve_batch(m_solver, B_u, X_u);
+    Eigen::MatrixXd X_d = matrix.m_Cdu * X_u + matrix.m_Cdp * X_p;
+
+    #pragma omp parallel for
+    for (size_t m = 0; m < matrix.m_nnode; ++m) {
+        for (size_t i = 0; i < matrix.m_ndim; ++i) {
+            size_t d = dofs(m, i);
+            for (size_t k = 0; k < nrhs; ++k) {
+                if (d < matrix.m_nnu) {
+                    x(k, m, i) = X_u(d, k);
+                }
+                else if (d >= matrix.m_nni) {
+                    x(k, m, i) = X_d(d - matrix.m_nni, k);
+                }
+            }
+        }
+    }
+}
+
+template <class Solver>
+inline void MatrixPartitionedTyingsSolver<Solver>::solve_u(
+    MatrixPartitionedTyings& matrix,
+    const xt::xtensor<double, 2>& b_u,
+    const xt::xtensor<double, 2>& b_d,
+    const xt::xtensor<double, 2>& x_p,
+    xt::xtensor<double, 2>& x_u)
+{
+    size_t nrhs = b_u.shape(0);
+    GOOSEFEM_ASSERT(xt::has_shape(b_u, {nrhs, matrix.m_nnu}));
+    GOOSEFEM_ASSERT(xt::has_shape(b_d, {nrhs, matrix.m_nnd}));
+    GOOSEFEM_ASSERT(xt::has_shape(x_p, {nrhs, matrix.m_nnp}));
+    GOOSEFEM_ASSERT(xt::has_shape(x_u, {nrhs, matrix.m_nnu}));
+
+    this->factorize(matrix);
+
+    // row-major [nrhs, n] is column-major [n, nrhs]
+    Eigen::Map<const Eigen::MatrixXd> B_u(b_u.data(), matrix.m_nnu, nrhs);
+    Eigen::Map<const Eigen::MatrixXd> B_d(b_d.data(), matrix.m_nnd, nrhs);
+    Eigen::Map<const Eigen::MatrixXd> X_p(x_p.data(), matrix.m_nnp, nrhs);
+    Eigen::Map<Eigen::MatrixXd> X_u(x_u.data(), matrix.m_nnu, nrhs);
+
+    Eigen::MatrixXd B = B_u + matrix.m_Cud * B_d - matrix.m_ACup * X_p;
+
+    X_u = detail::solve_batch(m_solver, B, X_u);
 }
 
 template <class Solver>
@@ -445,7 +539,30 @@ inline xt::xtensor<double, 1> MatrixPartitionedTyingsSolver<Solver>::Solve_u(
     const xt::xtensor<double, 1>& b_d,
     const xt::xtensor<double, 1>& x_p)
 {
-    xt::xtensor<double, 1> x_u = xt::empty<double>({matrix.m_nnu});
+    xt::xtensor<double, 1> x_u = xt::zeros<double>({matrix.m_nnu});
+    this->solve_u(matrix, b_u, b_d, x_p, x_u);
+    return x_u;
+}
+
+template <class Solver>
+inline xt::xtensor<double, 3> MatrixPartitionedTyingsSolver<Solver>::Solve(
+    MatrixPartitionedTyings& matrix,
+    const xt::xtensor<double, 3>& b,
+    const xt::xtensor<double, 3>& x)
+{
+    xt::xtensor<double, 3> ret = x;
+    this->solve(matrix, b, ret);
+    return ret;
+}
+
+template <class Solver>
+inline xt::xtensor<double, 2> MatrixPartitionedTyingsSolver<Solver>::Solve_u(
+    MatrixPartitionedTyings& matrix,
+    const xt::xtensor<double, 2>& b_u,
+    const xt::xtensor<double, 2>& b_d,
+    const xt::xtensor<double, 2>& x_p)
+{
+    xt::xtensor<double, 2> x_u = xt::zeros<double>({b_u.shape(0), matrix.m_nnu});
     this->solve_u(matrix, b_u, b_d, x_p, x_u);
     return x_u;
 }
@@ -9,6 +9,9 @@
 
 #include "config.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace GooseFEM {
 namespace Mesh {
 
@@ -25,6 +28,34 @@ inline ElementType defaultElementType(
     const xt::xtensor<double, 2>& coor,
     const xt::xtensor<size_t, 2>& conn);
 
+namespace detail {
+
+// Result of a (const) member function of a mesh object, computed on first use and then kept.
+// "get" is thread-safe (the result is computed once), "clear" is not: it invalidates all
+// references returned by "get" and may not be called while the object is used elsewhere.
+
+template <class T>
+class Cached {
+public:
+    Cached() = default;
+    Cached(const Cached& other);
+    Cached& operator=(const Cached& other);
+
+    // return the cached result, compute it using "func()" if needed
+    template <class F>
+    const T& get(F func) const;
+
+    // free the cached result
+    void clear();
+
+private:
+    mutable T m_data;
+    mutable std::atomic<bool> m_computed{false};
+    mutable std::mutex m_mutex;
+};
+
+} // namespace detail
+
 // Stitch two mesh objects, specifying overlapping nodes by hand
 
 class ManualStitch {
@@ -60,6 +91,49 @@ private:
     size_t m_nel_b;
 };
 
+// Spatial index of nodal coordinates (uniform grid, stored as hash-map of non-empty cells),
+// to search (nearly) coinciding nodes without comparing all pairs of nodes
+
+class SpatialHash {
+public:
+    SpatialHash() = default;
+
+    // Index nodes "coor" [nnode, ndim] (ndim <= 3) using a grid with cell-size "h"
+    SpatialHash(const xt::xtensor<double, 2>& coor, double h);
+
+    // Index nodes "coor" [nnode, ndim] (ndim <= 3) using a grid with cell-size "h"
+    // estimated from the average nodal spacing
+    SpatialHash(const xt::xtensor<double, 2>& coor);
+
+    // Add nodes, numbered after the nodes that are already indexed
+    void push_back(const xt::xtensor<double, 2>& coor);
+
+    // Number of indexed nodes
+    size_t size() const;
+
+    // Find indexed nodes coinciding with a node in "coor", whereby each component "j"
+    // of an indexed node "x" must satisfy: |x(j) - coor(i, j)| <= atol + rtol * |coor(i, j)|
+    // (as "xt::isclose(x, coor(i, :), rtol, atol)")
+    // Return: [[nodes_from_coor],
+    //          [indexed_nodes]]   (sorted by node in "coor" and then by indexed node)
+    xt::xtensor<size_t, 2> overlapping(
+        const xt::xtensor<double, 2>& coor, double rtol = 1e-5, double atol = 1e-8) const;
+
+private:
+    using Cell = std::array<int64_t, 3>;
+
+    struct CellHash {
+        size_t operator()(const Cell& cell) const;
+    };
+
+    Cell cell(const double* x) const;
+
+    size_t m_ndim = 0;                    // number of dimensions
+    double m_h = 1.0;                     // cell-size
+    std::vector<double> m_coor;           // indexed nodal coordinates [size * ndim]
+    std::unordered_map<Cell, std::vector<size_t>, CellHash> m_cells; // nodes per (non-empty) cell
+};
+
 // Stitch mesh objects, searching for overlapping nodes
 
 class Stitch {
@@ -91,6 +165,7 @@ private:
     std::vector<size_t> m_el_offset;
     double m_rtol = 1e-5;
     double m_atol = 1e-8;
+    SpatialHash m_index; // spatial index of "m_coor", updated on "push_back"
 };
 
 // Renumber to lowest possible index. For example [0,3,4,2] -> [0,2,3,1]
@@ -144,6 +219,243 @@ private:
     xt::xtensor<size_t, 1> m_renum;
 };
 
+// Permutation of the first axis of arrays, e.g. of element (or nodal) quantities:
+//
+//   new_data = data[index]
+//
+// The permutation is applied in place, to arrays "[size, ...]" of any rank (in row-major storage,
+// of a trivially copyable type), using a scratch buffer that is kept between calls. Several arrays
+// are permuted in one (parallel) pass, e.g.:
+//
+//   perm.apply(elemvar, qpvar_a, qpvar_b);
+//
+// Note that "apply" modifies the scratch buffer: one object cannot be used by several threads.
+
+class Permutation {
+public:
+    // constructors
+    Permutation() = default;
+    Permutation(const xt::xtensor<size_t, 1>& index);
+
+    // size of the permuted axis
+    size_t size() const;
+
+    // the permutation: new_data = data[index]
+    const xt::xtensor<size_t, 1>& index() const;
+
+    // inverse permutation, such that "data == new_data[inverse().index()]"
+    Permutation inverse() const;
+
+    // composition: applying "a.compose(b)" is equivalent to applying "a" and then "b",
+    // i.e. "a.compose(b).index() == a.index()[b.index()]"
+    Permutation compose(const Permutation& other) const;
+
+    // permute data in place, for one or several arrays "[size, ...]"
+    template <class... T>
+    void apply(T&... data);
+
+private:
+    xt::xtensor<size_t, 1> m_index;
+    std::vector<unsigned char> m_buffer; // scratch-space (copy of the input data)
+};
+
+// Elements connected to each node, in compressed (CSR) storage.
+//
+// The elements connected to node "n" are (sorted):
+//
+//   elem()[offsets()(n) : offsets()(n + 1)]
+//
+// with the local node index of "n" in each of these elements in "local()", such that:
+//
+//   conn(elem()(i), local()(i)) == n
+
+class Elem2Node {
+public:
+    // constructors
+    Elem2Node() = default;
+    Elem2Node(const xt::xtensor<size_t, 2>& conn); // "nnode" extracted as "amax(conn) + 1"
+    Elem2Node(const xt::xtensor<size_t, 2>& conn, size_t nnode);
+
+    // dimensions
+    size_t nnode() const; // number of nodes
+    size_t size() const;  // number of (element, node) pairs (== nelem * nne)
+
+    // number of elements connected to node "n"
+    size_t coordination(size_t n) const;
+
+    // CSR storage (references, the data is owned by this object)
+    const xt::xtensor<size_t, 1>& offsets() const; // [nnode + 1]
+    const xt::xtensor<size_t, 1>& elem() const;    // [size]
+    const xt::xtensor<size_t, 1>& local() const;   // [size]
+
+private:
+    size_t m_nnode = 0;
+    xt::xtensor<size_t, 1> m_offsets;
+    xt::xtensor<size_t, 1> m_elem;
+    xt::xtensor<size_t, 1> m_local;
+};
+
+// Criterion for two elements to be neighbours
+
+enum class Adjacency {
+    Node, // share at least one node
+    Edge, // share at least one edge
+    Face }; // share at least one face (3-d only)
+
+// Neighbouring elements of each element (the element dual graph), in compressed (CSR) storage.
+//
+// The neighbours of element "e" are (sorted, excluding "e" itself):
+//
+//   elem()[offsets()(e) : offsets()(e + 1)]
+//
+// Edges/faces are identified by hashing their (sorted) node numbers, such that the graph is
+// constructed without searching.
+
+class Elem2Elem {
+public:
+    // constructors
+    Elem2Elem() = default;
+
+    Elem2Elem(
+        const xt::xtensor<size_t, 2>& conn,
+        ElementType type,
+        Adjacency adjacency);
+
+    Elem2Elem(
+        const xt::xtensor<size_t, 2>& conn,
+        Adjacency adjacency); // element-type based on the shape of "conn" (Quad4 for 4 nodes)
+
+    // dimensions
+    size_t nelem() const; // number of elements
+    size_t size() const;  // number of (element, neighbour) pairs
+
+    // number of neighbours of element "e"
+    size_t degree(size_t e) const;
+
+    // CSR storage (references, the data is owned by this object)
+    const xt::xtensor<size_t, 1>& offsets() const; // [nelem + 1]
+    const xt::xtensor<size_t, 1>& elem() const;    // [size]
+
+private:
+    // Construct the graph: elements are neighbours if they share an "entity" (a node, edge,
+    // or face number) from the list "entities" [nelem, n]
+    void init(const xt::xtensor<size_t, 2>& entities);
+
+    size_t m_nelem = 0;
+    xt::xtensor<size_t, 1> m_offsets;
+    xt::xtensor<size_t, 1> m_elem;
+};
+
+// Element coloring: partitioning of the elements in "colors", such that no two elements of one
+// color share a node. The elements of one color can thus be assembled in parallel without race
+// conditions, e.g.:
+//
+//   for (size_t c = 0; c < coloring.ncolor(); ++c) {
+//       #pragma omp parallel for
+//       for (size_t i = coloring.offsets()(c); i < coloring.offsets()(c + 1); ++i) {
+//           size_t e = coloring.elem()(i);
+//           ...
+//       }
+//   }
+
+class Coloring {
+public:
+    // constructors
+    Coloring() = default;
+
+    // Greedy coloring, whereby each element gets the least used color that is not used by any
+    // of its neighbours (such that the colors are balanced)
+    Coloring(const xt::xtensor<size_t, 2>& conn);
+
+    // Use a given color per element (not checked)
+    Coloring(const xt::xtensor<size_t, 1>& color);
+
+    // dimensions
+    size_t nelem() const;  // number of elements
+    size_t ncolor() const; // number of colors
+
+    // number of elements of color "c"
+    size_t size(size_t c) const;
+
+    // color of each element [nelem]
+    const xt::xtensor<size_t, 1>& color() const;
+
+    // elements sorted by color, in CSR storage: the elements of color "c" are
+    // "elem()[offsets()(c) : offsets()(c + 1)]" (sorted)
+    const xt::xtensor<size_t, 1>& offsets() const; // [ncolor + 1]
+    const xt::xtensor<size_t, 1>& elem() const;    // [nelem]
+
+private:
+    // Sort the elements by color
+    void init();
+
+    size_t m_ncolor = 0;
+    xt::xtensor<size_t, 1> m_color;
+    xt::xtensor<size_t, 1> m_offsets;
+    xt::xtensor<size_t, 1> m_elem;
+};
+
+// Partition the mesh in "npart" subdomains with a (nearly) equal number of elements, using
+// recursive coordinate bisection of the element centers: the elements are recursively split
+// in two (in proportion to the number of parts on either side) along the direction in which
+// the centers have the largest extent.
+
+class Partition {
+public:
+    // constructors
+    Partition() = default;
+
+    Partition(
+        const xt::xtensor<double, 2>& coor,
+        const xt::xtensor<size_t, 2>& conn,
+        size_t npart);
+
+    Partition(
+        const xt::xtensor<double, 2>& coor,
+        const xt::xtensor<size_t, 2>& conn,
+        ElementType type,
+        size_t npart);
+
+    // dimensions
+    size_t nelem() const; // number of elements
+    size_t npart() const; // number of parts
+
+    // number of elements of part "p"
+    size_t size(size_t p) const;
+
+    // part of each element [nelem]
+    const xt::xtensor<size_t, 1>& part() const;
+
+    // elements sorted by part, in CSR storage: the elements of part "p" are
+    // "elem()[offsets()(p) : offsets()(p + 1)]" (sorted)
+    const xt::xtensor<size_t, 1>& offsets() const; // [npart + 1]
+    const xt::xtensor<size_t, 1>& elem() const;    // [nelem]
+
+    // elements of part "p" (sorted)
+    xt::xtensor<size_t, 1> elem(size_t p) const;
+
+    // node numbers of part "p": local-to-global node map (sorted)
+    xt::xtensor<size_t, 1> nodemap(size_t p) const;
+
+    // connectivity of part "p", in local node numbers (see "nodemap(p)"):
+    //   nodemap(p)[conn(p)] == conn[elem(p)]
+    xt::xtensor<size_t, 2> conn(size_t p) const;
+
+    // interface nodes: nodes shared by elements of different parts (sorted, global numbers)
+    const xt::xtensor<size_t, 1>& interface() const;
+
+    // interface nodes of part "p" (sorted, global numbers)
+    xt::xtensor<size_t, 1> interface(size_t p) const;
+
+private:
+    size_t m_npart = 0;
+    xt::xtensor<size_t, 2> m_conn;
+    xt::xtensor<size_t, 1> m_part;
+    xt::xtensor<size_t, 1> m_offsets;
+    xt::xtensor<size_t, 1> m_elem;
+    xt::xtensor<size_t, 1> m_interface;
+};
+
 // list with DOF-numbers in sequential order
 inline xt::xtensor<size_t, 2> dofs(size_t nnode, size_t ndim);
 
@@ -153,11 +465,14 @@ inline xt::xtensor<size_t, 2> renumber(const xt::xtensor<size_t, 2>& dofs);
 // number of elements connected to each node
 inline xt::xtensor<size_t, 1> coordination(const xt::xtensor<size_t, 2>& conn);
 
-// elements connected to each node
+// elements connected to each node (see "GooseFEM::Mesh::Elem2Node" for a compressed storage)
 inline std::vector<std::vector<size_t>> elem2node(
     const xt::xtensor<size_t, 2>& conn,
     bool sorted=true); // ensure the output to be sorted
 
+// greedy element coloring (see "GooseFEM::Mesh::Coloring")
+inline Coloring coloring(const xt::xtensor<size_t, 2>& conn);
+
 // return size of each element edge
 inline xt::xtensor<double, 2> edgesize(
     const xt::xtensor<double, 2>& coor,
@@ -192,7 +507,7 @@ inline xt::xtensor<size_t, 1> elemmap2nodemap(
     const xt::xtensor<size_t, 2>& conn,
     ElementType type);
 
-// Find overlapping nodes
+// Find overlapping nodes (uses "SpatialHash")
 // Return: [[nodes_from_mesh_a],
 //          [nodes_from_mesh_b]]
 inline xt::xtensor<size_t, 2> overlapping(
@@ -45,6 +45,194 @@ namespace detail {
         return ret;
     }
 
+    // Estimate of the average nodal spacing, based on the bounding box and the number of nodes
+    inline double spacing(const xt::xtensor<double, 2>& coor)
+    {
+        size_t nnode = coor.shape(0);
+        size_t ndim = coor.shape(1);
+        double vol = 1.0;
+        size_t n = 0;
+
+        if (nnode < 2) {
+            return 1.0;
+        }
+
+        for (size_t j = 0; j < ndim; ++j) {
+            auto x = xt::view(coor, xt::all(), j);
+            double l = xt::amax(x)() - xt::amin(x)();
+            if (l > 0.0) {
+                vol *= l;
+                ++n;
+            }
+        }
+
+        if (n == 0) {
+            return 1.0;
+        }
+
+        return std::pow(vol / static_cast<double>(nnode), 1.0 / static_cast<double>(n));
+    }
+
+    // Local node numbers of the edges or faces of an element [nfacet, nnode_per_facet]
+    inline xt::xtensor<size_t, 2> facets(ElementType type, Adjacency adjacency)
+    {
+        if (type == ElementType::Quad4 && adjacency == Adjacency::Edge) {
+            return {{0, 1}, {1, 2}, {2, 3}, {3, 0}};
+        }
+
+        if (type == ElementType::Tri3 && adjacency == Adjacency::Edge) {
+            return {{0, 1}, {1, 2}, {2, 0}};
+        }
+
+        if (type == ElementType::Hex8 && adjacency == Adjacency::Edge) {
+            return {{0, 1}, {1, 2}, {2, 3}, {3, 0},
+                    {4, 5}, {5, 6}, {6, 7}, {7, 4},
+                    {0, 4}, {1, 5}, {2, 6}, {3, 7}};
+        }
+
+        if (type == ElementType::Hex8 && adjacency == Adjacency::Face) {
+            return {{0, 1, 2, 3}, {4, 5, 6, 7},
+                    {0, 1, 5, 4}, {1, 2, 6, 5},
+                    {2, 3, 7, 6}, {3, 0, 4, 7}};
+        }
+
+        throw std::runtime_error("Element-type not implemented");
+    }
+
+    // Sorted node numbers of an edge or face (padded with "SIZE_MAX")
+    using Facet = std::array<size_t, 4>;
+
+    struct FacetHash {
+        size_t operator()(const Facet& facet) const
+        {
+            size_t ret = 0;
+            for (auto& i : facet) {
+                ret ^= std::hash<size_t>()(i) + 0x9e3779b9 + (ret << 6) + (ret >> 2);
+            }
+            return ret;
+        }
+    };
+
+    // Recursive coordinate bisection of the points "x" [n, ndim] in "npart" parts: points
+    // "index[begin : end]" are assigned to parts "offset + arange(npart)" (in "part")
+    inline void bisect(
+        const xt::xtensor<double, 2>& x,
+        std::vector<size_t>& index,
+        size_t begin,
+        size_t end,
+        size_t offset,
+        size_t npart,
+        xt::xtensor<size_t, 1>& part)
+    {
+        if (npart == 1) {
+            for (size_t i = begin; i < end; ++i) {
+                part(index[i]) = offset;
+            }
+            return;
+        }
+
+        if (end == begin) {
+            return;
+        }
+
+        // direction with the largest extent
+        size_t ndim = x.shape(1);
+        size_t axis = 0;
+        double extent = -1.0;
+
+        for (size_t j = 0; j < ndim; ++j) {
+            double lo = std::numeric_limits<double>::max();
+            double hi = std::numeric_limits<double>::lowest();
+            for (size_t i = begin; i < end; ++i) {
+                lo = std::min(lo, x(index[i], j));
+                hi = std::max(hi, x(index[i], j));
+            }
+            if (hi - lo > extent) {
+                extent = hi - lo;
+                axis = j;
+            }
+        }
+
+        // split in proportion to the number of parts on either side
+        size_t nleft = npart / 2;
+        size_t n = end - begin;
+        size_t mid = begin + (n * nleft + npart / 2) / npart;
+
+        std::nth_element(
+            index.begin() + begin,
+            index.begin() + mid,
+            index.begin() + end,
+            [&](size_t a, size_t b) {
+                return x(a, axis) < x(b, axis) || (x(a, axis) == x(b, axis) && a < b);
+            });
+
+        bisect(x, index, begin, mid, offset, nleft, part);
+        bisect(x, index, mid, end, offset + nleft, npart - nleft, part);
+    }
+
+    // Raw (row-major) storage of an array of trivially copyable type, and its size in bytes
+    template <class T>
+    inline unsigned char* raw_data(T& data)
+    {
+        static_assert(
+            std::is_trivially_copyable<typename T::value_type>::value,
+            "Only arrays of trivially copyable type can be permuted");
+
+        return reinterpret_cast<unsigned char*>(data.data());
+    }
+
+    template <class T>
+    inline size_t raw_size(const T& data)
+    {
+        return data.size() * sizeof(typename T::value_type);
+    }
+
+    template <class T>
+    inline Cached<T>::Cached(const Cached& other)
+    {
+        std::lock_guard<std::mutex> lock(other.m_mutex);
+        m_data = other.m_data;
+        m_computed.store(other.m_computed.load());
+    }
+
+    template <class T>
+    inline Cached<T>& Cached<T>::operator=(const Cached& other)
+    {
+        if (this != &other) {
+            std::lock(m_mutex, other.m_mutex);
+            std::lock_guard<std::mutex> lock_this(m_mutex, std::adopt_lock);
+            std::lock_guard<std::mutex> lock_other(other.m_mutex, std::adopt_lock);
+            m_data = other.m_data;
+            m_computed.store(other.m_computed.load());
+        }
+
+        return *this;
+    }
+
+    template <class T>
+    template <class F>
+    inline const T& Cached<T>::get(F func) const
+    {
+        // double-checked: only the first call(s) lock
+        if (!m_computed.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_computed.load(std::memory_order_relaxed)) {
+                m_data = func();
+                m_computed.store(true, std::memory_order_release);
+            }
+        }
+
+        return m_data;
+    }
+
+    template <class T>
+    inline void Cached<T>::clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_data = T();
+        m_computed.store(false);
+    }
+
 } // namespace detail
 
 inline ManualStitch::ManualStitch(
@@ -162,6 +350,138 @@ ManualStitch::elemset(const xt::xtensor<size_t, 1>& set, size_t index) const
     return set + m_nel_a;
 }
 
+inline SpatialHash::SpatialHash(const xt::xtensor<double, 2>& coor, double h)
+    : m_ndim(coor.shape(1)), m_h(h)
+{
+    GOOSEFEM_CHECK(m_ndim >= 1 && m_ndim <= 3);
+    GOOSEFEM_CHECK(m_h > 0.0);
+
+    this->push_back(coor);
+}
+
+inline SpatialHash::SpatialHash(const xt::xtensor<double, 2>& coor)
+    : SpatialHash(coor, detail::spacing(coor))
+{
+}
+
+inline size_t SpatialHash::CellHash::operator()(const Cell& cell) const
+{
+    return static_cast<size_t>(
+        (static_cast<uint64_t>(cell[0]) * 73856093ull) ^
+        (static_cast<uint64_t>(cell[1]) * 19349663ull) ^
+        (static_cast<uint64_t>(cell[2]) * 83492791ull));
+}
+
+inline SpatialHash::Cell SpatialHash::cell(const double* x) const
+{
+    Cell ret = {0, 0, 0};
+
+    for (size_t j = 0; j < m_ndim; ++j) {
+        ret[j] = static_cast<int64_t>(std::floor(x[j] / m_h));
+    }
+
+    return ret;
+}
+
+inline void SpatialHash::push_back(const xt::xtensor<double, 2>& coor)
+{
+    GOOSEFEM_ASSERT(coor.shape(1) == m_ndim);
+
+    size_t offset = this->size();
+
+    m_coor.insert(m_coor.end(), coor.cbegin(), coor.cend());
+
+    for (size_t i = 0; i < coor.shape(0); ++i) {
+        m_cells[this->cell(&m_coor[(offset + i) * m_ndim])].push_back(offset + i);
+    }
+}
+
+inline size_t SpatialHash::size() const
+{
+    if (m_ndim == 0) {
+        return 0;
+    }
+
+    return m_coor.size() / m_ndim;
+}
+
+inline xt::xtensor<size_t, 2>
+SpatialHash::overlapping(const xt::xtensor<double, 2>& coor, double rtol, double atol) const
+{
+    GOOSEFEM_ASSERT(coor.shape(1) == m_ndim);
+
+    std::vector<size_t> ret_a;
+    std::vector<size_t> ret_b;
+    std::vector<size_t> found;
+    std::array<double, 3> tol;
+    Cell lo;
+    Cell hi;
+    Cell c;
+
+    for (size_t i = 0; i < coor.shape(0); ++i) {
+
+        const double* x = &coor(i, 0);
+        double ncell = 1.0;
+        lo = {0, 0, 0};
+        hi = {0, 0, 0};
+
+        for (size_t j = 0; j < m_ndim; ++j) {
+            tol[j] = atol + rtol * std::abs(x[j]);
+            lo[j] = static_cast<int64_t>(std::floor((x[j] - tol[j]) / m_h));
+            hi[j] = static_cast<int64_t>(std::floor((x[j] + tol[j]) / m_h));
+            ncell *= static_cast<double>(hi[j] - lo[j] + 1);
+        }
+
+        auto check = [&](size_t n) {
+            const double* y = &m_coor[n * m_ndim];
+            for (size_t j = 0; j < m_ndim; ++j) {
+                if (std::abs(y[j] - x[j]) > tol[j]) {
+                    return;
+                }
+            }
+            found.push_back(n);
+        };
+
+        found.clear();
+
+        // tolerance spans more cells than there are non-empty cells: check all nodes
+        if (ncell > static_cast<double>(m_cells.size())) {
+            for (size_t n = 0; n < this->size(); ++n) {
+                check(n);
+            }
+        }
+        else {
+            for (c[0] = lo[0]; c[0] <= hi[0]; ++c[0]) {
+                for (c[1] = lo[1]; c[1] <= hi[1]; ++c[1]) {
+                    for (c[2] = lo[2]; c[2] <= hi[2]; ++c[2]) {
+                        auto it = m_cells.find(c);
+                        if (it == m_cells.end()) {
+                            continue;
+                        }
+                        for (auto& n : it->second) {
+                            check(n);
+                        }
+                    }
+                }
+            }
+            std::sort(found.begin(), found.end());
+        }
+
+        for (auto& n : found) {
+            ret_a.push_back(i);
+            ret_b.push_back(n);
+        }
+    }
+
+    xt::xtensor<size_t, 2> ret = xt::empty<size_t>({size_t(2), ret_a.size()});
+    for (size_t i = 0; i < ret_a.size(); ++i) {
+        ret(0, i) = ret_a[i];
+        ret(1, i) = ret_b[i];
+    }
+
+    return ret;
+}
+
 inline Stitch::Stitch(double rtol, double atol)
 {
     m_rtol = rtol;
@@ -176,15 +496,18 @@ inline void Stitch::push_back(const xt::xtensor<double, 2>& coor, const xt::xten
         m_map.push_back(xt::eval(xt::arange<size_t>(coor.shape(0))));
         m_nel.push_back(conn.shape(0));
         m_el_offset.push_back(0);
+        m_index = SpatialHash(coor);
         return;
     }
 
-    auto overlap = overlapping(m_coor, coor, m_rtol, m_atol);
+    // search only the new nodes, using the index of the stitched mesh: [[new], [stitched]]
+    auto overlap = m_index.overlapping(coor, m_rtol, m_atol);
     size_t index = m_map.size();
+    size_t nnode = m_coor.shape(0);
 
     ManualStitch stich(
-        m_coor, m_conn, xt::view(overlap, 0, xt::all()),
-        coor, conn, xt::view(overlap, 1, xt::all()),
+        m_coor, m_conn, xt::view(overlap, 1, xt::all()),
+        coor, conn, xt::view(overlap, 0, xt::all()),
         false);
 
     m_coor = stich.coor();
@@ -192,6 +515,9 @@ inline void Stitch::push_back(const xt::xtensor<double, 2>& coor, const xt::xten
     m_map.push_back(stich.nodemap(1));
     m_nel.push_back(conn.shape(0));
     m_el_offset.push_back(m_el_offset[index - 1] + m_nel[index - 1]);
+
+    // add the nodes that were not stitched (appended to the end of "m_coor") to the index
+    m_index.push_back(xt::view(m_coor, xt::range(nnode, m_coor.shape(0)), xt::all()));
 }
 
 inline xt::xtensor<double, 2> Stitch::coor() const
@@ -362,6 +688,571 @@ T Reorder::apply(const T& list) const
     return ret;
 }
 
+inline Permutation::Permutation(const xt::xtensor<size_t, 1>& index) : m_index(index)
+{
+    #ifdef GOOSEFEM_ENABLE_ASSERT
+    xt::xtensor<size_t, 1> sorted = xt::sort(m_index);
+    GOOSEFEM_ASSERT(xt::all(xt::equal(sorted, xt::arange<size_t>(m_index.size()))));
+    #endif
+}
+
+inline size_t Permutation::size() const
+{
+    return m_index.size();
+}
+
+inline const xt::xtensor<size_t, 1>& Permutation::index() const
+{
+    return m_index;
+}
+
+inline Permutation Permutation::inverse() const
+{
+    xt::xtensor<size_t, 1> ret = xt::empty<size_t>({m_index.size()});
+
+    for (size_t i = 0; i < m_index.size(); ++i) {
+        ret(m_index(i)) = i;
+    }
+
+    return Permutation(ret);
+}
+
+inline Permutation Permutation::compose(const Permutation& other) const
+{
+    GOOSEFEM_ASSERT(other.size() == this->size());
+
+    xt::xtensor<size_t, 1> ret = xt::empty<size_t>({m_index.size()});
+
+    for (size_t i = 0; i < m_index.size(); ++i) {
+        ret(i) = m_index(other.m_index(i));
+    }
+
+    return Permutation(ret);
+}
+
+// the data is copied to the scratch buffer (one region per array, aligned such that the regions
+// may hold any type), from which the rows are gathered back: ret(i, ...) = copy(index(i), ...)
+
+template <class... T>
+void Permutation::apply(T&... data)
+{
+    constexpr size_t nfield = sizeof...(T);
+    constexpr size_t align = alignof(std::max_align_t);
+    size_t n = m_index.size();
+
+    std::array<size_t, nfield> rows = {static_cast<size_t>(data.shape(0))...};
+    std::array<size_t, nfield> bytes = {detail::raw_size(data)...};
+    std::array<unsigned char*, nfield> ptr = {detail::raw_data(data)...};
+    std::array<size_t, nfield> offset;
+    size_t nbytes = 0;
+
+    for (size_t f = 0; f < nfield; ++f) {
+        GOOSEFEM_ASSERT(rows[f] == n);
+        offset[f] = nbytes;
+        nbytes += ((bytes[f] + align - 1) / align) * align;
+    }
+
+    UNUSED(rows);
+
+    if (n == 0) {
+        return;
+    }
+
+    if (m_buffer.size() < nbytes) {
+        m_buffer.resize(nbytes);
+    }
+
+    std::array<size_t, nfield> stride;
+
+    for (size_t f = 0; f < nfield; ++f) {
+        stride[f] = bytes[f] / n;
+        std::memcpy(m_buffer.data() + offset[f], ptr[f], bytes[f]);
+    }
+
+    const unsigned char* buffer = m_buffer.data();
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t f = 0; f < nfield; ++f) {
+            std::memcpy(
+                ptr[f] + i * stride[f], buffer + offset[f] + m_index(i) * stride[f], stride[f]);
+        }
+    }
+}
+
+inline Elem2Node::Elem2Node(const xt::xtensor<size_t, 2>& conn)
+    : Elem2Node(conn, xt::amax(conn)() + 1)
+{
+}
+
+inline Elem2Node::Elem2Node(const xt::xtensor<size_t, 2>& conn, size_t nnode) : m_nnode(nnode)
+{
+    GOOSEFEM_ASSERT(conn.size() == 0 || xt::amax(conn)() < m_nnode);
+
+    size_t nelem = conn.shape(0);
+    size_t nne = conn.shape(1);
+
+    // count the number of elements per node
+    std::vector<size_t> count(m_nnode, 0);
+
+    #pragma omp parallel for
+    for (size_t e = 0; e < nelem; ++e) {
+        for (size_t m = 0; m < nne; ++m) {
+            #pragma omp atomic
+            count[conn(e, m)]++;
+        }
+    }
+
+    // offsets (cumulative sum of the counts)
+    m_offsets = xt::empty<size_t>({m_nnode + 1});
+    m_offsets(0) = 0;
+
+    for (size_t n = 0; n < m_nnode; ++n) {
+        m_offsets(n + 1) = m_offsets(n) + count[n];
+        count[n] = m_offsets(n);
+    }
+
+    // scatter "e * nne + m" to the rows of the nodes, "count" is used as insertion cursor
+    // (the order within a row depends on the scheduling, it is fixed by sorting below)
+    xt::xtensor<size_t, 1> key = xt::empty<size_t>({nelem * nne});
+
+    #pragma omp parallel for
+    for (size_t e = 0; e < nelem; ++e) {
+        for (size_t m = 0; m < nne; ++m) {
+            size_t i;
+            #pragma omp atomic capture
+            i = count[conn(e, m)]++;
+            key(i) = e * nne + m;
+        }
+    }
+
+    // sort each row and decode the element and local node index
+    m_elem = xt::empty<size_t>({nelem * nne});
+    m_local = xt::empty<size_t>({nelem * nne});
+
+    #pragma omp parallel for
+    for (size_t n = 0; n < m_nnode; ++n) {
+        std::sort(key.data() + m_offsets(n), key.data() + m_offsets(n + 1));
+        for (size_t i = m_offsets(n); i < m_offsets(n + 1); ++i) {
+            m_elem(i) = key(i) / nne;
+            m_local(i) = key(i) % nne;
+        }
+    }
+}
+
+inline size_t Elem2Node::nnode() const
+{
+    return m_nnode;
+}
+
+inline size_t Elem2Node::size() const
+{
+    return m_elem.size();
+}
+
+inline size_t Elem2Node::coordination(size_t n) const
+{
+    GOOSEFEM_ASSERT(n < m_nnode);
+    return m_offsets(n + 1) - m_offsets(n);
+}
+
+inline const xt::xtensor<size_t, 1>& Elem2Node::offsets() const
+{
+    return m_offsets;
+}
+
+inline const xt::xtensor<size_t, 1>& Elem2Node::elem() const
+{
+    return m_elem;
+}
+
+inline const xt::xtensor<size_t, 1>& Elem2Node::local() const
+{
+    return m_local;
+}
+
+inline Elem2Elem::Elem2Elem(
+    const xt::xtensor<size_t, 2>& conn, ElementType type, Adjacency adjacency)
+{
+    if (adjacency == Adjacency::Node) {
+        this->init(conn);
+        return;
+    }
+
+    auto local = detail::facets(type, adjacency);
+    size_t nelem = conn.shape(0);
+    size_t nfacet = local.shape(0);
+    size_t n = local.shape(1);
+
+    GOOSEFEM_ASSERT(xt::amax(local)() < conn.shape(1));
+
+    // number the edges/faces, such that "facets(e, f)" is the number of facet "f" of element "e"
+    std::unordered_map<detail::Facet, size_t, detail::FacetHash> index;
+    index.reserve(nelem * nfacet);
+    xt::xtensor<size_t, 2> facets = xt::empty<size_t>({nelem, nfacet});
+
+    for (size_t e = 0; e < nelem; ++e) {
+        for (size_t f = 0; f < nfacet; ++f) {
+            detail::Facet facet;
+            facet.fill(std::numeric_limits<size_t>::max());
+            for (size_t j = 0; j < n; ++j) {
+                facet[j] = conn(e, local(f, j));
+            }
+            std::sort(facet.begin(), facet.begin() + n);
+            size_t i = index.size();
+            facets(e, f) = index.emplace(facet, i).first->second;
+        }
+    }
+
+    this->init(facets);
+}
+
+inline Elem2Elem::Elem2Elem(const xt::xtensor<size_t, 2>& conn, Adjacency adjacency)
+{
+    if (conn.shape(1) == 3) {
+        *this = Elem2Elem(conn, ElementType::Tri3, adjacency);
+    }
+    else if (conn.shape(1) == 4) {
+        *this = Elem2Elem(conn, ElementType::Quad4, adjacency);
+    }
+    else if (conn.shape(1) == 8) {
+        *this = Elem2Elem(conn, ElementType::Hex8, adjacency);
+    }
+    else {
+        throw std::runtime_error("Element-type not implemented");
+    }
+}
+
+inline void Elem2Elem::init(const xt::xtensor<size_t, 2>& entities)
+{
+    m_nelem = entities.shape(0);
+    m_offsets = xt::zeros<size_t>({m_nelem + 1});
+
+    if (m_nelem == 0) {
+        m_elem = xt::empty<size_t>({size_t(0)});
+        return;
+    }
+
+    // elements connected to each entity
+    Elem2Node toentity(entities);
+    auto& offsets = toentity.offsets();
+    auto& elem = toentity.elem();
+
+    // list all elements sharing an entity with element "e" (sorted, unique, excluding "e")
+    auto neighbours = [&](size_t e, std::vector<size_t>& ret) {
+        ret.clear();
+        for (size_t k = 0; k < entities.shape(1); ++k) {
+            size_t entity = entities(e, k);
+            for (size_t i = offsets(entity); i < offsets(entity + 1); ++i) {
+                if (elem(i) != e) {
+                    ret.push_back(elem(i));
+                }
+            }
+        }
+        std::sort(ret.begin(), ret.end());
+        ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
+    };
+
+    // count the number of neighbours (rows are recomputed below, to avoid storing them)
+    #pragma omp parallel
+    {
+        std::vector<size_t> row;
+
+        #pragma omp for
+        for (size_t e = 0; e < m_nelem; ++e) {
+            neighbours(e, row);
+            m_offsets(e + 1) = row.size();
+        }
+    }
+
+    for (size_t e = 0; e < m_nelem; ++e) {
+        m_offsets(e + 1) += m_offsets(e);
+    }
+
+    m_elem = xt::empty<size_t>({m_offsets(m_nelem)});
+
+    #pragma omp parallel
+    {
+        std::vector<size_t> row;
+
+        #pragma omp for
+        for (size_t e = 0; e < m_nelem; ++e) {
+            neighbours(e, row);
+            std::copy(row.begin(), row.end(), m_elem.data() + m_offsets(e));
+        }
+    }
+}
+
+inline size_t Elem2Elem::nelem() const
+{
+    return m_nelem;
+}
+
+inline size_t Elem2Elem::size() const
+{
+    return m_elem.size();
+}
+
+inline size_t Elem2Elem::degree(size_t e) const
+{
+    GOOSEFEM_ASSERT(e < m_nelem);
+    return m_offsets(e + 1) - m_offsets(e);
+}
+
+inline const xt::xtensor<size_t, 1>& Elem2Elem::offsets() const
+{
+    return m_offsets;
+}
+
+inline const xt::xtensor<size_t, 1>& Elem2Elem::elem() const
+{
+    return m_elem;
+}
+
+inline Coloring::Coloring(const xt::xtensor<size_t, 2>& conn)
+{
+    size_t nelem = conn.shape(0);
+    Elem2Elem graph(conn, Adjacency::Node);
+    auto& offsets = graph.offsets();
+    auto& elem = graph.elem();
+
+    m_color = xt::empty<size_t>({nelem});
+
+    std::vector<size_t> count; // number of elements per color
+    std::vector<size_t> mark;  // "mark[c] == e + 1" if color "c" is used by a neighbour of "e"
+
+    for (size_t e = 0; e < nelem; ++e) {
+
+        for (size_t i = offsets(e); i < offsets(e + 1); ++i) {
+            if (elem(i) < e) {
+                mark[m_color(elem(i))] = e + 1;
+            }
+        }
+
+        size_t c = count.size();
+
+        for (size_t k = 0; k < count.size(); ++k) {
+            if (mark[k] != e + 1 && (c == count.size() || count[k] < count[c])) {
+                c = k;
+            }
+        }
+
+        if (c == count.size()) {
+            count.push_back(0);
+            mark.push_back(0);
+        }
+
+        m_color(e) = c;
+        count[c]++;
+    }
+
+    this->init();
+}
+
+inline Coloring::Coloring(const xt::xtensor<size_t, 1>& color) : m_color(color)
+{
+    this->init();
+}
+
+inline void Coloring::init()
+{
+    size_t nelem = m_color.size();
+    m_ncolor = nelem > 0 ? xt::amax(m_color)() + 1 : 0;
+
+    m_offsets = xt::zeros<size_t>({m_ncolor + 1});
+    m_elem = xt::empty<size_t>({nelem});
+
+    for (size_t e = 0; e < nelem; ++e) {
+        m_offsets(m_color(e) + 1)++;
+    }
+
+    for (size_t c = 0; c < m_ncolor; ++c) {
+        m_offsets(c + 1) += m_offsets(c);
+    }
+
+    std::vector<size_t> cursor(m_offsets.cbegin(), m_offsets.cend() - 1);
+
+    for (size_t e = 0; e < nelem; ++e) {
+        m_elem(cursor[m_color(e)]++) = e;
+    }
+}
+
+inline size_t Coloring::nelem() const
+{
+    return m_color.size();
+}
+
+inline size_t Coloring::ncolor() const
+{
+    return m_ncolor;
+}
+
+inline size_t Coloring::size(size_t c) const
+{
+    GOOSEFEM_ASSERT(c < m_ncolor);
+    return m_offsets(c + 1) - m_offsets(c);
+}
+
+inline const xt::xtensor<size_t, 1>& Coloring::color() const
+{
+    return m_color;
+}
+
+inline const xt::xtensor<size_t, 1>& Coloring::offsets() const
+{
+    return m_offsets;
+}
+
+inline const xt::xtensor<size_t, 1>& Coloring::elem() const
+{
+    return m_elem;
+}
+
+inline Partition::Partition(
+    const xt::xtensor<double, 2>& coor, const xt::xtensor<size_t, 2>& conn, size_t npart)
+    : Partition(coor, conn, defaultElementType(coor, conn), npart)
+{
+}
+
+inline Partition::Partition(
+    const xt::xtensor<double, 2>& coor,
+    const xt::xtensor<size_t, 2>& conn,
+    ElementType type,
+    size_t npart)
+    : m_npart(npart), m_conn(conn)
+{
+    GOOSEFEM_CHECK(npart > 0);
+
+    size_t nelem = conn.shape(0);
+    size_t nnode = coor.shape(0);
+
+    // recursive coordinate bisection
+    auto x = centers(coor, conn, type);
+    std::vector<size_t> index(nelem);
+    std::iota(index.begin(), index.end(), 0);
+    m_part = xt::empty<size_t>({nelem});
+    detail::bisect(x, index, 0, nelem, 0, m_npart, m_part);
+
+    // sort the elements by part
+    m_offsets = xt::zeros<size_t>({m_npart + 1});
+    m_elem = xt::empty<size_t>({nelem});
+
+    for (size_t e = 0; e < nelem; ++e) {
+        m_offsets(m_part(e) + 1)++;
+    }
+
+    for (size_t p = 0; p < m_npart; ++p) {
+        m_offsets(p + 1) += m_offsets(p);
+    }
+
+    std::vector<size_t> cursor(m_offsets.cbegin(), m_offsets.cend() - 1);
+
+    for (size_t e = 0; e < nelem; ++e) {
+        m_elem(cursor[m_part(e)]++) = e;
+    }
+
+    // interface nodes: nodes connected to elements of more than one part
+    Elem2Node tonode(conn, nnode);
+    auto& offsets = tonode.offsets();
+    auto& elem = tonode.elem();
+    xt::xtensor<bool, 1> shared = xt::zeros<bool>({nnode});
+
+    #pragma omp parallel for
+    for (size_t n = 0; n < nnode; ++n) {
+        for (size_t i = offsets(n); i < offsets(n + 1); ++i) {
+            if (m_part(elem(i)) != m_part(elem(offsets(n)))) {
+                shared(n) = true;
+                break;
+            }
+        }
+    }
+
+    m_interface = xt::flatten_indices(xt::argwhere(shared));
+}
+
+inline size_t Partition::nelem() const
+{
+    return m_part.size();
+}
+
+inline size_t Partition::npart() const
+{
+    return m_npart;
+}
+
+inline size_t Partition::size(size_t p) const
+{
+    GOOSEFEM_ASSERT(p < m_npart);
+    return m_offsets(p + 1) - m_offsets(p);
+}
+
+inline const xt::xtensor<size_t, 1>& Partition::part() const
+{
+    return m_part;
+}
+
+inline const xt::xtensor<size_t, 1>& Partition::offsets() const
+{
+    return m_offsets;
+}
+
+inline const xt::xtensor<size_t, 1>& Partition::elem() const
+{
+    return m_elem;
+}
+
+inline xt::xtensor<size_t, 1> Partition::elem(size_t p) const
+{
+    GOOSEFEM_ASSERT(p < m_npart);
+    return xt::view(m_elem, xt::range(m_offsets(p), m_offsets(p + 1)));
+}
+
+inline xt::xtensor<size_t, 1> Partition::nodemap(size_t p) const
+{
+    return xt::unique(xt::view(m_conn, xt::keep(this->elem(p)), xt::all()));
+}
+
+inline xt::xtensor<size_t, 2> Partition::conn(size_t p) const
+{
+    auto elem = this->elem(p);
+    auto nodemap = this->nodemap(p);
+
+    std::unordered_map<size_t, size_t> local;
+    local.reserve(nodemap.size());
+
+    for (size_t i = 0; i < nodemap.size(); ++i) {
+        local[nodemap(i)] = i;
+    }
+
+    xt::xtensor<size_t, 2> ret = xt::empty<size_t>({elem.size(), m_conn.shape(1)});
+
+    for (size_t i = 0; i < elem.size(); ++i) {
+        for (size_t m = 0; m < m_conn.shape(1); ++m) {
+            ret(i, m) = local[m_conn(elem(i), m)];
+        }
+    }
+
+    return ret;
+}
+
+inline const xt::xtensor<size_t, 1>& Partition::interface() const
+{
+    return m_interface;
+}
+
+inline xt::xtensor<size_t, 1> Partition::interface(size_t p) const
+{
+    auto nodemap = this->nodemap(p);
+    std::vector<size_t> ret;
+
+    std::set_intersection(
+        nodemap.cbegin(), nodemap.cend(),
+        m_interface.cbegin(), m_interface.cend(),
+        std::back_inserter(ret));
+
+    return xt::adapt(ret);
+}
+
 inline xt::xtensor<size_t, 2> renumber(const xt::xtensor<size_t, 2>& dofs)
 {
     return Renumber(dofs).get(dofs);
@@ -385,26 +1276,24 @@ inline xt::xtensor<size_t, 1> coordination(const xt::xtensor<size_t, 2>& conn)
     return N;
 }
 
+inline Coloring coloring(const xt::xtensor<size_t, 2>& conn)
+{
+    return Coloring(conn);
+}
+
 inline std::vector<std::vector<size_t>> elem2node(const xt::xtensor<size_t, 2>& conn, bool sorted)
 {
-    auto N = coordination(conn);
-    auto nnode = N.size();
+    // "Elem2Node" is sorted by construction
+    UNUSED(sorted);
 
-    std::vector<std::vector<size_t>> ret(nnode);
-    for (size_t i = 0; i < nnode; ++i) {
-        ret[i].reserve(N(i));
-    }
+    Elem2Node tonode(conn);
+    auto& offsets = tonode.offsets();
+    auto& elem = tonode.elem();
 
-    for (size_t e = 0; e < conn.shape(0); ++e) {
-        for (size_t m = 0; m < conn.shape(1); ++m) {
-            ret[conn(e, m)].push_back(e);
-        }
-    }
+    std::vector<std::vector<size_t>> ret(tonode.nnode());
 
-    if (sorted) {
-        for (auto& row : ret) {
-            std::sort(row.begin(), row.end());
-        }
+    for (size_t n = 0; n < tonode.nnode(); ++n) {
+        ret[n].assign(elem.cbegin() + offsets(n), elem.cbegin() + offsets(n + 1));
     }
 
     return ret;
@@ -523,27 +1412,7 @@ inline xt::xtensor<size_t, 2> overlapping(
 {
     GOOSEFEM_ASSERT(coor_a.shape(1) == coor_b.shape(1));
 
-    std::vector<size_t> ret_a;
-    std::vector<size_t> ret_b;
-
-    for (size_t i = 0; i < coor_a.shape(0); ++i) {
-
-        auto idx = xt::flatten_indices(xt::argwhere(xt::prod(xt::isclose(
-            coor_b, xt::view(coor_a, i, xt::all()), rtol, atol), 1)));
-
-        for (auto& j : idx) {
-            ret_a.push_back(i);
-            ret_b.push_back(j);
-        }
-    }
-
-    xt::xtensor<size_t, 2> ret = xt::empty<size_t>({size_t(2), ret_a.size()});
-    for (size_t i = 0; i < ret_a.size(); ++i) {
-        ret(0, i) = ret_a[i];
-        ret(1, i) = ret_b[i];
-    }
-
-    return ret;
+    return SpatialHash(coor_b).overlapping(coor_a, rtol, atol);
 }
 
 } // namespace Mesh
@@ -15,6 +15,7 @@ namespace Hex8 {
 
 class Regular {
 public:
+    Regular() = default;
     Regular(size_t nelx, size_t nely, size_t nelz, double h = 1.);
 
     // size
@@ -22,13 +23,32 @@ public:
     size_t nnode() const; // number of nodes
     size_t nne() const;   // number of nodes-per-element
     size_t ndim() const;  // number of dimensions
+    size_t nelx() const;  // number of elements in x-direction
+    size_t nely() const;  // number of elements in y-direction
+    size_t nelz() const;  // number of elements in z-direction
+    double h() const;     // edge size
 
     // type
     ElementType getElementType() const;
 
-    // mesh
-    xt::xtensor<double, 2> coor() const; // nodal positions [nnode, ndim]
-    xt::xtensor<size_t, 2> conn() const; // connectivity [nelem, nne]
+    // free the cached "coor", "conn", "dofs", "dofsPeriodic", and "nodesPeriodic"
+    // (they are computed on first use, thread-safe, and kept to be returned by reference)
+    // note: this invalidates all references returned by these functions before
+    void clear_cache();
+
+    // mesh (cached: the references are valid until "clear_cache()")
+    const xt::xtensor<double, 2>& coor() const; // nodal positions [nnode, ndim]
+    const xt::xtensor<size_t, 2>& conn() const; // connectivity [nelem, nne]
+
+    // mesh, in blocks: "coor()[begin:end, :]" and "conn()[begin:end, :]"
+    xt::xtensor<double, 2> coor(size_t begin, size_t end) const;
+    xt::xtensor<size_t, 2> conn(size_t begin, size_t end) const;
+
+    // mesh, per item (computed on the fly, nothing is stored)
+    size_t node(size_t ix, size_t iy, size_t iz) const;    // node at grid-point (ix, iy, iz)
+    size_t element(size_t ix, size_t iy, size_t iz) const; // element at grid-cell (ix, iy, iz)
+    std::array<double, 3> coor(size_t n) const;            // position of node "n"
+    std::array<size_t, 8> element_nodes(size_t e) const;  // nodes of element "e"
 
     // boundary nodes: planes
     xt::xtensor<size_t, 1> nodesFront() const;
@@ -154,18 +174,22 @@ public:
     size_t nodesRightBackTopCorner() const;
     size_t nodesRightTopBackCorner() const;
 
-    // DOF-numbers for each component of each node (sequential)
-    xt::xtensor<size_t, 2> dofs() const;
+    // DOF-numbers for each component of each node (sequential, cached: see "clear_cache()")
+    const xt::xtensor<size_t, 2>& dofs() const;
 
-    // DOF-numbers for the case that the periodicity if fully eliminated
-    xt::xtensor<size_t, 2> dofsPeriodic() const;
+    // DOF-numbers for the case that the periodicity if fully eliminated (cached)
+    const xt::xtensor<size_t, 2>& dofsPeriodic() const;
 
-    // periodic node pairs [:,2]: (independent, dependent)
-    xt::xtensor<size_t, 2> nodesPeriodic() const;
+    // periodic node pairs [:,2]: (independent, dependent) (cached)
+    const xt::xtensor<size_t, 2>& nodesPeriodic() const;
 
     // front-bottom-left node, used as reference for periodicity
     size_t nodesOrigin() const;
 
+    // element coloring: 8 colors based on the parity of the element's position in x-, y-,
+    // and z-direction, without searching (see "GooseFEM::Mesh::Coloring")
+    Coloring coloring() const;
+
 private:
     double m_h;                     // elementary element edge-size (in all directions)
     size_t m_nelx;                  // number of elements in x-direction (length == "m_nelx * m_h")
@@ -175,6 +199,13 @@ private:
     size_t m_nnode;                 // number of nodes
     static const size_t m_nne = 8;  // number of nodes-per-element
     static const size_t m_ndim = 3; // number of dimensions
+
+    // cached output (computed on first use)
+    detail::Cached<xt::xtensor<double, 2>> m_coor;
+    detail::Cached<xt::xtensor<size_t, 2>> m_conn;
+    detail::Cached<xt::xtensor<size_t, 2>> m_dofs;
+    detail::Cached<xt::xtensor<size_t, 2>> m_dofsPeriodic;
+    detail::Cached<xt::xtensor<size_t, 2>> m_nodesPeriodic;
 };
 
 class FineLayer {
@@ -193,9 +224,19 @@ public:
     // type
     ElementType getElementType() const;
 
-    // mesh
-    xt::xtensor<double, 2> coor() const; // nodal positions [nnode, ndim]
-    xt::xtensor<size_t, 2> conn() const; // connectivity [nelem, nne]
+    // free the cached "coor", "conn", "dofs", "dofsPeriodic", and "nodesPeriodic"
+    // (they are computed on first use, thread-safe, and kept to be returned by reference)
+    // note: this invalidates all references returned by these functions before
+    void clear_cache();
+
+    // mesh (cached: the references are valid until "clear_cache()")
+    const xt::xtensor<double, 2>& coor() const; // nodal positions [nnode, ndim]
+    const xt::xtensor<size_t, 2>& conn() const; // connectivity [nelem, nne]
+
+    // mesh, in blocks: "coor()[begin:end, :]" and "conn()[begin:end, :]"
+    // (computed per layer of elements, only for the layers that overlap with the block)
+    xt::xtensor<double, 2> coor(size_t begin, size_t end) const;
+    xt::xtensor<size_t, 2> conn(size_t begin, size_t end) const;
 
     // element sets
     xt::xtensor<size_t, 1> elementsMiddleLayer() const; // elements in the middle (fine) layer
@@ -324,14 +365,14 @@ public:
     size_t nodesRightBackTopCorner() const;
     size_t nodesRightTopBackCorner() const;
 
-    // DOF-numbers for each component of each node (sequential)
-    xt::xtensor<size_t, 2> dofs() const;
+    // DOF-numbers for each component of each node (sequential, cached: see "clear_cache()")
+    const xt::xtensor<size_t, 2>& dofs() const;
 
-    // DOF-numbers for the case that the periodicity if fully eliminated
-    xt::xtensor<size_t, 2> dofsPeriodic() const;
+    // DOF-numbers for the case that the periodicity if fully eliminated (cached)
+    const xt::xtensor<size_t, 2>& dofsPeriodic() const;
 
-    // periodic node pairs [:,2]: (independent, dependent)
-    xt::xtensor<size_t, 2> nodesPeriodic() const;
+    // periodic node pairs [:,2]: (independent, dependent) (cached)
+    const xt::xtensor<size_t, 2>& nodesPeriodic() const;
 
     // front-bottom-left node, used as reference for periodicity
     size_t nodesOrigin() const;
@@ -355,8 +396,72 @@ private:
     xt::xtensor<size_t, 1> m_startNode; // start node (**)
     // (*) per element layer in "y"
     // (**) per node layer in "y"
+
+    // write the nodes of node layer "iy" (the main node layer and the intermediate nodes of the
+    // element layer "iy" above it) to "ret", with row "i" corresponding to node "offset + i"
+    void coor_layer(size_t iy, size_t offset, xt::xtensor<double, 2>& ret) const;
+
+    // write the elements of element layer "iy" to "ret", with row "i" corresponding to element
+    // "offset + i"
+    void conn_layer(size_t iy, size_t offset, xt::xtensor<size_t, 2>& ret) const;
+
+    // cached output (computed on first use)
+    detail::Cached<xt::xtensor<double, 2>> m_coor;
+    detail::Cached<xt::xtensor<size_t, 2>> m_conn;
+    detail::Cached<xt::xtensor<size_t, 2>> m_dofs;
+    detail::Cached<xt::xtensor<size_t, 2>> m_dofsPeriodic;
+    detail::Cached<xt::xtensor<size_t, 2>> m_nodesPeriodic;
 };
 
+// mesh mapping
+
+namespace Map {
+
+    class RefineRegular {
+    public:
+        // Constructors
+        RefineRegular() = default;
+        RefineRegular(const GooseFEM::Mesh::Hex8::Regular& mesh, size_t nx, size_t ny, size_t nz);
+
+        // return the coarse or the fine mesh objects
+        GooseFEM::Mesh::Hex8::Regular getCoarseMesh() const;
+        GooseFEM::Mesh::Hex8::Regular getFineMesh() const;
+
+        // elements of the fine mesh per element of the coarse mesh
+        xt::xtensor<size_t, 2> getMap() const;
+
+        // map field
+        xt::xtensor<double, 2> mapToCoarse(const xt::xtensor<double, 1>& data) const; // scalar per el
+        xt::xtensor<double, 2> mapToCoarse(const xt::xtensor<double, 2>& data) const; // scalar per intpnt
+        xt::xtensor<double, 4> mapToCoarse(const xt::xtensor<double, 4>& data) const; // tensor per intpnt
+
+        // map field
+        xt::xtensor<double, 1> mapToFine(const xt::xtensor<double, 1>& data) const; // scalar per el
+        xt::xtensor<double, 2> mapToFine(const xt::xtensor<double, 2>& data) const; // scalar per intpnt
+        xt::xtensor<double, 4> mapToFine(const xt::xtensor<double, 4>& data) const; // tensor per intpnt
+
+    private:
+        // gather the rows "data[coarse2fine[i, :], ...]" of each coarse element "i" (in parallel)
+        template <class T, class R>
+        void map_to_coarse(const T& data, R& ret) const;
+
+        // gather the rows "data[fine2coarse[j], ...]" of each fine element "j" (in parallel)
+        template <class T>
+        void map_to_fine(const T& data, T& ret) const;
+
+    private:
+        // the meshes
+        GooseFEM::Mesh::Hex8::Regular m_coarse;
+        GooseFEM::Mesh::Hex8::Regular m_fine;
+
+        // mapping: the fine elements per coarse element, and its transpose (the coarse element
+        // of each fine element)
+        xt::xtensor<size_t, 2> m_coarse2fine;
+        xt::xtensor<size_t, 1> m_fine2coarse;
+    };
+
+} // namespace Map
+
 } // namespace Hex8
 } // namespace Mesh
 } // namespace GooseFEM
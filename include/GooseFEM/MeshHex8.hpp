@@ -44,62 +44,145 @@ inline size_t Regular::ndim() const
     return m_ndim;
 }
 
+inline size_t Regular::nelx() const
+{
+    return m_nelx;
+}
+
+inline size_t Regular::nely() const
+{
+    return m_nely;
+}
+
+inline size_t Regular::nelz() const
+{
+    return m_nelz;
+}
+
+inline double Regular::h() const
+{
+    return m_h;
+}
+
 inline ElementType Regular::getElementType() const
 {
     return ElementType::Hex8;
 }
 
-inline xt::xtensor<double, 2> Regular::coor() const
+inline void Regular::clear_cache()
 {
-    xt::xtensor<double, 2> ret = xt::empty<double>({m_nnode, m_ndim});
+    m_coor.clear();
+    m_conn.clear();
+    m_dofs.clear();
+    m_dofsPeriodic.clear();
+    m_nodesPeriodic.clear();
+}
 
-    xt::xtensor<double, 1> x =
-        xt::linspace<double>(0.0, m_h * static_cast<double>(m_nelx), m_nelx + 1);
-    xt::xtensor<double, 1> y =
-        xt::linspace<double>(0.0, m_h * static_cast<double>(m_nely), m_nely + 1);
-    xt::xtensor<double, 1> z =
-        xt::linspace<double>(0.0, m_h * static_cast<double>(m_nelz), m_nelz + 1);
+inline const xt::xtensor<double, 2>& Regular::coor() const
+{
+    // computed node-by-node, such that it is identical to "coor(n)" and "coor(begin, end)"
+    return m_coor.get([this]() { return this->coor(0, m_nnode); });
+}
 
-    size_t inode = 0;
+inline const xt::xtensor<size_t, 2>& Regular::conn() const
+{
+    return m_conn.get([this]() {
+        xt::xtensor<size_t, 2> ret = xt::empty<size_t>({m_nelem, m_nne});
 
-    for (size_t iz = 0; iz < m_nelz + 1; ++iz) {
-        for (size_t iy = 0; iy < m_nely + 1; ++iy) {
-            for (size_t ix = 0; ix < m_nelx + 1; ++ix) {
-                ret(inode, 0) = x(ix);
-                ret(inode, 1) = y(iy);
-                ret(inode, 2) = z(iz);
-                ++inode;
+        size_t ielem = 0;
+
+        for (size_t iz = 0; iz < m_nelz; ++iz) {
+            for (size_t iy = 0; iy < m_nely; ++iy) {
+                for (size_t ix = 0; ix < m_nelx; ++ix) {
+                    ret(ielem, 0) = iy * (m_nelx + 1) + ix + iz * (m_nely + 1) * (m_nelx + 1);
+                    ret(ielem, 1) = iy * (m_nelx + 1) + (ix + 1) + iz * (m_nely + 1) * (m_nelx + 1);
+                    ret(ielem, 3) = (iy + 1) * (m_nelx + 1) + ix + iz * (m_nely + 1) * (m_nelx + 1);
+                    ret(ielem, 2) =
+                        (iy + 1) * (m_nelx + 1) + (ix + 1) + iz * (m_nely + 1) * (m_nelx + 1);
+                    ret(ielem, 4) = iy * (m_nelx + 1) + ix + (iz + 1) * (m_nely + 1) * (m_nelx + 1);
+                    ret(ielem, 5) =
+                        (iy) * (m_nelx + 1) + (ix + 1) + (iz + 1) * (m_nely + 1) * (m_nelx + 1);
+                    ret(ielem, 7) =
+                        (iy + 1) * (m_nelx + 1) + ix + (iz + 1) * (m_nely + 1) * (m_nelx + 1);
+                    ret(ielem, 6) =
+                        (iy + 1) * (m_nelx + 1) + (ix + 1) + (iz + 1) * (m_nely + 1) * (m_nelx + 1);
+                    ++ielem;
+                }
             }
         }
+
+        return ret;
+    });
+}
+
+inline size_t Regular::node(size_t ix, size_t iy, size_t iz) const
+{
+    GOOSEFEM_ASSERT(ix <= m_nelx);
+    GOOSEFEM_ASSERT(iy <= m_nely);
+    GOOSEFEM_ASSERT(iz <= m_nelz);
+    return iz * (m_nely + 1) * (m_nelx + 1) + iy * (m_nelx + 1) + ix;
+}
+
+inline size_t Regular::element(size_t ix, size_t iy, size_t iz) const
+{
+    GOOSEFEM_ASSERT(ix < m_nelx);
+    GOOSEFEM_ASSERT(iy < m_nely);
+    GOOSEFEM_ASSERT(iz < m_nelz);
+    return iz * m_nely * m_nelx + iy * m_nelx + ix;
+}
+
+inline std::array<double, 3> Regular::coor(size_t n) const
+{
+    GOOSEFEM_ASSERT(n < m_nnode);
+    size_t ix = n % (m_nelx + 1);
+    size_t iy = (n / (m_nelx + 1)) % (m_nely + 1);
+    size_t iz = n / ((m_nelx + 1) * (m_nely + 1));
+    return {m_h * static_cast<double>(ix),
+            m_h * static_cast<double>(iy),
+            m_h * static_cast<double>(iz)};
+}
+
+inline std::array<size_t, 8> Regular::element_nodes(size_t e) const
+{
+    GOOSEFEM_ASSERT(e < m_nelem);
+    size_t ix = e % m_nelx;
+    size_t iy = (e / m_nelx) % m_nely;
+    size_t iz = e / (m_nelx * m_nely);
+    return {node(ix, iy, iz),
+            node(ix + 1, iy, iz),
+            node(ix + 1, iy + 1, iz),
+            node(ix, iy + 1, iz),
+            node(ix, iy, iz + 1),
+            node(ix + 1, iy, iz + 1),
+            node(ix + 1, iy + 1, iz + 1),
+            node(ix, iy + 1, iz + 1)};
+}
+
+inline xt::xtensor<double, 2> Regular::coor(size_t begin, size_t end) const
+{
+    GOOSEFEM_ASSERT(begin <= end && end <= m_nnode);
+
+    xt::xtensor<double, 2> ret = xt::empty<double>({end - begin, m_ndim});
+
+    #pragma omp parallel for
+    for (size_t n = begin; n < end; ++n) {
+        auto x = this->coor(n);
+        std::copy(x.begin(), x.end(), &ret(n - begin, 0));
     }
 
     return ret;
 }
 
-inline xt::xtensor<size_t, 2> Regular::conn() const
+inline xt::xtensor<size_t, 2> Regular::conn(size_t begin, size_t end) const
 {
-    xt::xtensor<size_t, 2> ret = xt::empty<size_t>({m_nelem, m_nne});
+    GOOSEFEM_ASSERT(begin <= end && end <= m_nelem);
 
-    size_t ielem = 0;
+    xt::xtensor<size_t, 2> ret = xt::empty<size_t>({end - begin, m_nne});
 
-    for (size_t iz = 0; iz < m_nelz; ++iz) {
-        for (size_t iy = 0; iy < m_nely; ++iy) {
-            for (size_t ix = 0; ix < m_nelx; ++ix) {
-                ret(ielem, 0) = iy * (m_nelx + 1) + ix + iz * (m_nely + 1) * (m_nelx + 1);
-                ret(ielem, 1) = iy * (m_nelx + 1) + (ix + 1) + iz * (m_nely + 1) * (m_nelx + 1);
-                ret(ielem, 3) = (iy + 1) * (m_nelx + 1) + ix + iz * (m_nely + 1) * (m_nelx + 1);
-                ret(ielem, 2) =
-                    (iy + 1) * (m_nelx + 1) + (ix + 1) + iz * (m_nely + 1) * (m_nelx + 1);
-                ret(ielem, 4) = iy * (m_nelx + 1) + ix + (iz + 1) * (m_nely + 1) * (m_nelx + 1);
-                ret(ielem, 5) =
-                    (iy) * (m_nelx + 1) + (ix + 1) + (iz + 1) * (m_nely + 1) * (m_nelx + 1);
-                ret(ielem, 7) =
-                    (iy + 1) * (m_nelx + 1) + ix + (iz + 1) * (m_nely + 1) * (m_nelx + 1);
-                ret(ielem, 6) =
-                    (iy + 1) * (m_nelx + 1) + (ix + 1) + (iz + 1) * (m_nely + 1) * (m_nelx + 1);
-                ++ielem;
-            }
-        }
+    #pragma omp parallel for
+    for (size_t e = begin; e < end; ++e) {
+        auto nodes = this->element_nodes(e);
+        std::copy(nodes.begin(), nodes.end(), &ret(e - begin, 0));
     }
 
     return ret;
@@ -831,120 +914,122 @@ inline size_t Regular::nodesRightTopBackCorner() const
     return nodesBackTopRightCorner();
 }
 
-inline xt::xtensor<size_t, 2> Regular::nodesPeriodic() const
-{
-    xt::xtensor<size_t, 1> fro = nodesFrontFace();
-    xt::xtensor<size_t, 1> bck = nodesBackFace();
-    xt::xtensor<size_t, 1> lft = nodesLeftFace();
-    xt::xtensor<size_t, 1> rgt = nodesRightFace();
-    xt::xtensor<size_t, 1> bot = nodesBottomFace();
-    xt::xtensor<size_t, 1> top = nodesTopFace();
-
-    xt::xtensor<size_t, 1> froBot = nodesFrontBottomOpenEdge();
-    xt::xtensor<size_t, 1> froTop = nodesFrontTopOpenEdge();
-    xt::xtensor<size_t, 1> froLft = nodesFrontLeftOpenEdge();
-    xt::xtensor<size_t, 1> froRgt = nodesFrontRightOpenEdge();
-    xt::xtensor<size_t, 1> bckBot = nodesBackBottomOpenEdge();
-    xt::xtensor<size_t, 1> bckTop = nodesBackTopOpenEdge();
-    xt::xtensor<size_t, 1> bckLft = nodesBackLeftOpenEdge();
-    xt::xtensor<size_t, 1> bckRgt = nodesBackRightOpenEdge();
-    xt::xtensor<size_t, 1> botLft = nodesBottomLeftOpenEdge();
-    xt::xtensor<size_t, 1> botRgt = nodesBottomRightOpenEdge();
-    xt::xtensor<size_t, 1> topLft = nodesTopLeftOpenEdge();
-    xt::xtensor<size_t, 1> topRgt = nodesTopRightOpenEdge();
-
-    size_t tface = fro.size() + lft.size() + bot.size();
-    size_t tedge = 3 * froBot.size() + 3 * froLft.size() + 3 * botLft.size();
-    size_t tnode = 7;
-    xt::xtensor<size_t, 2> ret = xt::empty<size_t>({tface + tedge + tnode, std::size_t(2)});
-
-    size_t i = 0;
-
-    ret(i, 0) = nodesFrontBottomLeftCorner();
-    ret(i, 1) = nodesFrontBottomRightCorner();
-    ++i;
-    ret(i, 0) = nodesFrontBottomLeftCorner();
-    ret(i, 1) = nodesBackBottomRightCorner();
-    ++i;
-    ret(i, 0) = nodesFrontBottomLeftCorner();
-    ret(i, 1) = nodesBackBottomLeftCorner();
-    ++i;
-    ret(i, 0) = nodesFrontBottomLeftCorner();
-    ret(i, 1) = nodesFrontTopLeftCorner();
-    ++i;
-    ret(i, 0) = nodesFrontBottomLeftCorner();
-    ret(i, 1) = nodesFrontTopRightCorner();
-    ++i;
-    ret(i, 0) = nodesFrontBottomLeftCorner();
-    ret(i, 1) = nodesBackTopRightCorner();
-    ++i;
-    ret(i, 0) = nodesFrontBottomLeftCorner();
-    ret(i, 1) = nodesBackTopLeftCorner();
-    ++i;
-
-    for (size_t j = 0; j < froBot.size(); ++j) {
-        ret(i, 0) = froBot(j);
-        ret(i, 1) = bckBot(j);
-        ++i;
-    }
-    for (size_t j = 0; j < froBot.size(); ++j) {
-        ret(i, 0) = froBot(j);
-        ret(i, 1) = bckTop(j);
-        ++i;
-    }
-    for (size_t j = 0; j < froBot.size(); ++j) {
-        ret(i, 0) = froBot(j);
-        ret(i, 1) = froTop(j);
+inline const xt::xtensor<size_t, 2>& Regular::nodesPeriodic() const
+{
+    return m_nodesPeriodic.get([this]() {
+        xt::xtensor<size_t, 1> fro = nodesFrontFace();
+        xt::xtensor<size_t, 1> bck = nodesBackFace();
+        xt::xtensor<size_t, 1> lft = nodesLeftFace();
+        xt::xtensor<size_t, 1> rgt = nodesRightFace();
+        xt::xtensor<size_t, 1> bot = nodesBottomFace();
+        xt::xtensor<size_t, 1> top = nodesTopFace();
+
+        xt::xtensor<size_t, 1> froBot = nodesFrontBottomOpenEdge();
+        xt::xtensor<size_t, 1> froTop = nodesFrontTopOpenEdge();
+        xt::xtensor<size_t, 1> froLft = nodesFrontLeftOpenEdge();
+        xt::xtensor<size_t, 1> froRgt = nodesFrontRightOpenEdge();
+        xt::xtensor<size_t, 1> bckBot = nodesBackBottomOpenEdge();
+        xt::xtensor<size_t, 1> bckTop = nodesBackTopOpenEdge();
+        xt::xtensor<size_t, 1> bckLft = nodesBackLeftOpenEdge();
+        xt::xtensor<size_t, 1> bckRgt = nodesBackRightOpenEdge();
+        xt::xtensor<size_t, 1> botLft = nodesBottomLeftOpenEdge();
+        xt::xtensor<size_t, 1> botRgt = nodesBottomRightOpenEdge();
+        xt::xtensor<size_t, 1> topLft = nodesTopLeftOpenEdge();
+        xt::xtensor<size_t, 1> topRgt = nodesTopRightOpenEdge();
+
+        size_t tface = fro.size() + lft.size() + bot.size();
+        size_t tedge = 3 * froBot.size() + 3 * froLft.size() + 3 * botLft.size();
+        size_t tnode = 7;
+        xt::xtensor<size_t, 2> ret = xt::empty<size_t>({tface + tedge + tnode, std::size_t(2)});
+
+        size_t i = 0;
+
+        ret(i, 0) = nodesFrontBottomLeftCorner();
+        ret(i, 1) = nodesFrontBottomRightCorner();
         ++i;
-    }
-    for (size_t j = 0; j < botLft.size(); ++j) {
-        ret(i, 0) = botLft(j);
-        ret(i, 1) = botRgt(j);
+        ret(i, 0) = nodesFrontBottomLeftCorner();
+        ret(i, 1) = nodesBackBottomRightCorner();
         ++i;
-    }
-    for (size_t j = 0; j < botLft.size(); ++j) {
-        ret(i, 0) = botLft(j);
-        ret(i, 1) = topRgt(j);
+        ret(i, 0) = nodesFrontBottomLeftCorner();
+        ret(i, 1) = nodesBackBottomLeftCorner();
         ++i;
-    }
-    for (size_t j = 0; j < botLft.size(); ++j) {
-        ret(i, 0) = botLft(j);
-        ret(i, 1) = topLft(j);
+        ret(i, 0) = nodesFrontBottomLeftCorner();
+        ret(i, 1) = nodesFrontTopLeftCorner();
         ++i;
-    }
-    for (size_t j = 0; j < froLft.size(); ++j) {
-        ret(i, 0) = froLft(j);
-        ret(i, 1) = froRgt(j);
+        ret(i, 0) = nodesFrontBottomLeftCorner();
+        ret(i, 1) = nodesFrontTopRightCorner();
         ++i;
-    }
-    for (size_t j = 0; j < froLft.size(); ++j) {
-        ret(i, 0) = froLft(j);
-        ret(i, 1) = bckRgt(j);
+        ret(i, 0) = nodesFrontBottomLeftCorner();
+        ret(i, 1) = nodesBackTopRightCorner();
         ++i;
-    }
-    for (size_t j = 0; j < froLft.size(); ++j) {
-        ret(i, 0) = froLft(j);
-        ret(i, 1) = bckLft(j);
+        ret(i, 0) = nodesFrontBottomLeftCorner();
+        ret(i, 1) = nodesBackTopLeftCorner();
         ++i;
-    }
 
-    for (size_t j = 0; j < fro.size(); ++j) {
-        ret(i, 0) = fro(j);
-        ret(i, 1) = bck(j);
-        ++i;
-    }
-    for (size_t j = 0; j < lft.size(); ++j) {
-        ret(i, 0) = lft(j);
-        ret(i, 1) = rgt(j);
-        ++i;
-    }
-    for (size_t j = 0; j < bot.size(); ++j) {
-        ret(i, 0) = bot(j);
-        ret(i, 1) = top(j);
-        ++i;
-    }
+        for (size_t j = 0; j < froBot.size(); ++j) {
+            ret(i, 0) = froBot(j);
+            ret(i, 1) = bckBot(j);
+            ++i;
+        }
+        for (size_t j = 0; j < froBot.size(); ++j) {
+            ret(i, 0) = froBot(j);
+            ret(i, 1) = bckTop(j);
+            ++i;
+        }
+        for (size_t j = 0; j < froBot.size(); ++j) {
+            ret(i, 0) = froBot(j);
+            ret(i, 1) = froTop(j);
+            ++i;
+        }
+        for (size_t j = 0; j < botLft.size(); ++j) {
+            ret(i, 0) = botLft(j);
+            ret(i, 1) = botRgt(j);
+            ++i;
+        }
+        for (size_t j = 0; j < botLft.size(); ++j) {
+            ret(i, 0) = botLft(j);
+            ret(i, 1) = topRgt(j);
+            ++i;
+        }
+        for (size_t j = 0; j < botLft.size(); ++j) {
+            ret(i, 0) = botLft(j);
+            ret(i, 1) = topLft(j);
+            ++i;
+        }
+        for (size_t j = 0; j < froLft.size(); ++j) {
+            ret(i, 0) = froLft(j);
+            ret(i, 1) = froRgt(j);
+            ++i;
+        }
+        for (size_t j = 0; j < froLft.size(); ++j) {
+            ret(i, 0) = froLft(j);
+            ret(i, 1) = bckRgt(j);
+            ++i;
+        }
+        for (size_t j = 0; j < froLft.size(); ++j) {
+            ret(i, 0) = froLft(j);
+            ret(i, 1) = bckLft(j);
+            ++i;
+        }
 
-    return ret;
+        for (size_t j = 0; j < fro.size(); ++j) {
+            ret(i, 0) = fro(j);
+            ret(i, 1) = bck(j);
+            ++i;
+        }
+        for (size_t j = 0; j < lft.size(); ++j) {
+            ret(i, 0) = lft(j);
+            ret(i, 1) = rgt(j);
+            ++i;
+        }
+        for (size_t j = 0; j < bot.size(); ++j) {
+            ret(i, 0) = bot(j);
+            ret(i, 1) = top(j);
+            ++i;
+        }
+
+        return ret;
+    });
 }
 
 inline size_t Regular::nodesOrigin() const
@@ -952,23 +1037,43 @@ inline size_t Regular::nodesOrigin() const
     return nodesFrontBottomLeftCorner();
 }
 
-inline xt::xtensor<size_t, 2> Regular::dofs() const
+inline Coloring Regular::coloring() const
 {
-    return GooseFEM::Mesh::dofs(m_nnode, m_ndim);
+    xt::xtensor<size_t, 1> ret = xt::empty<size_t>({m_nelem});
+
+    for (size_t iz = 0; iz < m_nelz; ++iz) {
+        for (size_t iy = 0; iy < m_nely; ++iy) {
+            for (size_t ix = 0; ix < m_nelx; ++ix) {
+                ret(iz * m_nely * m_nelx + iy * m_nelx + ix) =
+                    (ix % 2) + 2 * (iy % 2) + 4 * (iz % 2);
+            }
+        }
+    }
+
+    return Coloring(ret);
+}
+
+inline const xt::xtensor<size_t, 2>& Regular::dofs() const
+{
+    return m_dofs.get([this]() {
+        return GooseFEM::Mesh::dofs(m_nnode, m_ndim);
+    });
 }
 
-inline xt::xtensor<size_t, 2> Regular::dofsPeriodic() const
+inline const xt::xtensor<size_t, 2>& Regular::dofsPeriodic() const
 {
-    xt::xtensor<size_t, 2> ret = GooseFEM::Mesh::dofs(m_nnode, m_ndim);
-    xt::xtensor<size_t, 2> nodePer = nodesPeriodic();
+    return m_dofsPeriodic.get([this]() {
+        xt::xtensor<size_t, 2> ret = GooseFEM::Mesh::dofs(m_nnode, m_ndim);
+        xt::xtensor<size_t, 2> nodePer = nodesPeriodic();
 
-    for (size_t i = 0; i < nodePer.shape(0); ++i) {
-        for (size_t j = 0; j < m_ndim; ++j) {
-            ret(nodePer(i, 1), j) = ret(nodePer(i, 0), j);
+        for (size_t i = 0; i < nodePer.shape(0); ++i) {
+            for (size_t j = 0; j < m_ndim; ++j) {
+                ret(nodePer(i, 1), j) = ret(nodePer(i, 0), j);
+            }
         }
-    }
 
-    return GooseFEM::Mesh::renumber(ret);
+        return GooseFEM::Mesh::renumber(ret);
+    });
 }
 
 inline FineLayer::FineLayer(size_t nelx, size_t nely, size_t nelz, double h, size_t nfine) : m_h(h)
@@ -1230,369 +1335,399 @@ inline ElementType FineLayer::getElementType() const
     return ElementType::Hex8;
 }
 
-inline xt::xtensor<double, 2> FineLayer::coor() const
+inline void FineLayer::clear_cache()
 {
-    // allocate output
-    xt::xtensor<double, 2> ret = xt::empty<double>({m_nnode, m_ndim});
+    m_coor.clear();
+    m_conn.clear();
+    m_dofs.clear();
+    m_dofsPeriodic.clear();
+    m_nodesPeriodic.clear();
+}
 
-    // current node, number of element layers
-    size_t inode = 0;
+inline const xt::xtensor<double, 2>& FineLayer::coor() const
+{
+    return m_coor.get([this]() {
+        // allocate output
+        xt::xtensor<double, 2> ret = xt::empty<double>({m_nnode, m_ndim});
+
+        // number of element layers
+        size_t nely = static_cast<size_t>(m_nhy.size());
+
+        // fill all node layers (independent, each writes to its own rows)
+        #pragma omp parallel for
+        for (size_t iy = 0; iy < nely + 1; ++iy) {
+            this->coor_layer(iy, 0, ret);
+        }
+
+        return ret;
+    });
+}
+
+inline xt::xtensor<double, 2> FineLayer::coor(size_t begin, size_t end) const
+{
+    GOOSEFEM_ASSERT(begin <= end && end <= m_nnode);
+
+    xt::xtensor<double, 2> ret = xt::empty<double>({end - begin, m_ndim});
     size_t nely = static_cast<size_t>(m_nhy.size());
 
-    // y-position of each main node layer (i.e. excluding node layers for refinement/coarsening)
-    // - allocate
-    xt::xtensor<double, 1> y = xt::empty<double>({nely + 1});
-    // - initialize
-    y(0) = 0.0;
-    // - compute
-    for (size_t iy = 1; iy < nely + 1; ++iy) {
-        y(iy) = y(iy - 1) + m_nhy(iy - 1) * m_h;
+    for (size_t iy = 0; iy < nely + 1; ++iy) {
+        size_t start = m_startNode(iy);
+        size_t stop = iy < nely ? m_startNode(iy + 1) : m_nnode;
+        if (stop <= begin || start >= end) {
+            continue;
+        }
+        if (start >= begin && stop <= end) {
+            this->coor_layer(iy, begin, ret);
+            continue;
+        }
+        xt::xtensor<double, 2> layer = xt::empty<double>({stop - start, m_ndim});
+        this->coor_layer(iy, start, layer);
+        size_t i = std::max(start, begin);
+        size_t j = std::min(stop, end);
+        xt::view(ret, xt::range(i - begin, j - begin), xt::all()) =
+            xt::view(layer, xt::range(i - start, j - start), xt::all());
     }
 
-    // loop over element layers (bottom -> middle) : add bottom layer (+ refinement layer) of nodes
+    return ret;
+}
+
+inline void FineLayer::coor_layer(size_t iy, size_t offset, xt::xtensor<double, 2>& ret) const
+{
+    // current node, number of element layers
+    size_t inode = m_startNode(iy) - offset;
+    size_t nely = static_cast<size_t>(m_nhy.size());
 
-    for (size_t iy = 0;; ++iy) {
-        // get positions along the x- and z-axis
-        xt::xtensor<double, 1> x = xt::linspace<double>(0.0, m_Lx, m_nelx(iy) + 1);
-        xt::xtensor<double, 1> z = xt::linspace<double>(0.0, m_Lz, m_nelz(iy) + 1);
+    // y-position of the main node layer (i.e. excluding node layers for refinement/coarsening)
+    double y = 0.0;
+    for (size_t i = 0; i < iy; ++i) {
+        y = y + m_nhy(i) * m_h;
+    }
 
-        // add nodes of the bottom layer of this element
-        for (size_t iz = 0; iz < m_nelz(iy) + 1; ++iz) {
-            for (size_t ix = 0; ix < m_nelx(iy) + 1; ++ix) {
-                ret(inode, 0) = x(ix);
-                ret(inode, 1) = y(iy);
-                ret(inode, 2) = z(iz);
-                ++inode;
-            }
-        }
+    // add nodes of the main node layer: its number of elements is that of the element layer
+    // on the side of the middle layer
+    size_t jy = iy <= (nely - 1) / 2 ? iy : iy - 1;
+    xt::xtensor<double, 1> x = xt::linspace<double>(0.0, m_Lx, m_nelx(jy) + 1);
+    xt::xtensor<double, 1> z = xt::linspace<double>(0.0, m_Lz, m_nelz(jy) + 1);
 
-        // stop at middle layer
-        if (iy == (nely - 1) / 2) {
-            break;
+    for (size_t iz = 0; iz < m_nelz(jy) + 1; ++iz) {
+        for (size_t ix = 0; ix < m_nelx(jy) + 1; ++ix) {
+            ret(inode, 0) = x(ix);
+            ret(inode, 1) = y;
+            ret(inode, 2) = z(iz);
+            ++inode;
         }
+    }
 
-        // add extra nodes of the intermediate layer, for refinement in x-direction
-        if (m_refine(iy) == 0) {
-            // - get position offset in x- and y-direction
-            double dx = m_h * static_cast<double>(m_nhx(iy) / 3);
-            double dy = m_h * static_cast<double>(m_nhy(iy) / 2);
-            // - add nodes of the intermediate layer
-            for (size_t iz = 0; iz < m_nelz(iy) + 1; ++iz) {
-                for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
-                    for (size_t j = 0; j < 2; ++j) {
-                        ret(inode, 0) = x(ix) + dx * static_cast<double>(j + 1);
-                        ret(inode, 1) = y(iy) + dy;
-                        ret(inode, 2) = z(iz);
-                        ++inode;
-                    }
+    // top node layer: no element layer above
+    if (iy == nely) {
+        return;
+    }
+
+    // get positions along the x- and z-axis
+    x = xt::linspace<double>(0.0, m_Lx, m_nelx(iy) + 1);
+    z = xt::linspace<double>(0.0, m_Lz, m_nelz(iy) + 1);
+
+    // add extra nodes of the intermediate layer, for refinement in x-direction
+    if (m_refine(iy) == 0) {
+        // - get position offset in x- and y-direction
+        double dx = m_h * static_cast<double>(m_nhx(iy) / 3);
+        double dy = m_h * static_cast<double>(m_nhy(iy) / 2);
+        // - add nodes of the intermediate layer
+        for (size_t iz = 0; iz < m_nelz(iy) + 1; ++iz) {
+            for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
+                for (size_t j = 0; j < 2; ++j) {
+                    ret(inode, 0) = x(ix) + dx * static_cast<double>(j + 1);
+                    ret(inode, 1) = y + dy;
+                    ret(inode, 2) = z(iz);
+                    ++inode;
                 }
             }
         }
+    }
 
-        // add extra nodes of the intermediate layer, for refinement in z-direction
-        else if (m_refine(iy) == 2) {
-            // - get position offset in y- and z-direction
-            double dz = m_h * static_cast<double>(m_nhz(iy) / 3);
-            double dy = m_h * static_cast<double>(m_nhy(iy) / 2);
-            // - add nodes of the intermediate layer
-            for (size_t iz = 0; iz < m_nelz(iy); ++iz) {
-                for (size_t j = 0; j < 2; ++j) {
-                    for (size_t ix = 0; ix < m_nelx(iy) + 1; ++ix) {
-                        ret(inode, 0) = x(ix);
-                        ret(inode, 1) = y(iy) + dy;
-                        ret(inode, 2) = z(iz) + dz * static_cast<double>(j + 1);
-                        ++inode;
-                    }
+    // add extra nodes of the intermediate layer, for refinement in z-direction
+    else if (m_refine(iy) == 2) {
+        // - get position offset in y- and z-direction
+        double dz = m_h * static_cast<double>(m_nhz(iy) / 3);
+        double dy = m_h * static_cast<double>(m_nhy(iy) / 2);
+        // - add nodes of the intermediate layer
+        for (size_t iz = 0; iz < m_nelz(iy); ++iz) {
+            for (size_t j = 0; j < 2; ++j) {
+                for (size_t ix = 0; ix < m_nelx(iy) + 1; ++ix) {
+                    ret(inode, 0) = x(ix);
+                    ret(inode, 1) = y + dy;
+                    ret(inode, 2) = z(iz) + dz * static_cast<double>(j + 1);
+                    ++inode;
                 }
             }
         }
     }
+}
 
-    // loop over element layers (middle -> top) : add (refinement layer +) top layer of nodes
+inline const xt::xtensor<size_t, 2>& FineLayer::conn() const
+{
+    return m_conn.get([this]() {
+        // allocate output
+        xt::xtensor<size_t, 2> ret = xt::empty<size_t>({m_nelem, m_nne});
 
-    for (size_t iy = (nely - 1) / 2; iy < nely; ++iy) {
-        // get positions along the x- and z-axis
-        xt::xtensor<double, 1> x = xt::linspace<double>(0.0, m_Lx, m_nelx(iy) + 1);
-        xt::xtensor<double, 1> z = xt::linspace<double>(0.0, m_Lz, m_nelz(iy) + 1);
+        // number of element layers
+        size_t nely = static_cast<size_t>(m_nhy.size());
 
-        // add extra nodes of the intermediate layer, for refinement in x-direction
-        if (m_refine(iy) == 0) {
-            // - get position offset in x- and y-direction
-            double dx = m_h * static_cast<double>(m_nhx(iy) / 3);
-            double dy = m_h * static_cast<double>(m_nhy(iy) / 2);
-            // - add nodes of the intermediate layer
-            for (size_t iz = 0; iz < m_nelz(iy) + 1; ++iz) {
-                for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
-                    for (size_t j = 0; j < 2; ++j) {
-                        ret(inode, 0) = x(ix) + dx * static_cast<double>(j + 1);
-                        ret(inode, 1) = y(iy) + dy;
-                        ret(inode, 2) = z(iz);
-                        ++inode;
-                    }
-                }
-            }
+        // fill all element layers (independent, each writes to its own rows)
+        #pragma omp parallel for
+        for (size_t iy = 0; iy < nely; ++iy) {
+            this->conn_layer(iy, 0, ret);
         }
 
-        // add extra nodes of the intermediate layer, for refinement in z-direction
-        else if (m_refine(iy) == 2) {
-            // - get position offset in y- and z-direction
-            double dz = m_h * static_cast<double>(m_nhz(iy) / 3);
-            double dy = m_h * static_cast<double>(m_nhy(iy) / 2);
-            // - add nodes of the intermediate layer
-            for (size_t iz = 0; iz < m_nelz(iy); ++iz) {
-                for (size_t j = 0; j < 2; ++j) {
-                    for (size_t ix = 0; ix < m_nelx(iy) + 1; ++ix) {
-                        ret(inode, 0) = x(ix);
-                        ret(inode, 1) = y(iy) + dy;
-                        ret(inode, 2) = z(iz) + dz * static_cast<double>(j + 1);
-                        ++inode;
-                    }
-                }
-            }
-        }
+        return ret;
+    });
+}
 
-        // add nodes of the top layer of this element
-        for (size_t iz = 0; iz < m_nelz(iy) + 1; ++iz) {
-            for (size_t ix = 0; ix < m_nelx(iy) + 1; ++ix) {
-                ret(inode, 0) = x(ix);
-                ret(inode, 1) = y(iy + 1);
-                ret(inode, 2) = z(iz);
-                ++inode;
-            }
+inline xt::xtensor<size_t, 2> FineLayer::conn(size_t begin, size_t end) const
+{
+    GOOSEFEM_ASSERT(begin <= end && end <= m_nelem);
+
+    xt::xtensor<size_t, 2> ret = xt::empty<size_t>({end - begin, m_nne});
+    size_t nely = static_cast<size_t>(m_nhy.size());
+
+    for (size_t iy = 0; iy < nely; ++iy) {
+        size_t start = m_startElem(iy);
+        size_t stop = iy + 1 < nely ? m_startElem(iy + 1) : m_nelem;
+        if (stop <= begin || start >= end) {
+            continue;
         }
+        if (start >= begin && stop <= end) {
+            this->conn_layer(iy, begin, ret);
+            continue;
+        }
+        xt::xtensor<size_t, 2> layer = xt::empty<size_t>({stop - start, m_nne});
+        this->conn_layer(iy, start, layer);
+        size_t i = std::max(start, begin);
+        size_t j = std::min(stop, end);
+        xt::view(ret, xt::range(i - begin, j - begin), xt::all()) =
+            xt::view(layer, xt::range(i - start, j - start), xt::all());
     }
 
     return ret;
 }
 
-inline xt::xtensor<size_t, 2> FineLayer::conn() const
+inline void FineLayer::conn_layer(size_t iy, size_t offset, xt::xtensor<size_t, 2>& ret) const
 {
-    // allocate output
-    xt::xtensor<size_t, 2> ret = xt::empty<size_t>({m_nelem, m_nne});
-
     // current element, number of element layers, starting nodes of each node layer
-    size_t ielem = 0;
+    size_t ielem = m_startElem(iy) - offset;
     size_t nely = static_cast<size_t>(m_nhy.size());
-    size_t bot, mid, top;
+    size_t bot = m_startNode(iy);
+    size_t mid = m_startNode(iy) + m_nnd(iy);
+    size_t top = m_startNode(iy + 1);
 
-    // loop over all element layers
-    for (size_t iy = 0; iy < nely; ++iy) {
-        // - get: starting nodes of bottom(, middle) and top layer
-        bot = m_startNode(iy);
-        mid = m_startNode(iy) + m_nnd(iy);
-        top = m_startNode(iy + 1);
-
-        // - define connectivity: no coarsening/refinement
-        if (m_refine(iy) == -1) {
-            for (size_t iz = 0; iz < m_nelz(iy); ++iz) {
-                for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
-                    ret(ielem, 0) = bot + ix + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 1) = bot + (ix + 1) + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 2) = top + (ix + 1) + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 3) = top + ix + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 4) = bot + ix + (iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 5) = bot + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 6) = top + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 7) = top + ix + (iz + 1) * (m_nelx(iy) + 1);
-                    ielem++;
-                }
+    // - define connectivity: no coarsening/refinement
+    if (m_refine(iy) == -1) {
+        for (size_t iz = 0; iz < m_nelz(iy); ++iz) {
+            for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
+                ret(ielem, 0) = bot + ix + iz * (m_nelx(iy) + 1);
+                ret(ielem, 1) = bot + (ix + 1) + iz * (m_nelx(iy) + 1);
+                ret(ielem, 2) = top + (ix + 1) + iz * (m_nelx(iy) + 1);
+                ret(ielem, 3) = top + ix + iz * (m_nelx(iy) + 1);
+                ret(ielem, 4) = bot + ix + (iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 5) = bot + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 6) = top + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 7) = top + ix + (iz + 1) * (m_nelx(iy) + 1);
+                ielem++;
             }
         }
+    }
 
-        // - define connectivity: refinement along the x-direction (below the middle layer)
-        else if (m_refine(iy) == 0 && iy <= (nely - 1) / 2) {
-            for (size_t iz = 0; iz < m_nelz(iy); ++iz) {
-                for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
-                    // -- bottom element
-                    ret(ielem, 0) = bot + ix + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 1) = bot + (ix + 1) + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 2) = mid + (2 * ix + 1) + iz * (2 * m_nelx(iy));
-                    ret(ielem, 3) = mid + (2 * ix) + iz * (2 * m_nelx(iy));
-                    ret(ielem, 4) = bot + ix + (iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 5) = bot + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 6) = mid + (2 * ix + 1) + (iz + 1) * (2 * m_nelx(iy));
-                    ret(ielem, 7) = mid + (2 * ix) + (iz + 1) * (2 * m_nelx(iy));
-                    ielem++;
-                    // -- top-right element
-                    ret(ielem, 0) = bot + (ix + 1) + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 1) = top + (3 * ix + 3) + iz * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 2) = top + (3 * ix + 2) + iz * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 3) = mid + (2 * ix + 1) + iz * (2 * m_nelx(iy));
-                    ret(ielem, 4) = bot + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 5) = top + (3 * ix + 3) + (iz + 1) * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 6) = top + (3 * ix + 2) + (iz + 1) * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 7) = mid + (2 * ix + 1) + (iz + 1) * (2 * m_nelx(iy));
-                    ielem++;
-                    // -- top-center element
-                    ret(ielem, 0) = mid + (2 * ix) + iz * (2 * m_nelx(iy));
-                    ret(ielem, 1) = mid + (2 * ix + 1) + iz * (2 * m_nelx(iy));
-                    ret(ielem, 2) = top + (3 * ix + 2) + iz * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 3) = top + (3 * ix + 1) + iz * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 4) = mid + (2 * ix) + (iz + 1) * (2 * m_nelx(iy));
-                    ret(ielem, 5) = mid + (2 * ix + 1) + (iz + 1) * (2 * m_nelx(iy));
-                    ret(ielem, 6) = top + (3 * ix + 2) + (iz + 1) * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 7) = top + (3 * ix + 1) + (iz + 1) * (3 * m_nelx(iy) + 1);
-                    ielem++;
-                    // -- top-left element
-                    ret(ielem, 0) = bot + ix + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 1) = mid + (2 * ix) + iz * (2 * m_nelx(iy));
-                    ret(ielem, 2) = top + (3 * ix + 1) + iz * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 3) = top + (3 * ix) + iz * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 4) = bot + ix + (iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 5) = mid + (2 * ix) + (iz + 1) * (2 * m_nelx(iy));
-                    ret(ielem, 6) = top + (3 * ix + 1) + (iz + 1) * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 7) = top + (3 * ix) + (iz + 1) * (3 * m_nelx(iy) + 1);
-                    ielem++;
-                }
+    // - define connectivity: refinement along the x-direction (below the middle layer)
+    else if (m_refine(iy) == 0 && iy <= (nely - 1) / 2) {
+        for (size_t iz = 0; iz < m_nelz(iy); ++iz) {
+            for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
+                // -- bottom element
+                ret(ielem, 0) = bot + ix + iz * (m_nelx(iy) + 1);
+                ret(ielem, 1) = bot + (ix + 1) + iz * (m_nelx(iy) + 1);
+                ret(ielem, 2) = mid + (2 * ix + 1) + iz * (2 * m_nelx(iy));
+                ret(ielem, 3) = mid + (2 * ix) + iz * (2 * m_nelx(iy));
+                ret(ielem, 4) = bot + ix + (iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 5) = bot + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 6) = mid + (2 * ix + 1) + (iz + 1) * (2 * m_nelx(iy));
+                ret(ielem, 7) = mid + (2 * ix) + (iz + 1) * (2 * m_nelx(iy));
+                ielem++;
+                // -- top-right element
+                ret(ielem, 0) = bot + (ix + 1) + iz * (m_nelx(iy) + 1);
+                ret(ielem, 1) = top + (3 * ix + 3) + iz * (3 * m_nelx(iy) + 1);
+                ret(ielem, 2) = top + (3 * ix + 2) + iz * (3 * m_nelx(iy) + 1);
+                ret(ielem, 3) = mid + (2 * ix + 1) + iz * (2 * m_nelx(iy));
+                ret(ielem, 4) = bot + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 5) = top + (3 * ix + 3) + (iz + 1) * (3 * m_nelx(iy) + 1);
+                ret(ielem, 6) = top + (3 * ix + 2) + (iz + 1) * (3 * m_nelx(iy) + 1);
+                ret(ielem, 7) = mid + (2 * ix + 1) + (iz + 1) * (2 * m_nelx(iy));
+                ielem++;
+                // -- top-center element
+                ret(ielem, 0) = mid + (2 * ix) + iz * (2 * m_nelx(iy));
+                ret(ielem, 1) = mid + (2 * ix + 1) + iz * (2 * m_nelx(iy));
+                ret(ielem, 2) = top + (3 * ix + 2) + iz * (3 * m_nelx(iy) + 1);
+                ret(ielem, 3) = top + (3 * ix + 1) + iz * (3 * m_nelx(iy) + 1);
+                ret(ielem, 4) = mid + (2 * ix) + (iz + 1) * (2 * m_nelx(iy));
+                ret(ielem, 5) = mid + (2 * ix + 1) + (iz + 1) * (2 * m_nelx(iy));
+                ret(ielem, 6) = top + (3 * ix + 2) + (iz + 1) * (3 * m_nelx(iy) + 1);
+                ret(ielem, 7) = top + (3 * ix + 1) + (iz + 1) * (3 * m_nelx(iy) + 1);
+                ielem++;
+                // -- top-left element
+                ret(ielem, 0) = bot + ix + iz * (m_nelx(iy) + 1);
+                ret(ielem, 1) = mid + (2 * ix) + iz * (2 * m_nelx(iy));
+                ret(ielem, 2) = top + (3 * ix + 1) + iz * (3 * m_nelx(iy) + 1);
+                ret(ielem, 3) = top + (3 * ix) + iz * (3 * m_nelx(iy) + 1);
+                ret(ielem, 4) = bot + ix + (iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 5) = mid + (2 * ix) + (iz + 1) * (2 * m_nelx(iy));
+                ret(ielem, 6) = top + (3 * ix + 1) + (iz + 1) * (3 * m_nelx(iy) + 1);
+                ret(ielem, 7) = top + (3 * ix) + (iz + 1) * (3 * m_nelx(iy) + 1);
+                ielem++;
             }
         }
+    }
 
-        // - define connectivity: coarsening along the x-direction (above the middle layer)
-        else if (m_refine(iy) == 0 && iy > (nely - 1) / 2) {
-            for (size_t iz = 0; iz < m_nelz(iy); ++iz) {
-                for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
-                    // -- lower-left element
-                    ret(ielem, 0) = bot + (3 * ix) + iz * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 1) = bot + (3 * ix + 1) + iz * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 2) = mid + (2 * ix) + iz * (2 * m_nelx(iy));
-                    ret(ielem, 3) = top + ix + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 4) = bot + (3 * ix) + (iz + 1) * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 5) = bot + (3 * ix + 1) + (iz + 1) * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 6) = mid + (2 * ix) + (iz + 1) * (2 * m_nelx(iy));
-                    ret(ielem, 7) = top + ix + (iz + 1) * (m_nelx(iy) + 1);
-                    ielem++;
-                    // -- lower-center element
-                    ret(ielem, 0) = bot + (3 * ix + 1) + iz * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 1) = bot + (3 * ix + 2) + iz * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 2) = mid + (2 * ix + 1) + iz * (2 * m_nelx(iy));
-                    ret(ielem, 3) = mid + (2 * ix) + iz * (2 * m_nelx(iy));
-                    ret(ielem, 4) = bot + (3 * ix + 1) + (iz + 1) * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 5) = bot + (3 * ix + 2) + (iz + 1) * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 6) = mid + (2 * ix + 1) + (iz + 1) * (2 * m_nelx(iy));
-                    ret(ielem, 7) = mid + (2 * ix) + (iz + 1) * (2 * m_nelx(iy));
-                    ielem++;
-                    // -- lower-right element
-                    ret(ielem, 0) = bot + (3 * ix + 2) + iz * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 1) = bot + (3 * ix + 3) + iz * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 2) = top + (ix + 1) + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 3) = mid + (2 * ix + 1) + iz * (2 * m_nelx(iy));
-                    ret(ielem, 4) = bot + (3 * ix + 2) + (iz + 1) * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 5) = bot + (3 * ix + 3) + (iz + 1) * (3 * m_nelx(iy) + 1);
-                    ret(ielem, 6) = top + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 7) = mid + (2 * ix + 1) + (iz + 1) * (2 * m_nelx(iy));
-                    ielem++;
-                    // -- upper element
-                    ret(ielem, 0) = mid + (2 * ix) + iz * (2 * m_nelx(iy));
-                    ret(ielem, 1) = mid + (2 * ix + 1) + iz * (2 * m_nelx(iy));
-                    ret(ielem, 2) = top + (ix + 1) + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 3) = top + ix + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 4) = mid + (2 * ix) + (iz + 1) * (2 * m_nelx(iy));
-                    ret(ielem, 5) = mid + (2 * ix + 1) + (iz + 1) * (2 * m_nelx(iy));
-                    ret(ielem, 6) = top + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 7) = top + ix + (iz + 1) * (m_nelx(iy) + 1);
-                    ielem++;
-                }
+    // - define connectivity: coarsening along the x-direction (above the middle layer)
+    else if (m_refine(iy) == 0 && iy > (nely - 1) / 2) {
+        for (size_t iz = 0; iz < m_nelz(iy); ++iz) {
+            for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
+                // -- lower-left element
+                ret(ielem, 0) = bot + (3 * ix) + iz * (3 * m_nelx(iy) + 1);
+                ret(ielem, 1) = bot + (3 * ix + 1) + iz * (3 * m_nelx(iy) + 1);
+                ret(ielem, 2) = mid + (2 * ix) + iz * (2 * m_nelx(iy));
+                ret(ielem, 3) = top + ix + iz * (m_nelx(iy) + 1);
+                ret(ielem, 4) = bot + (3 * ix) + (iz + 1) * (3 * m_nelx(iy) + 1);
+                ret(ielem, 5) = bot + (3 * ix + 1) + (iz + 1) * (3 * m_nelx(iy) + 1);
+                ret(ielem, 6) = mid + (2 * ix) + (iz + 1) * (2 * m_nelx(iy));
+                ret(ielem, 7) = top + ix + (iz + 1) * (m_nelx(iy) + 1);
+                ielem++;
+                // -- lower-center element
+                ret(ielem, 0) = bot + (3 * ix + 1) + iz * (3 * m_nelx(iy) + 1);
+                ret(ielem, 1) = bot + (3 * ix + 2) + iz * (3 * m_nelx(iy) + 1);
+                ret(ielem, 2) = mid + (2 * ix + 1) + iz * (2 * m_nelx(iy));
+                ret(ielem, 3) = mid + (2 * ix) + iz * (2 * m_nelx(iy));
+                ret(ielem, 4) = bot + (3 * ix + 1) + (iz + 1) * (3 * m_nelx(iy) + 1);
+                ret(ielem, 5) = bot + (3 * ix + 2) + (iz + 1) * (3 * m_nelx(iy) + 1);
+                ret(ielem, 6) = mid + (2 * ix + 1) + (iz + 1) * (2 * m_nelx(iy));
+                ret(ielem, 7) = mid + (2 * ix) + (iz + 1) * (2 * m_nelx(iy));
+                ielem++;
+                // -- lower-right element
+                ret(ielem, 0) = bot + (3 * ix + 2) + iz * (3 * m_nelx(iy) + 1);
+                ret(ielem, 1) = bot + (3 * ix + 3) + iz * (3 * m_nelx(iy) + 1);
+                ret(ielem, 2) = top + (ix + 1) + iz * (m_nelx(iy) + 1);
+                ret(ielem, 3) = mid + (2 * ix + 1) + iz * (2 * m_nelx(iy));
+                ret(ielem, 4) = bot + (3 * ix + 2) + (iz + 1) * (3 * m_nelx(iy) + 1);
+                ret(ielem, 5) = bot + (3 * ix + 3) + (iz + 1) * (3 * m_nelx(iy) + 1);
+                ret(ielem, 6) = top + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 7) = mid + (2 * ix + 1) + (iz + 1) * (2 * m_nelx(iy));
+                ielem++;
+                // -- upper element
+                ret(ielem, 0) = mid + (2 * ix) + iz * (2 * m_nelx(iy));
+                ret(ielem, 1) = mid + (2 * ix + 1) + iz * (2 * m_nelx(iy));
+                ret(ielem, 2) = top + (ix + 1) + iz * (m_nelx(iy) + 1);
+                ret(ielem, 3) = top + ix + iz * (m_nelx(iy) + 1);
+                ret(ielem, 4) = mid + (2 * ix) + (iz + 1) * (2 * m_nelx(iy));
+                ret(ielem, 5) = mid + (2 * ix + 1) + (iz + 1) * (2 * m_nelx(iy));
+                ret(ielem, 6) = top + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 7) = top + ix + (iz + 1) * (m_nelx(iy) + 1);
+                ielem++;
             }
         }
+    }
 
-        // - define connectivity: refinement along the z-direction (below the middle layer)
-        else if (m_refine(iy) == 2 && iy <= (nely - 1) / 2) {
-            for (size_t iz = 0; iz < m_nelz(iy); ++iz) {
-                for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
-                    // -- bottom element
-                    ret(ielem, 0) = bot + ix + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 1) = bot + ix + (iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 2) = bot + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 3) = bot + (ix + 1) + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 4) = mid + ix + 2 * iz * (m_nelx(iy) + 1);
-                    ret(ielem, 5) = mid + ix + (2 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 6) = mid + (ix + 1) + (2 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 7) = mid + (ix + 1) + 2 * iz * (m_nelx(iy) + 1);
-                    ielem++;
-                    // -- top-back element
-                    ret(ielem, 0) = mid + ix + (2 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 1) = mid + (ix + 1) + (2 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 2) = top + (ix + 1) + (3 * iz + 2) * (m_nelx(iy) + 1);
-                    ret(ielem, 3) = top + ix + (3 * iz + 2) * (m_nelx(iy) + 1);
-                    ret(ielem, 4) = bot + ix + (iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 5) = bot + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 6) = top + (ix + 1) + (3 * iz + 3) * (m_nelx(iy) + 1);
-                    ret(ielem, 7) = top + ix + (3 * iz + 3) * (m_nelx(iy) + 1);
-                    ielem++;
-                    // -- top-center element
-                    ret(ielem, 0) = mid + ix + (2 * iz) * (m_nelx(iy) + 1);
-                    ret(ielem, 1) = mid + (ix + 1) + (2 * iz) * (m_nelx(iy) + 1);
-                    ret(ielem, 2) = top + (ix + 1) + (3 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 3) = top + ix + (3 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 4) = mid + ix + (2 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 5) = mid + (ix + 1) + (2 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 6) = top + (ix + 1) + (3 * iz + 2) * (m_nelx(iy) + 1);
-                    ret(ielem, 7) = top + ix + (3 * iz + 2) * (m_nelx(iy) + 1);
-                    ielem++;
-                    // -- top-front element
-                    ret(ielem, 0) = bot + ix + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 1) = bot + (ix + 1) + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 2) = top + (ix + 1) + (3 * iz) * (m_nelx(iy) + 1);
-                    ret(ielem, 3) = top + ix + (3 * iz) * (m_nelx(iy) + 1);
-                    ret(ielem, 4) = mid + ix + (2 * iz) * (m_nelx(iy) + 1);
-                    ret(ielem, 5) = mid + (ix + 1) + (2 * iz) * (m_nelx(iy) + 1);
-                    ret(ielem, 6) = top + (ix + 1) + (3 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 7) = top + ix + (3 * iz + 1) * (m_nelx(iy) + 1);
-                    ielem++;
-                }
+    // - define connectivity: refinement along the z-direction (below the middle layer)
+    else if (m_refine(iy) == 2 && iy <= (nely - 1) / 2) {
+        for (size_t iz = 0; iz < m_nelz(iy); ++iz) {
+            for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
+                // -- bottom element
+                ret(ielem, 0) = bot + ix + iz * (m_nelx(iy) + 1);
+                ret(ielem, 1) = bot + ix + (iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 2) = bot + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 3) = bot + (ix + 1) + iz * (m_nelx(iy) + 1);
+                ret(ielem, 4) = mid + ix + 2 * iz * (m_nelx(iy) + 1);
+                ret(ielem, 5) = mid + ix + (2 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 6) = mid + (ix + 1) + (2 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 7) = mid + (ix + 1) + 2 * iz * (m_nelx(iy) + 1);
+                ielem++;
+                // -- top-back element
+                ret(ielem, 0) = mid + ix + (2 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 1) = mid + (ix + 1) + (2 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 2) = top + (ix + 1) + (3 * iz + 2) * (m_nelx(iy) + 1);
+                ret(ielem, 3) = top + ix + (3 * iz + 2) * (m_nelx(iy) + 1);
+                ret(ielem, 4) = bot + ix + (iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 5) = bot + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 6) = top + (ix + 1) + (3 * iz + 3) * (m_nelx(iy) + 1);
+                ret(ielem, 7) = top + ix + (3 * iz + 3) * (m_nelx(iy) + 1);
+                ielem++;
+                // -- top-center element
+                ret(ielem, 0) = mid + ix + (2 * iz) * (m_nelx(iy) + 1);
+                ret(ielem, 1) = mid + (ix + 1) + (2 * iz) * (m_nelx(iy) + 1);
+                ret(ielem, 2) = top + (ix + 1) + (3 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 3) = top + ix + (3 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 4) = mid + ix + (2 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 5) = mid + (ix + 1) + (2 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 6) = top + (ix + 1) + (3 * iz + 2) * (m_nelx(iy) + 1);
+                ret(ielem, 7) = top + ix + (3 * iz + 2) * (m_nelx(iy) + 1);
+                ielem++;
+                // -- top-front element
+                ret(ielem, 0) = bot + ix + iz * (m_nelx(iy) + 1);
+                ret(ielem, 1) = bot + (ix + 1) + iz * (m_nelx(iy) + 1);
+                ret(ielem, 2) = top + (ix + 1) + (3 * iz) * (m_nelx(iy) + 1);
+                ret(ielem, 3) = top + ix + (3 * iz) * (m_nelx(iy) + 1);
+                ret(ielem, 4) = mid + ix + (2 * iz) * (m_nelx(iy) + 1);
+                ret(ielem, 5) = mid + (ix + 1) + (2 * iz) * (m_nelx(iy) + 1);
+                ret(ielem, 6) = top + (ix + 1) + (3 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 7) = top + ix + (3 * iz + 1) * (m_nelx(iy) + 1);
+                ielem++;
             }
         }
+    }
 
-        // - define connectivity: coarsening along the z-direction (above the middle layer)
-        else if (m_refine(iy) == 2 && iy > (nely - 1) / 2) {
-            for (size_t iz = 0; iz < m_nelz(iy); ++iz) {
-                for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
-                    // -- bottom-front element
-                    ret(ielem, 0) = bot + ix + (3 * iz) * (m_nelx(iy) + 1);
-                    ret(ielem, 1) = bot + (ix + 1) + (3 * iz) * (m_nelx(iy) + 1);
-                    ret(ielem, 2) = top + (ix + 1) + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 3) = top + ix + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 4) = bot + ix + (3 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 5) = bot + (ix + 1) + (3 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 6) = mid + (ix + 1) + (2 * iz) * (m_nelx(iy) + 1);
-                    ret(ielem, 7) = mid + ix + (2 * iz) * (m_nelx(iy) + 1);
-                    ielem++;
-                    // -- bottom-center element
-                    ret(ielem, 0) = bot + ix + (3 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 1) = bot + (ix + 1) + (3 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 2) = mid + (ix + 1) + (2 * iz) * (m_nelx(iy) + 1);
-                    ret(ielem, 3) = mid + ix + (2 * iz) * (m_nelx(iy) + 1);
-                    ret(ielem, 4) = bot + ix + (3 * iz + 2) * (m_nelx(iy) + 1);
-                    ret(ielem, 5) = bot + (ix + 1) + (3 * iz + 2) * (m_nelx(iy) + 1);
-                    ret(ielem, 6) = mid + (ix + 1) + (2 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 7) = mid + ix + (2 * iz + 1) * (m_nelx(iy) + 1);
-                    ielem++;
-                    // -- bottom-back element
-                    ret(ielem, 0) = bot + ix + (3 * iz + 2) * (m_nelx(iy) + 1);
-                    ret(ielem, 1) = bot + (ix + 1) + (3 * iz + 2) * (m_nelx(iy) + 1);
-                    ret(ielem, 2) = mid + (ix + 1) + (2 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 3) = mid + ix + (2 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 4) = bot + ix + (3 * iz + 3) * (m_nelx(iy) + 1);
-                    ret(ielem, 5) = bot + (ix + 1) + (3 * iz + 3) * (m_nelx(iy) + 1);
-                    ret(ielem, 6) = top + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 7) = top + ix + (iz + 1) * (m_nelx(iy) + 1);
-                    ielem++;
-                    // -- top element
-                    ret(ielem, 0) = mid + ix + (2 * iz) * (m_nelx(iy) + 1);
-                    ret(ielem, 1) = mid + (ix + 1) + (2 * iz) * (m_nelx(iy) + 1);
-                    ret(ielem, 2) = top + (ix + 1) + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 3) = top + ix + iz * (m_nelx(iy) + 1);
-                    ret(ielem, 4) = mid + ix + (2 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 5) = mid + (ix + 1) + (2 * iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 6) = top + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
-                    ret(ielem, 7) = top + ix + (iz + 1) * (m_nelx(iy) + 1);
-                    ielem++;
-                }
+    // - define connectivity: coarsening along the z-direction (above the middle layer)
+    else if (m_refine(iy) == 2 && iy > (nely - 1) / 2) {
+        for (size_t iz = 0; iz < m_nelz(iy); ++iz) {
+            for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
+                // -- bottom-front element
+                ret(ielem, 0) = bot + ix + (3 * iz) * (m_nelx(iy) + 1);
+                ret(ielem, 1) = bot + (ix + 1) + (3 * iz) * (m_nelx(iy) + 1);
+                ret(ielem, 2) = top + (ix + 1) + iz * (m_nelx(iy) + 1);
+                ret(ielem, 3) = top + ix + iz * (m_nelx(iy) + 1);
+                ret(ielem, 4) = bot + ix + (3 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 5) = bot + (ix + 1) + (3 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 6) = mid + (ix + 1) + (2 * iz) * (m_nelx(iy) + 1);
+                ret(ielem, 7) = mid + ix + (2 * iz) * (m_nelx(iy) + 1);
+                ielem++;
+                // -- bottom-center element
+                ret(ielem, 0) = bot + ix + (3 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 1) = bot + (ix + 1) + (3 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 2) = mid + (ix + 1) + (2 * iz) * (m_nelx(iy) + 1);
+                ret(ielem, 3) = mid + ix + (2 * iz) * (m_nelx(iy) + 1);
+                ret(ielem, 4) = bot + ix + (3 * iz + 2) * (m_nelx(iy) + 1);
+                ret(ielem, 5) = bot + (ix + 1) + (3 * iz + 2) * (m_nelx(iy) + 1);
+                ret(ielem, 6) = mid + (ix + 1) + (2 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 7) = mid + ix + (2 * iz + 1) * (m_nelx(iy) + 1);
+                ielem++;
+                // -- bottom-back element
+                ret(ielem, 0) = bot + ix + (3 * iz + 2) * (m_nelx(iy) + 1);
+                ret(ielem, 1) = bot + (ix + 1) + (3 * iz + 2) * (m_nelx(iy) + 1);
+                ret(ielem, 2) = mid + (ix + 1) + (2 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 3) = mid + ix + (2 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 4) = bot + ix + (3 * iz + 3) * (m_nelx(iy) + 1);
+                ret(ielem, 5) = bot + (ix + 1) + (3 * iz + 3) * (m_nelx(iy) + 1);
+                ret(ielem, 6) = top + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 7) = top + ix + (iz + 1) * (m_nelx(iy) + 1);
+                ielem++;
+                // -- top element
+                ret(ielem, 0) = mid + ix + (2 * iz) * (m_nelx(iy) + 1);
+                ret(ielem, 1) = mid + (ix + 1) + (2 * iz) * (m_nelx(iy) + 1);
+                ret(ielem, 2) = top + (ix + 1) + iz * (m_nelx(iy) + 1);
+                ret(ielem, 3) = top + ix + iz * (m_nelx(iy) + 1);
+                ret(ielem, 4) = mid + ix + (2 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 5) = mid + (ix + 1) + (2 * iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 6) = top + (ix + 1) + (iz + 1) * (m_nelx(iy) + 1);
+                ret(ielem, 7) = top + ix + (iz + 1) * (m_nelx(iy) + 1);
+                ielem++;
             }
         }
     }
-
-    return ret;
 }
 
 inline xt::xtensor<size_t, 1> FineLayer::elementsMiddleLayer() const
@@ -2868,146 +3003,302 @@ inline size_t FineLayer::nodesRightTopBackCorner() const
     return nodesBackTopRightCorner();
 }
 
-inline xt::xtensor<size_t, 2> FineLayer::nodesPeriodic() const
-{
-    xt::xtensor<size_t, 1> fro = nodesFrontFace();
-    xt::xtensor<size_t, 1> bck = nodesBackFace();
-    xt::xtensor<size_t, 1> lft = nodesLeftFace();
-    xt::xtensor<size_t, 1> rgt = nodesRightFace();
-    xt::xtensor<size_t, 1> bot = nodesBottomFace();
-    xt::xtensor<size_t, 1> top = nodesTopFace();
-
-    xt::xtensor<size_t, 1> froBot = nodesFrontBottomOpenEdge();
-    xt::xtensor<size_t, 1> froTop = nodesFrontTopOpenEdge();
-    xt::xtensor<size_t, 1> froLft = nodesFrontLeftOpenEdge();
-    xt::xtensor<size_t, 1> froRgt = nodesFrontRightOpenEdge();
-    xt::xtensor<size_t, 1> bckBot = nodesBackBottomOpenEdge();
-    xt::xtensor<size_t, 1> bckTop = nodesBackTopOpenEdge();
-    xt::xtensor<size_t, 1> bckLft = nodesBackLeftOpenEdge();
-    xt::xtensor<size_t, 1> bckRgt = nodesBackRightOpenEdge();
-    xt::xtensor<size_t, 1> botLft = nodesBottomLeftOpenEdge();
-    xt::xtensor<size_t, 1> botRgt = nodesBottomRightOpenEdge();
-    xt::xtensor<size_t, 1> topLft = nodesTopLeftOpenEdge();
-    xt::xtensor<size_t, 1> topRgt = nodesTopRightOpenEdge();
-
-    size_t tface = fro.size() + lft.size() + bot.size();
-    size_t tedge = 3 * froBot.size() + 3 * froLft.size() + 3 * botLft.size();
-    size_t tnode = 7;
-    xt::xtensor<size_t, 2> ret = xt::empty<size_t>({tface + tedge + tnode, std::size_t(2)});
-
-    size_t i = 0;
-
-    ret(i, 0) = nodesFrontBottomLeftCorner();
-    ret(i, 1) = nodesFrontBottomRightCorner();
-    ++i;
-    ret(i, 0) = nodesFrontBottomLeftCorner();
-    ret(i, 1) = nodesBackBottomRightCorner();
-    ++i;
-    ret(i, 0) = nodesFrontBottomLeftCorner();
-    ret(i, 1) = nodesBackBottomLeftCorner();
-    ++i;
-    ret(i, 0) = nodesFrontBottomLeftCorner();
-    ret(i, 1) = nodesFrontTopLeftCorner();
-    ++i;
-    ret(i, 0) = nodesFrontBottomLeftCorner();
-    ret(i, 1) = nodesFrontTopRightCorner();
-    ++i;
-    ret(i, 0) = nodesFrontBottomLeftCorner();
-    ret(i, 1) = nodesBackTopRightCorner();
-    ++i;
-    ret(i, 0) = nodesFrontBottomLeftCorner();
-    ret(i, 1) = nodesBackTopLeftCorner();
-    ++i;
-
-    for (size_t j = 0; j < froBot.size(); ++j) {
-        ret(i, 0) = froBot(j);
-        ret(i, 1) = bckBot(j);
-        ++i;
-    }
-    for (size_t j = 0; j < froBot.size(); ++j) {
-        ret(i, 0) = froBot(j);
-        ret(i, 1) = bckTop(j);
-        ++i;
-    }
-    for (size_t j = 0; j < froBot.size(); ++j) {
-        ret(i, 0) = froBot(j);
-        ret(i, 1) = froTop(j);
+inline const xt::xtensor<size_t, 2>& FineLayer::nodesPeriodic() const
+{
+    return m_nodesPeriodic.get([this]() {
+        xt::xtensor<size_t, 1> fro = nodesFrontFace();
+        xt::xtensor<size_t, 1> bck = nodesBackFace();
+        xt::xtensor<size_t, 1> lft = nodesLeftFace();
+        xt::xtensor<size_t, 1> rgt = nodesRightFace();
+        xt::xtensor<size_t, 1> bot = nodesBottomFace();
+        xt::xtensor<size_t, 1> top = nodesTopFace();
+
+        xt::xtensor<size_t, 1> froBot = nodesFrontBottomOpenEdge();
+        xt::xtensor<size_t, 1> froTop = nodesFrontTopOpenEdge();
+        xt::xtensor<size_t, 1> froLft = nodesFrontLeftOpenEdge();
+        xt::xtensor<size_t, 1> froRgt = nodesFrontRightOpenEdge();
+        xt::xtensor<size_t, 1> bckBot = nodesBackBottomOpenEdge();
+        xt::xtensor<size_t, 1> bckTop = nodesBackTopOpenEdge();
+        xt::xtensor<size_t, 1> bckLft = nodesBackLeftOpenEdge();
+        xt::xtensor<size_t, 1> bckRgt = nodesBackRightOpenEdge();
+        xt::xtensor<size_t, 1> botLft = nodesBottomLeftOpenEdge();
+        xt::xtensor<size_t, 1> botRgt = nodesBottomRightOpenEdge();
+        xt::xtensor<size_t, 1> topLft = nodesTopLeftOpenEdge();
+        xt::xtensor<size_t, 1> topRgt = nodesTopRightOpenEdge();
+
+        size_t tface = fro.size() + lft.size() + bot.size();
+        size_t tedge = 3 * froBot.size() + 3 * froLft.size() + 3 * botLft.size();
+        size_t tnode = 7;
+        xt::xtensor<size_t, 2> ret = xt::empty<size_t>({tface + tedge + tnode, std::size_t(2)});
+
+        size_t i = 0;
+
+        ret(i, 0) = nodesFrontBottomLeftCorner();
+        ret(i, 1) = nodesFrontBottomRightCorner();
         ++i;
-    }
-    for (size_t j = 0; j < botLft.size(); ++j) {
-        ret(i, 0) = botLft(j);
-        ret(i, 1) = botRgt(j);
+        ret(i, 0) = nodesFrontBottomLeftCorner();
+        ret(i, 1) = nodesBackBottomRightCorner();
         ++i;
-    }
-    for (size_t j = 0; j < botLft.size(); ++j) {
-        ret(i, 0) = botLft(j);
-        ret(i, 1) = topRgt(j);
+        ret(i, 0) = nodesFrontBottomLeftCorner();
+        ret(i, 1) = nodesBackBottomLeftCorner();
         ++i;
-    }
-    for (size_t j = 0; j < botLft.size(); ++j) {
-        ret(i, 0) = botLft(j);
-        ret(i, 1) = topLft(j);
+        ret(i, 0) = nodesFrontBottomLeftCorner();
+        ret(i, 1) = nodesFrontTopLeftCorner();
         ++i;
-    }
-    for (size_t j = 0; j < froLft.size(); ++j) {
-        ret(i, 0) = froLft(j);
-        ret(i, 1) = froRgt(j);
+        ret(i, 0) = nodesFrontBottomLeftCorner();
+        ret(i, 1) = nodesFrontTopRightCorner();
         ++i;
-    }
-    for (size_t j = 0; j < froLft.size(); ++j) {
-        ret(i, 0) = froLft(j);
-        ret(i, 1) = bckRgt(j);
+        ret(i, 0) = nodesFrontBottomLeftCorner();
+        ret(i, 1) = nodesBackTopRightCorner();
         ++i;
-    }
-    for (size_t j = 0; j < froLft.size(); ++j) {
-        ret(i, 0) = froLft(j);
-        ret(i, 1) = bckLft(j);
+        ret(i, 0) = nodesFrontBottomLeftCorner();
+        ret(i, 1) = nodesBackTopLeftCorner();
         ++i;
+
+        for (size_t j = 0; j < froBot.size(); ++j) {
+            ret(i, 0) = froBot(j);
+            ret(i, 1) = bckBot(j);
+            ++i;
+        }
+        for (size_t j = 0; j < froBot.size(); ++j) {
+            ret(i, 0) = froBot(j);
+            ret(i, 1) = bckTop(j);
+            ++i;
+        }
+        for (size_t j = 0; j < froBot.size(); ++j) {
+            ret(i, 0) = froBot(j);
+            ret(i, 1) = froTop(j);
+            ++i;
+        }
+        for (size_t j = 0; j < botLft.size(); ++j) {
+            ret(i, 0) = botLft(j);
+            ret(i, 1) = botRgt(j);
+            ++i;
+        }
+        for (size_t j = 0; j < botLft.size(); ++j) {
+            ret(i, 0) = botLft(j);
+            ret(i, 1) = topRgt(j);
+            ++i;
+        }
+        for (size_t j = 0; j < botLft.size(); ++j) {
+            ret(i, 0) = botLft(j);
+            ret(i, 1) = topLft(j);
+            ++i;
+        }
+        for (size_t j = 0; j < froLft.size(); ++j) {
+            ret(i, 0) = froLft(j);
+            ret(i, 1) = froRgt(j);
+            ++i;
+        }
+        for (size_t j = 0; j < froLft.size(); ++j) {
+            ret(i, 0) = froLft(j);
+            ret(i, 1) = bckRgt(j);
+            ++i;
+        }
+        for (size_t j = 0; j < froLft.size(); ++j) {
+            ret(i, 0) = froLft(j);
+            ret(i, 1) = bckLft(j);
+            ++i;
+        }
+
+        for (size_t j = 0; j < fro.size(); ++j) {
+            ret(i, 0) = fro(j);
+            ret(i, 1) = bck(j);
+            ++i;
+        }
+        for (size_t j = 0; j < lft.size(); ++j) {
+            ret(i, 0) = lft(j);
+            ret(i, 1) = rgt(j);
+            ++i;
+        }
+        for (size_t j = 0; j < bot.size(); ++j) {
+            ret(i, 0) = bot(j);
+            ret(i, 1) = top(j);
+            ++i;
+        }
+
+        return ret;
+    });
+}
+
+inline size_t FineLayer::nodesOrigin() const
+{
+    return nodesFrontBottomLeftCorner();
+}
+
+inline const xt::xtensor<size_t, 2>& FineLayer::dofs() const
+{
+    return m_dofs.get([this]() {
+        return GooseFEM::Mesh::dofs(m_nnode, m_ndim);
+    });
+}
+
+inline const xt::xtensor<size_t, 2>& FineLayer::dofsPeriodic() const
+{
+    return m_dofsPeriodic.get([this]() {
+        xt::xtensor<size_t, 2> ret = GooseFEM::Mesh::dofs(m_nnode, m_ndim);
+        xt::xtensor<size_t, 2> nodePer = nodesPeriodic();
+
+        for (size_t i = 0; i < nodePer.shape(0); ++i) {
+            for (size_t j = 0; j < m_ndim; ++j) {
+                ret(nodePer(i, 1), j) = ret(nodePer(i, 0), j);
+            }
+        }
+
+        return GooseFEM::Mesh::renumber(ret);
+    });
+}
+
+namespace Map {
+
+inline RefineRegular::RefineRegular(
+    const GooseFEM::Mesh::Hex8::Regular& mesh, size_t nx, size_t ny, size_t nz)
+    : m_coarse(mesh)
+{
+    m_fine = Regular(
+        nx * m_coarse.nelx(), ny * m_coarse.nely(), nz * m_coarse.nelz(), m_coarse.h());
+
+    m_coarse2fine = xt::empty<size_t>({m_coarse.nelem(), nx * ny * nz});
+
+    #pragma omp parallel for
+    for (size_t iz = 0; iz < m_coarse.nelz(); ++iz) {
+        for (size_t iy = 0; iy < m_coarse.nely(); ++iy) {
+            for (size_t ix = 0; ix < m_coarse.nelx(); ++ix) {
+                size_t e = m_coarse.element(ix, iy, iz);
+                size_t j = 0;
+                for (size_t kz = 0; kz < nz; ++kz) {
+                    for (size_t ky = 0; ky < ny; ++ky) {
+                        for (size_t kx = 0; kx < nx; ++kx) {
+                            m_coarse2fine(e, j) =
+                                m_fine.element(ix * nx + kx, iy * ny + ky, iz * nz + kz);
+                            ++j;
+                        }
+                    }
+                }
+            }
+        }
     }
 
-    for (size_t j = 0; j < fro.size(); ++j) {
-        ret(i, 0) = fro(j);
-        ret(i, 1) = bck(j);
-        ++i;
+    // transpose
+    m_fine2coarse = xt::empty<size_t>({m_fine.nelem()});
+
+    for (size_t i = 0; i < m_coarse2fine.shape(0); ++i) {
+        for (size_t j = 0; j < m_coarse2fine.shape(1); ++j) {
+            m_fine2coarse(m_coarse2fine(i, j)) = i;
+        }
     }
-    for (size_t j = 0; j < lft.size(); ++j) {
-        ret(i, 0) = lft(j);
-        ret(i, 1) = rgt(j);
-        ++i;
+}
+
+inline GooseFEM::Mesh::Hex8::Regular RefineRegular::getCoarseMesh() const
+{
+    return m_coarse;
+}
+
+inline GooseFEM::Mesh::Hex8::Regular RefineRegular::getFineMesh() const
+{
+    return m_fine;
+}
+
+inline xt::xtensor<size_t, 2> RefineRegular::getMap() const
+{
+    return m_coarse2fine;
+}
+
+template <class T, class R>
+inline void RefineRegular::map_to_coarse(const T& data, R& ret) const
+{
+    GOOSEFEM_ASSERT(data.shape(0) == m_coarse2fine.size());
+
+    size_t m = m_coarse2fine.shape(0);
+    size_t n = m_coarse2fine.shape(1);
+    size_t stride = data.size() / data.shape(0);
+
+    GOOSEFEM_ASSERT(ret.size() == m * n * stride);
+
+    const double* in = data.data();
+    double* out = ret.data();
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            std::copy(
+                in + m_coarse2fine(i, j) * stride,
+                in + (m_coarse2fine(i, j) + 1) * stride,
+                out + (i * n + j) * stride);
+        }
     }
-    for (size_t j = 0; j < bot.size(); ++j) {
-        ret(i, 0) = bot(j);
-        ret(i, 1) = top(j);
-        ++i;
+}
+
+template <class T>
+inline void RefineRegular::map_to_fine(const T& data, T& ret) const
+{
+    GOOSEFEM_ASSERT(data.shape(0) == m_coarse2fine.shape(0));
+    GOOSEFEM_ASSERT(ret.shape(0) == m_fine2coarse.size());
+
+    size_t stride = data.size() / data.shape(0);
+    const double* in = data.data();
+    double* out = ret.data();
+
+    #pragma omp parallel for
+    for (size_t j = 0; j < m_fine2coarse.size(); ++j) {
+        std::copy(
+            in + m_fine2coarse(j) * stride, in + (m_fine2coarse(j) + 1) * stride, out + j * stride);
     }
+}
 
+inline xt::xtensor<double, 2> RefineRegular::mapToCoarse(const xt::xtensor<double, 1>& data) const
+{
+    xt::xtensor<double, 2> ret = xt::empty<double>(m_coarse2fine.shape());
+    this->map_to_coarse(data, ret);
     return ret;
 }
 
-inline size_t FineLayer::nodesOrigin() const
+inline xt::xtensor<double, 2> RefineRegular::mapToCoarse(const xt::xtensor<double, 2>& data) const
 {
-    return nodesFrontBottomLeftCorner();
+    size_t m = m_coarse2fine.shape(0);
+    size_t n = m_coarse2fine.shape(1);
+    size_t N = data.shape(1);
+
+    xt::xtensor<double, 2> ret = xt::empty<double>({m, n * N});
+    this->map_to_coarse(data, ret);
+    return ret;
 }
 
-inline xt::xtensor<size_t, 2> FineLayer::dofs() const
+inline xt::xtensor<double, 4> RefineRegular::mapToCoarse(const xt::xtensor<double, 4>& data) const
 {
-    return GooseFEM::Mesh::dofs(m_nnode, m_ndim);
+    size_t m = m_coarse2fine.shape(0);
+    size_t n = m_coarse2fine.shape(1);
+    size_t N = data.shape(1);
+
+    xt::xtensor<double, 4> ret = xt::empty<double>({m, n * N, data.shape(2), data.shape(3)});
+    this->map_to_coarse(data, ret);
+    return ret;
 }
 
-inline xt::xtensor<size_t, 2> FineLayer::dofsPeriodic() const
+inline xt::xtensor<double, 1> RefineRegular::mapToFine(const xt::xtensor<double, 1>& data) const
 {
-    xt::xtensor<size_t, 2> ret = GooseFEM::Mesh::dofs(m_nnode, m_ndim);
-    xt::xtensor<size_t, 2> nodePer = nodesPeriodic();
+    xt::xtensor<double, 1> ret = xt::empty<double>({m_coarse2fine.size()});
+    this->map_to_fine(data, ret);
+    return ret;
+}
 
-    for (size_t i = 0; i < nodePer.shape(0); ++i) {
-        for (size_t j = 0; j < m_ndim; ++j) {
-            ret(nodePer(i, 1), j) = ret(nodePer(i, 0), j);
-        }
-    }
+inline xt::xtensor<double, 2> RefineRegular::mapToFine(const xt::xtensor<double, 2>& data) const
+{
+    xt::xtensor<double, 2> ret = xt::empty<double>({m_coarse2fine.size(), data.shape(1)});
+    this->map_to_fine(data, ret);
+    return ret;
+}
 
-    return GooseFEM::Mesh::renumber(ret);
+inline xt::xtensor<double, 4> RefineRegular::mapToFine(const xt::xtensor<double, 4>& data) const
+{
+    xt::xtensor<double, 4> ret =
+        xt::empty<double>({m_coarse2fine.size(), data.shape(1), data.shape(2), data.shape(3)});
+    this->map_to_fine(data, ret);
+    return ret;
 }
 
+} // namespace Map
+
 } // namespace Hex8
 } // namespace Mesh
 } // namespace GooseFEM
@@ -38,9 +38,24 @@ public:
     // type
     ElementType getElementType() const;
 
-    // mesh
-    xt::xtensor<double, 2> coor() const; // nodal positions [nnode, ndim]
-    xt::xtensor<size_t, 2> conn() const; // connectivity [nelem, nne]
+    // free the cached "coor", "conn", "dofs", "dofsPeriodic", and "nodesPeriodic"
+    // (they are computed on first use, thread-safe, and kept to be returned by reference)
+    // note: this invalidates all references returned by these functions before
+    void clear_cache();
+
+    // mesh (cached: the references are valid until "clear_cache()")
+    const xt::xtensor<double, 2>& coor() const; // nodal positions [nnode, ndim]
+    const xt::xtensor<size_t, 2>& conn() const; // connectivity [nelem, nne]
+
+    // mesh, in blocks: "coor()[begin:end, :]" and "conn()[begin:end, :]"
+    xt::xtensor<double, 2> coor(size_t begin, size_t end) const;
+    xt::xtensor<size_t, 2> conn(size_t begin, size_t end) const;
+
+    // mesh, per item (computed on the fly, nothing is stored)
+    size_t node(size_t ix, size_t iy) const;              // node at grid-point (ix, iy)
+    size_t element(size_t ix, size_t iy) const;           // element at grid-cell (ix, iy)
+    std::array<double, 2> coor(size_t n) const;           // position of node "n"
+    std::array<size_t, 4> element_nodes(size_t e) const; // nodes of element "e"
 
     // boundary nodes: edges
     xt::xtensor<size_t, 1> nodesBottomEdge() const;
@@ -64,14 +79,14 @@ public:
     size_t nodesRightBottomCorner() const;
     size_t nodesRightTopCorner() const;
 
-    // DOF-numbers for each component of each node (sequential)
-    xt::xtensor<size_t, 2> dofs() const;
+    // DOF-numbers for each component of each node (sequential, cached: see "clear_cache()")
+    const xt::xtensor<size_t, 2>& dofs() const;
 
-    // DOF-numbers for the case that the periodicity if fully eliminated
-    xt::xtensor<size_t, 2> dofsPeriodic() const;
+    // DOF-numbers for the case that the periodicity if fully eliminated (cached)
+    const xt::xtensor<size_t, 2>& dofsPeriodic() const;
 
-    // periodic node pairs [:,2]: (independent, dependent)
-    xt::xtensor<size_t, 2> nodesPeriodic() const;
+    // periodic node pairs [:,2]: (independent, dependent) (cached)
+    const xt::xtensor<size_t, 2>& nodesPeriodic() const;
 
     // front-bottom-left node, used as reference for periodicity
     size_t nodesOrigin() const;
@@ -79,6 +94,10 @@ public:
     // element numbers as matrix
     xt::xtensor<size_t, 2> elementgrid() const;
 
+    // element coloring: 4 colors based on the parity of the element's row and column,
+    // without searching (see "GooseFEM::Mesh::Coloring")
+    Coloring coloring() const;
+
 private:
     double m_h;                     // elementary element edge-size (in all directions)
     size_t m_nelx;                  // number of elements in x-direction (length == "m_nelx * m_h")
@@ -87,6 +106,13 @@ private:
     size_t m_nnode;                 // number of nodes
     static const size_t m_nne = 4;  // number of nodes-per-element
     static const size_t m_ndim = 2; // number of dimensions
+
+    // cached output (computed on first use)
+    detail::Cached<xt::xtensor<double, 2>> m_coor;
+    detail::Cached<xt::xtensor<size_t, 2>> m_conn;
+    detail::Cached<xt::xtensor<size_t, 2>> m_dofs;
+    detail::Cached<xt::xtensor<size_t, 2>> m_dofsPeriodic;
+    detail::Cached<xt::xtensor<size_t, 2>> m_nodesPeriodic;
 };
 
 // Mesh with fine middle layer, and coarser elements towards the top and bottom
@@ -116,9 +142,19 @@ public:
     // type
     ElementType getElementType() const;
 
-    // mesh
-    xt::xtensor<double, 2> coor() const; // nodal positions [nnode, ndim]
-    xt::xtensor<size_t, 2> conn() const; // connectivity [nelem, nne]
+    // free the cached "coor", "conn", "dofs", "dofsPeriodic", and "nodesPeriodic"
+    // (they are computed on first use, thread-safe, and kept to be returned by reference)
+    // note: this invalidates all references returned by these functions before
+    void clear_cache();
+
+    // mesh (cached: the references are valid until "clear_cache()")
+    const xt::xtensor<double, 2>& coor() const; // nodal positions [nnode, ndim]
+    const xt::xtensor<size_t, 2>& conn() const; // connectivity [nelem, nne]
+
+    // mesh, in blocks: "coor()[begin:end, :]" and "conn()[begin:end, :]"
+    // (computed per layer of elements, only for the layers that overlap with the block)
+    xt::xtensor<double, 2> coor(size_t begin, size_t end) const;
+    xt::xtensor<size_t, 2> conn(size_t begin, size_t end) const;
 
     // elements in the middle (fine) layer
     xt::xtensor<size_t, 1> elementsMiddleLayer() const;
@@ -166,21 +202,28 @@ public:
     size_t nodesRightBottomCorner() const;
     size_t nodesRightTopCorner() const;
 
-    // DOF-numbers for each component of each node (sequential)
-    xt::xtensor<size_t, 2> dofs() const;
+    // DOF-numbers for each component of each node (sequential, cached: see "clear_cache()")
+    const xt::xtensor<size_t, 2>& dofs() const;
 
-    // DOF-numbers for the case that the periodicity if fully eliminated
-    xt::xtensor<size_t, 2> dofsPeriodic() const;
+    // DOF-numbers for the case that the periodicity if fully eliminated (cached)
+    const xt::xtensor<size_t, 2>& dofsPeriodic() const;
 
-    // periodic node pairs [:,2]: (independent, dependent)
-    xt::xtensor<size_t, 2> nodesPeriodic() const;
+    // periodic node pairs [:,2]: (independent, dependent) (cached)
+    const xt::xtensor<size_t, 2>& nodesPeriodic() const;
 
     // front-bottom-left node, used as reference for periodicity
     size_t nodesOrigin() const;
 
     // mapping to 'roll' periodically in the x-direction,
     // returns element mapping, such that: new_elemvar = elemvar[elem_map]
-    xt::xtensor<size_t, 1> roll(size_t n);
+    xt::xtensor<size_t, 1> roll(size_t n) const;
+
+    // idem, as permutation that applies in place to (several) arrays "[nelem, ...]", e.g.
+    //   auto perm = mesh.rollElem(n); perm.apply(elemvar, qpvar);
+    Permutation rollElem(size_t n) const;
+
+    // idem, for nodal quantities "[nnode, ...]" (see "GooseFEM::Mesh::elemmap2nodemap")
+    Permutation rollNode(size_t n) const;
 
 private:
     double m_h;                         // elementary element edge-size (in all directions)
@@ -199,6 +242,21 @@ private:
     // (*) per element layer in "y"
     // (**) per node layer in "y"
 
+    // cached output (computed on first use)
+    detail::Cached<xt::xtensor<double, 2>> m_coor;
+    detail::Cached<xt::xtensor<size_t, 2>> m_conn;
+    detail::Cached<xt::xtensor<size_t, 2>> m_dofs;
+    detail::Cached<xt::xtensor<size_t, 2>> m_dofsPeriodic;
+    detail::Cached<xt::xtensor<size_t, 2>> m_nodesPeriodic;
+
+    // write the nodes of node layer "iy" (the main node layer and the intermediate nodes of the
+    // element layer "iy" above it) to "ret", with row "i" corresponding to node "offset + i"
+    void coor_layer(size_t iy, size_t offset, xt::xtensor<double, 2>& ret) const;
+
+    // write the elements of element layer "iy" to "ret", with row "i" corresponding to element
+    // "offset + i"
+    void conn_layer(size_t iy, size_t offset, xt::xtensor<size_t, 2>& ret) const;
+
     void init(size_t nelx, size_t nely, double h, size_t nfine = 1);
     void map(const xt::xtensor<double, 2>& coor, const xt::xtensor<size_t, 2>& conn);
 
@@ -241,12 +299,23 @@ namespace Map {
         xt::xtensor<double, 2> mapToFine(const xt::xtensor<double, 2>& data) const; // scalar per intpnt
         xt::xtensor<double, 4> mapToFine(const xt::xtensor<double, 4>& data) const; // tensor per intpnt
 
+    private:
+        // gather the rows "data[coarse2fine[i, :], ...]" of each coarse element "i" (in parallel)
+        template <class T, class R>
+        void map_to_coarse(const T& data, R& ret) const;
+
+        // gather the rows "data[fine2coarse[j], ...]" of each fine element "j" (in parallel)
+        template <class T>
+        void map_to_fine(const T& data, T& ret) const;
+
     private:
         // the meshes
         GooseFEM::Mesh::Quad4::Regular m_coarse;
         GooseFEM::Mesh::Quad4::Regular m_fine;
 
-        // mapping
+        // mapping: the fine elements per coarse element (a CSR-map with a constant number of
+        // entries per row), and its transpose (the coarse element of each fine element, and
+        // the index of the fine element in the coarse element's row)
         xt::xtensor<size_t, 1> m_fine2coarse;
         xt::xtensor<size_t, 1> m_fine2coarse_index;
         xt::xtensor<size_t, 2> m_coarse2fine;
@@ -272,6 +341,12 @@ namespace Map {
         xt::xtensor<double, 2> mapToRegular(const xt::xtensor<double, 2>& data) const; // scalar per intpnt
         xt::xtensor<double, 4> mapToRegular(const xt::xtensor<double, 4>& data) const; // tensor per intpnt
 
+    private:
+        // weighted sum of the rows of "data" over the FineLayer elements overlapping with each
+        // Regular element, using the transposed map (in parallel)
+        template <class T>
+        T map_to_regular(const T& data) const;
+
     private:
         // the "FineLayer" mesh to map
         GooseFEM::Mesh::Quad4::FineLayer m_finelayer;
@@ -279,9 +354,18 @@ namespace Map {
         // the new "Regular" mesh to which to map
         GooseFEM::Mesh::Quad4::Regular m_regular;
 
-        // mapping
-        std::vector<std::vector<size_t>> m_elem_regular;
-        std::vector<std::vector<double>> m_frac_regular;
+        // mapping, in compressed (CSR) storage: the elements of the Regular mesh overlapping
+        // with FineLayer element "e" are "m_elem_regular[m_offsets_regular(e): ...(e + 1)]",
+        // with overlap fractions "m_frac_regular[...]"
+        xt::xtensor<size_t, 1> m_offsets_regular;
+        xt::xtensor<size_t, 1> m_elem_regular;
+        xt::xtensor<double, 1> m_frac_regular;
+
+        // transposed mapping: the elements of the FineLayer mesh overlapping with Regular
+        // element "e" are "m_elem_finelayer[m_offsets_finelayer(e): ...(e + 1)]" (sorted)
+        xt::xtensor<size_t, 1> m_offsets_finelayer;
+        xt::xtensor<size_t, 1> m_elem_finelayer;
+        xt::xtensor<double, 1> m_frac_finelayer;
     };
 
 } // namespace Map
@@ -62,42 +62,97 @@ inline ElementType Regular::getElementType() const
     return ElementType::Quad4;
 }
 
-inline xt::xtensor<double, 2> Regular::coor() const
+inline void Regular::clear_cache()
 {
-    xt::xtensor<double, 2> ret = xt::empty<double>({m_nnode, m_ndim});
+    m_coor.clear();
+    m_conn.clear();
+    m_dofs.clear();
+    m_dofsPeriodic.clear();
+    m_nodesPeriodic.clear();
+}
 
-    xt::xtensor<double, 1> x =
-        xt::linspace<double>(0.0, m_h * static_cast<double>(m_nelx), m_nelx + 1);
-    xt::xtensor<double, 1> y =
-        xt::linspace<double>(0.0, m_h * static_cast<double>(m_nely), m_nely + 1);
+inline const xt::xtensor<double, 2>& Regular::coor() const
+{
+    // computed node-by-node, such that it is identical to "coor(n)" and "coor(begin, end)"
+    return m_coor.get([this]() { return this->coor(0, m_nnode); });
+}
 
-    size_t inode = 0;
+inline const xt::xtensor<size_t, 2>& Regular::conn() const
+{
+    return m_conn.get([this]() {
+        xt::xtensor<size_t, 2> ret = xt::empty<size_t>({m_nelem, m_nne});
 
-    for (size_t iy = 0; iy < m_nely + 1; ++iy) {
-        for (size_t ix = 0; ix < m_nelx + 1; ++ix) {
-            ret(inode, 0) = x(ix);
-            ret(inode, 1) = y(iy);
-            ++inode;
+        size_t ielem = 0;
+
+        for (size_t iy = 0; iy < m_nely; ++iy) {
+            for (size_t ix = 0; ix < m_nelx; ++ix) {
+                ret(ielem, 0) = (iy) * (m_nelx + 1) + (ix);
+                ret(ielem, 1) = (iy) * (m_nelx + 1) + (ix + 1);
+                ret(ielem, 3) = (iy + 1) * (m_nelx + 1) + (ix);
+                ret(ielem, 2) = (iy + 1) * (m_nelx + 1) + (ix + 1);
+                ++ielem;
+            }
         }
+
+        return ret;
+    });
+}
+
+inline size_t Regular::node(size_t ix, size_t iy) const
+{
+    GOOSEFEM_ASSERT(ix <= m_nelx);
+    GOOSEFEM_ASSERT(iy <= m_nely);
+    return iy * (m_nelx + 1) + ix;
+}
+
+inline size_t Regular::element(size_t ix, size_t iy) const
+{
+    GOOSEFEM_ASSERT(ix < m_nelx);
+    GOOSEFEM_ASSERT(iy < m_nely);
+    return iy * m_nelx + ix;
+}
+
+inline std::array<double, 2> Regular::coor(size_t n) const
+{
+    GOOSEFEM_ASSERT(n < m_nnode);
+    size_t ix = n % (m_nelx + 1);
+    size_t iy = n / (m_nelx + 1);
+    return {m_h * static_cast<double>(ix), m_h * static_cast<double>(iy)};
+}
+
+inline std::array<size_t, 4> Regular::element_nodes(size_t e) const
+{
+    GOOSEFEM_ASSERT(e < m_nelem);
+    size_t ix = e % m_nelx;
+    size_t iy = e / m_nelx;
+    return {node(ix, iy), node(ix + 1, iy), node(ix + 1, iy + 1), node(ix, iy + 1)};
+}
+
+inline xt::xtensor<double, 2> Regular::coor(size_t begin, size_t end) const
+{
+    GOOSEFEM_ASSERT(begin <= end && end <= m_nnode);
+
+    xt::xtensor<double, 2> ret = xt::empty<double>({end - begin, m_ndim});
+
+    #pragma omp parallel for
+    for (size_t n = begin; n < end; ++n) {
+        auto x = this->coor(n);
+        std::copy(x.begin(), x.end(), &ret(n - begin, 0));
     }
 
     return ret;
 }
 
-inline xt::xtensor<size_t, 2> Regular::conn() const
+inline xt::xtensor<size_t, 2> Regular::conn(size_t begin, size_t end) const
 {
-    xt::xtensor<size_t, 2> ret = xt::empty<size_t>({m_nelem, m_nne});
+    GOOSEFEM_ASSERT(begin <= end && end <= m_nelem);
 
-    size_t ielem = 0;
+    xt::xtensor<size_t, 2> ret = xt::empty<size_t>({end - begin, m_nne});
 
-    for (size_t iy = 0; iy < m_nely; ++iy) {
-        for (size_t ix = 0; ix < m_nelx; ++ix) {
-            ret(ielem, 0) = (iy) * (m_nelx + 1) + (ix);
-            ret(ielem, 1) = (iy) * (m_nelx + 1) + (ix + 1);
-            ret(ielem, 3) = (iy + 1) * (m_nelx + 1) + (ix);
-            ret(ielem, 2) = (iy + 1) * (m_nelx + 1) + (ix + 1);
-            ++ielem;
-        }
+    #pragma omp parallel for
+    for (size_t e = begin; e < end; ++e) {
+        auto nodes = this->element_nodes(e);
+        std::copy(nodes.begin(), nodes.end(), &ret(e - begin, 0));
     }
 
     return ret;
@@ -183,35 +238,37 @@ inline size_t Regular::nodesRightTopCorner() const
     return nodesTopRightCorner();
 }
 
-inline xt::xtensor<size_t, 2> Regular::nodesPeriodic() const
+inline const xt::xtensor<size_t, 2>& Regular::nodesPeriodic() const
 {
-    xt::xtensor<size_t, 1> bot = nodesBottomOpenEdge();
-    xt::xtensor<size_t, 1> top = nodesTopOpenEdge();
-    xt::xtensor<size_t, 1> lft = nodesLeftOpenEdge();
-    xt::xtensor<size_t, 1> rgt = nodesRightOpenEdge();
-    std::array<size_t, 2> shape = {bot.size() + lft.size() + 3ul, 2ul};
-    xt::xtensor<size_t, 2> ret = xt::empty<size_t>(shape);
+    return m_nodesPeriodic.get([this]() {
+        xt::xtensor<size_t, 1> bot = nodesBottomOpenEdge();
+        xt::xtensor<size_t, 1> top = nodesTopOpenEdge();
+        xt::xtensor<size_t, 1> lft = nodesLeftOpenEdge();
+        xt::xtensor<size_t, 1> rgt = nodesRightOpenEdge();
+        std::array<size_t, 2> shape = {bot.size() + lft.size() + 3ul, 2ul};
+        xt::xtensor<size_t, 2> ret = xt::empty<size_t>(shape);
 
-    ret(0, 0) = nodesBottomLeftCorner();
-    ret(0, 1) = nodesBottomRightCorner();
+        ret(0, 0) = nodesBottomLeftCorner();
+        ret(0, 1) = nodesBottomRightCorner();
 
-    ret(1, 0) = nodesBottomLeftCorner();
-    ret(1, 1) = nodesTopRightCorner();
+        ret(1, 0) = nodesBottomLeftCorner();
+        ret(1, 1) = nodesTopRightCorner();
 
-    ret(2, 0) = nodesBottomLeftCorner();
-    ret(2, 1) = nodesTopLeftCorner();
+        ret(2, 0) = nodesBottomLeftCorner();
+        ret(2, 1) = nodesTopLeftCorner();
 
-    size_t i = 3;
+        size_t i = 3;
 
-    xt::view(ret, xt::range(i, i + bot.size()), 0) = bot;
-    xt::view(ret, xt::range(i, i + bot.size()), 1) = top;
+        xt::view(ret, xt::range(i, i + bot.size()), 0) = bot;
+        xt::view(ret, xt::range(i, i + bot.size()), 1) = top;
 
-    i += bot.size();
+        i += bot.size();
 
-    xt::view(ret, xt::range(i, i + lft.size()), 0) = lft;
-    xt::view(ret, xt::range(i, i + lft.size()), 1) = rgt;
+        xt::view(ret, xt::range(i, i + lft.size()), 0) = lft;
+        xt::view(ret, xt::range(i, i + lft.size()), 1) = rgt;
 
-    return ret;
+        return ret;
+    });
 }
 
 inline size_t Regular::nodesOrigin() const
@@ -219,23 +276,27 @@ inline size_t Regular::nodesOrigin() const
     return nodesBottomLeftCorner();
 }
 
-inline xt::xtensor<size_t, 2> Regular::dofs() const
+inline const xt::xtensor<size_t, 2>& Regular::dofs() const
 {
-    return GooseFEM::Mesh::dofs(m_nnode, m_ndim);
+    return m_dofs.get([this]() {
+        return GooseFEM::Mesh::dofs(m_nnode, m_ndim);
+    });
 }
 
-inline xt::xtensor<size_t, 2> Regular::dofsPeriodic() const
+inline const xt::xtensor<size_t, 2>& Regular::dofsPeriodic() const
 {
-    xt::xtensor<size_t, 2> ret = GooseFEM::Mesh::dofs(m_nnode, m_ndim);
-    xt::xtensor<size_t, 2> nodePer = nodesPeriodic();
-    xt::xtensor<size_t, 1> independent = xt::view(nodePer, xt::all(), 0);
-    xt::xtensor<size_t, 1> dependent = xt::view(nodePer, xt::all(), 1);
+    return m_dofsPeriodic.get([this]() {
+        xt::xtensor<size_t, 2> ret = GooseFEM::Mesh::dofs(m_nnode, m_ndim);
+        xt::xtensor<size_t, 2> nodePer = nodesPeriodic();
+        xt::xtensor<size_t, 1> independent = xt::view(nodePer, xt::all(), 0);
+        xt::xtensor<size_t, 1> dependent = xt::view(nodePer, xt::all(), 1);
 
-    for (size_t j = 0; j < m_ndim; ++j) {
-        xt::view(ret, xt::keep(dependent), j) = xt::view(ret, xt::keep(independent), j);
-    }
+        for (size_t j = 0; j < m_ndim; ++j) {
+            xt::view(ret, xt::keep(dependent), j) = xt::view(ret, xt::keep(independent), j);
+        }
 
-    return GooseFEM::Mesh::renumber(ret);
+        return GooseFEM::Mesh::renumber(ret);
+    });
 }
 
 inline xt::xtensor<size_t, 2> Regular::elementgrid() const
@@ -243,6 +304,19 @@ inline xt::xtensor<size_t, 2> Regular::elementgrid() const
     return xt::arange<size_t>(m_nelem).reshape({m_nely, m_nelx});
 }
 
+inline Coloring Regular::coloring() const
+{
+    xt::xtensor<size_t, 1> ret = xt::empty<size_t>({m_nelem});
+
+    for (size_t iy = 0; iy < m_nely; ++iy) {
+        for (size_t ix = 0; ix < m_nelx; ++ix) {
+            ret(iy * m_nelx + ix) = (ix % 2) + 2 * (iy % 2);
+        }
+    }
+
+    return Coloring(ret);
+}
+
 inline FineLayer::FineLayer(size_t nelx, size_t nely, double h, size_t nfine)
 {
     this->init(nelx, nely, h, nfine);
@@ -479,181 +553,234 @@ inline ElementType FineLayer::getElementType() const
     return ElementType::Quad4;
 }
 
-inline xt::xtensor<double, 2> FineLayer::coor() const
+inline void FineLayer::clear_cache()
 {
-    // allocate output
-    xt::xtensor<double, 2> ret = xt::empty<double>({m_nnode, m_ndim});
+    m_coor.clear();
+    m_conn.clear();
+    m_dofs.clear();
+    m_dofsPeriodic.clear();
+    m_nodesPeriodic.clear();
+}
 
-    // current node, number of element layers
-    size_t inode = 0;
+inline const xt::xtensor<double, 2>& FineLayer::coor() const
+{
+    return m_coor.get([this]() {
+        // allocate output
+        xt::xtensor<double, 2> ret = xt::empty<double>({m_nnode, m_ndim});
+
+        // number of element layers
+        size_t nely = static_cast<size_t>(m_nhy.size());
+
+        // fill all node layers (independent, each writes to its own rows)
+        #pragma omp parallel for
+        for (size_t iy = 0; iy < nely + 1; ++iy) {
+            this->coor_layer(iy, 0, ret);
+        }
+
+        return ret;
+    });
+}
+
+inline xt::xtensor<double, 2> FineLayer::coor(size_t begin, size_t end) const
+{
+    GOOSEFEM_ASSERT(begin <= end && end <= m_nnode);
+
+    xt::xtensor<double, 2> ret = xt::empty<double>({end - begin, m_ndim});
     size_t nely = static_cast<size_t>(m_nhy.size());
 
-    // y-position of each main node layer (i.e. excluding node layers for refinement/coarsening)
-    // - allocate
-    xt::xtensor<double, 1> y = xt::empty<double>({nely + 1});
-    // - initialize
-    y(0) = 0.0;
-    // - compute
-    for (size_t iy = 1; iy < nely + 1; ++iy) {
-        y(iy) = y(iy - 1) + m_nhy(iy - 1) * m_h;
+    for (size_t iy = 0; iy < nely + 1; ++iy) {
+        size_t start = m_startNode(iy);
+        size_t stop = iy < nely ? m_startNode(iy + 1) : m_nnode;
+        if (stop <= begin || start >= end) {
+            continue;
+        }
+        if (start >= begin && stop <= end) {
+            this->coor_layer(iy, begin, ret);
+            continue;
+        }
+        xt::xtensor<double, 2> layer = xt::empty<double>({stop - start, m_ndim});
+        this->coor_layer(iy, start, layer);
+        size_t i = std::max(start, begin);
+        size_t j = std::min(stop, end);
+        xt::view(ret, xt::range(i - begin, j - begin), xt::all()) =
+            xt::view(layer, xt::range(i - start, j - start), xt::all());
     }
 
-    // loop over element layers (bottom -> middle) : add bottom layer (+ refinement layer) of nodes
+    return ret;
+}
 
-    for (size_t iy = 0;; ++iy) {
-        // get positions along the x- and z-axis
-        xt::xtensor<double, 1> x = xt::linspace<double>(0.0, m_Lx, m_nelx(iy) + 1);
+inline void FineLayer::coor_layer(size_t iy, size_t offset, xt::xtensor<double, 2>& ret) const
+{
+    // current node, number of element layers
+    size_t inode = m_startNode(iy) - offset;
+    size_t nely = static_cast<size_t>(m_nhy.size());
 
-        // add nodes of the bottom layer of this element
-        for (size_t ix = 0; ix < m_nelx(iy) + 1; ++ix) {
-            ret(inode, 0) = x(ix);
-            ret(inode, 1) = y(iy);
-            ++inode;
-        }
+    // y-position of the main node layer (i.e. excluding node layers for refinement/coarsening)
+    double y = 0.0;
+    for (size_t i = 0; i < iy; ++i) {
+        y = y + m_nhy(i) * m_h;
+    }
 
-        // stop at middle layer
-        if (iy == (nely - 1) / 2) {
-            break;
-        }
+    // add nodes of the main node layer: its number of elements is that of the element layer
+    // on the side of the middle layer
+    size_t nelx = iy <= (nely - 1) / 2 ? m_nelx(iy) : m_nelx(iy - 1);
+    xt::xtensor<double, 1> x = xt::linspace<double>(0.0, m_Lx, nelx + 1);
 
-        // add extra nodes of the intermediate layer, for refinement in x-direction
-        if (m_refine(iy) == 0) {
-            // - get position offset in x- and y-direction
-            double dx = m_h * static_cast<double>(m_nhx(iy) / 3);
-            double dy = m_h * static_cast<double>(m_nhy(iy) / 2);
-            // - add nodes of the intermediate layer
-            for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
-                for (size_t j = 0; j < 2; ++j) {
-                    ret(inode, 0) = x(ix) + dx * static_cast<double>(j + 1);
-                    ret(inode, 1) = y(iy) + dy;
-                    ++inode;
-                }
-            }
-        }
+    for (size_t ix = 0; ix < nelx + 1; ++ix) {
+        ret(inode, 0) = x(ix);
+        ret(inode, 1) = y;
+        ++inode;
     }
 
-    // loop over element layers (middle -> top) : add (refinement layer +) top layer of nodes
+    // top node layer: no element layer above
+    if (iy == nely) {
+        return;
+    }
 
-    for (size_t iy = (nely - 1) / 2; iy < nely; ++iy) {
-        // get positions along the x- and z-axis
-        xt::xtensor<double, 1> x = xt::linspace<double>(0.0, m_Lx, m_nelx(iy) + 1);
-
-        // add extra nodes of the intermediate layer, for refinement in x-direction
-        if (m_refine(iy) == 0) {
-            // - get position offset in x- and y-direction
-            double dx = m_h * static_cast<double>(m_nhx(iy) / 3);
-            double dy = m_h * static_cast<double>(m_nhy(iy) / 2);
-            // - add nodes of the intermediate layer
-            for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
-                for (size_t j = 0; j < 2; ++j) {
-                    ret(inode, 0) = x(ix) + dx * static_cast<double>(j + 1);
-                    ret(inode, 1) = y(iy) + dy;
-                    ++inode;
-                }
+    // add extra nodes of the intermediate layer, for refinement in x-direction
+    if (m_refine(iy) == 0) {
+        // - get positions along the x-axis
+        x = xt::linspace<double>(0.0, m_Lx, m_nelx(iy) + 1);
+        // - get position offset in x- and y-direction
+        double dx = m_h * static_cast<double>(m_nhx(iy) / 3);
+        double dy = m_h * static_cast<double>(m_nhy(iy) / 2);
+        // - add nodes of the intermediate layer
+        for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
+            for (size_t j = 0; j < 2; ++j) {
+                ret(inode, 0) = x(ix) + dx * static_cast<double>(j + 1);
+                ret(inode, 1) = y + dy;
+                ++inode;
             }
         }
+    }
+}
+
+inline const xt::xtensor<size_t, 2>& FineLayer::conn() const
+{
+    return m_conn.get([this]() {
+        // allocate output
+        xt::xtensor<size_t, 2> ret = xt::empty<size_t>({m_nelem, m_nne});
+
+        // number of element layers
+        size_t nely = static_cast<size_t>(m_nhy.size());
 
-        // add nodes of the top layer of this element
-        for (size_t ix = 0; ix < m_nelx(iy) + 1; ++ix) {
-            ret(inode, 0) = x(ix);
-            ret(inode, 1) = y(iy + 1);
-            ++inode;
+        // fill all element layers (independent, each writes to its own rows)
+        #pragma omp parallel for
+        for (size_t iy = 0; iy < nely; ++iy) {
+            this->conn_layer(iy, 0, ret);
         }
-    }
 
-    return ret;
+        return ret;
+    });
 }
 
-inline xt::xtensor<size_t, 2> FineLayer::conn() const
+inline xt::xtensor<size_t, 2> FineLayer::conn(size_t begin, size_t end) const
 {
-    // allocate output
-    xt::xtensor<size_t, 2> ret = xt::empty<size_t>({m_nelem, m_nne});
+    GOOSEFEM_ASSERT(begin <= end && end <= m_nelem);
 
-    // current element, number of element layers, starting nodes of each node layer
-    size_t ielem = 0;
+    xt::xtensor<size_t, 2> ret = xt::empty<size_t>({end - begin, m_nne});
     size_t nely = static_cast<size_t>(m_nhy.size());
-    size_t bot, mid, top;
 
-    // loop over all element layers
     for (size_t iy = 0; iy < nely; ++iy) {
-        // - get: starting nodes of bottom(, middle) and top layer
-        bot = m_startNode(iy);
-        mid = m_startNode(iy) + m_nnd(iy);
-        top = m_startNode(iy + 1);
-
-        // - define connectivity: no coarsening/refinement
-        if (m_refine(iy) == -1) {
-            for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
-                ret(ielem, 0) = bot + (ix);
-                ret(ielem, 1) = bot + (ix + 1);
-                ret(ielem, 2) = top + (ix + 1);
-                ret(ielem, 3) = top + (ix);
-                ielem++;
-            }
+        size_t start = m_startElem(iy);
+        size_t stop = iy + 1 < nely ? m_startElem(iy + 1) : m_nelem;
+        if (stop <= begin || start >= end) {
+            continue;
+        }
+        if (start >= begin && stop <= end) {
+            this->conn_layer(iy, begin, ret);
+            continue;
         }
+        xt::xtensor<size_t, 2> layer = xt::empty<size_t>({stop - start, m_nne});
+        this->conn_layer(iy, start, layer);
+        size_t i = std::max(start, begin);
+        size_t j = std::min(stop, end);
+        xt::view(ret, xt::range(i - begin, j - begin), xt::all()) =
+            xt::view(layer, xt::range(i - start, j - start), xt::all());
+    }
 
-        // - define connectivity: refinement along the x-direction (below the middle layer)
-        else if (m_refine(iy) == 0 && iy <= (nely - 1) / 2) {
-            for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
-                // -- bottom element
-                ret(ielem, 0) = bot + (ix);
-                ret(ielem, 1) = bot + (ix + 1);
-                ret(ielem, 2) = mid + (2 * ix + 1);
-                ret(ielem, 3) = mid + (2 * ix);
-                ielem++;
-                // -- top-right element
-                ret(ielem, 0) = bot + (ix + 1);
-                ret(ielem, 1) = top + (3 * ix + 3);
-                ret(ielem, 2) = top + (3 * ix + 2);
-                ret(ielem, 3) = mid + (2 * ix + 1);
-                ielem++;
-                // -- top-center element
-                ret(ielem, 0) = mid + (2 * ix);
-                ret(ielem, 1) = mid + (2 * ix + 1);
-                ret(ielem, 2) = top + (3 * ix + 2);
-                ret(ielem, 3) = top + (3 * ix + 1);
-                ielem++;
-                // -- top-left element
-                ret(ielem, 0) = bot + (ix);
-                ret(ielem, 1) = mid + (2 * ix);
-                ret(ielem, 2) = top + (3 * ix + 1);
-                ret(ielem, 3) = top + (3 * ix);
-                ielem++;
-            }
+    return ret;
+}
+
+inline void FineLayer::conn_layer(size_t iy, size_t offset, xt::xtensor<size_t, 2>& ret) const
+{
+    // current element, number of element layers, starting nodes of each node layer
+    size_t ielem = m_startElem(iy) - offset;
+    size_t nely = static_cast<size_t>(m_nhy.size());
+    size_t bot = m_startNode(iy);
+    size_t mid = m_startNode(iy) + m_nnd(iy);
+    size_t top = m_startNode(iy + 1);
+
+    // - define connectivity: no coarsening/refinement
+    if (m_refine(iy) == -1) {
+        for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
+            ret(ielem, 0) = bot + (ix);
+            ret(ielem, 1) = bot + (ix + 1);
+            ret(ielem, 2) = top + (ix + 1);
+            ret(ielem, 3) = top + (ix);
+            ielem++;
         }
+    }
 
-        // - define connectivity: coarsening along the x-direction (above the middle layer)
-        else if (m_refine(iy) == 0 && iy > (nely - 1) / 2) {
-            for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
-                // -- lower-left element
-                ret(ielem, 0) = bot + (3 * ix);
-                ret(ielem, 1) = bot + (3 * ix + 1);
-                ret(ielem, 2) = mid + (2 * ix);
-                ret(ielem, 3) = top + (ix);
-                ielem++;
-                // -- lower-center element
-                ret(ielem, 0) = bot + (3 * ix + 1);
-                ret(ielem, 1) = bot + (3 * ix + 2);
-                ret(ielem, 2) = mid + (2 * ix + 1);
-                ret(ielem, 3) = mid + (2 * ix);
-                ielem++;
-                // -- lower-right element
-                ret(ielem, 0) = bot + (3 * ix + 2);
-                ret(ielem, 1) = bot + (3 * ix + 3);
-                ret(ielem, 2) = top + (ix + 1);
-                ret(ielem, 3) = mid + (2 * ix + 1);
-                ielem++;
-                // -- upper element
-                ret(ielem, 0) = mid + (2 * ix);
-                ret(ielem, 1) = mid + (2 * ix + 1);
-                ret(ielem, 2) = top + (ix + 1);
-                ret(ielem, 3) = top + (ix);
-                ielem++;
-            }
+    // - define connectivity: refinement along the x-direction (below the middle layer)
+    else if (m_refine(iy) == 0 && iy <= (nely - 1) / 2) {
+        for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
+            // -- bottom element
+            ret(ielem, 0) = bot + (ix);
+            ret(ielem, 1) = bot + (ix + 1);
+            ret(ielem, 2) = mid + (2 * ix + 1);
+            ret(ielem, 3) = mid + (2 * ix);
+            ielem++;
+            // -- top-right element
+            ret(ielem, 0) = bot + (ix + 1);
+            ret(ielem, 1) = top + (3 * ix + 3);
+            ret(ielem, 2) = top + (3 * ix + 2);
+            ret(ielem, 3) = mid + (2 * ix + 1);
+            ielem++;
+            // -- top-center element
+            ret(ielem, 0) = mid + (2 * ix);
+            ret(ielem, 1) = mid + (2 * ix + 1);
+            ret(ielem, 2) = top + (3 * ix + 2);
+            ret(ielem, 3) = top + (3 * ix + 1);
+            ielem++;
+            // -- top-left element
+            ret(ielem, 0) = bot + (ix);
+            ret(ielem, 1) = mid + (2 * ix);
+            ret(ielem, 2) = top + (3 * ix + 1);
+            ret(ielem, 3) = top + (3 * ix);
+            ielem++;
         }
     }
 
-    return ret;
+    // - define connectivity: coarsening along the x-direction (above the middle layer)
+    else if (m_refine(iy) == 0 && iy > (nely - 1) / 2) {
+        for (size_t ix = 0; ix < m_nelx(iy); ++ix) {
+            // -- lower-left element
+            ret(ielem, 0) = bot + (3 * ix);
+            ret(ielem, 1) = bot + (3 * ix + 1);
+            ret(ielem, 2) = mid + (2 * ix);
+            ret(ielem, 3) = top + (ix);
+            ielem++;
+            // -- lower-center element
+            ret(ielem, 0) = bot + (3 * ix + 1);
+            ret(ielem, 1) = bot + (3 * ix + 2);
+            ret(ielem, 2) = mid + (2 * ix + 1);
+            ret(ielem, 3) = mid + (2 * ix);
+            ielem++;
+            // -- lower-right element
+            ret(ielem, 0) = bot + (3 * ix + 2);
+            ret(ielem, 1) = bot + (3 * ix + 3);
+            ret(ielem, 2) = top + (ix + 1);
+            ret(ielem, 3) = mid + (2 * ix + 1);
+            ielem++;
+            // -- upper element
+            ret(ielem, 0) = mid + (2 * ix);
+            ret(ielem, 1) = mid + (2 * ix + 1);
+            ret(ielem, 2) = top + (ix + 1);
+            ret(ielem, 3) = top + (ix);
+            ielem++;
+        }
+    }
 }
 
 inline xt::xtensor<size_t, 1> FineLayer::elementsMiddleLayer() const
@@ -1017,35 +1144,37 @@ inline size_t FineLayer::nodesRightTopCorner() const
     return nodesTopRightCorner();
 }
 
-inline xt::xtensor<size_t, 2> FineLayer::nodesPeriodic() const
+inline const xt::xtensor<size_t, 2>& FineLayer::nodesPeriodic() const
 {
-    xt::xtensor<size_t, 1> bot = nodesBottomOpenEdge();
-    xt::xtensor<size_t, 1> top = nodesTopOpenEdge();
-    xt::xtensor<size_t, 1> lft = nodesLeftOpenEdge();
-    xt::xtensor<size_t, 1> rgt = nodesRightOpenEdge();
-    std::array<size_t, 2> shape = {bot.size() + lft.size() + 3ul, 2ul};
-    xt::xtensor<size_t, 2> ret = xt::empty<size_t>(shape);
+    return m_nodesPeriodic.get([this]() {
+        xt::xtensor<size_t, 1> bot = nodesBottomOpenEdge();
+        xt::xtensor<size_t, 1> top = nodesTopOpenEdge();
+        xt::xtensor<size_t, 1> lft = nodesLeftOpenEdge();
+        xt::xtensor<size_t, 1> rgt = nodesRightOpenEdge();
+        std::array<size_t, 2> shape = {bot.size() + lft.size() + 3ul, 2ul};
+        xt::xtensor<size_t, 2> ret = xt::empty<size_t>(shape);
 
-    ret(0, 0) = nodesBottomLeftCorner();
-    ret(0, 1) = nodesBottomRightCorner();
+        ret(0, 0) = nodesBottomLeftCorner();
+        ret(0, 1) = nodesBottomRightCorner();
 
-    ret(1, 0) = nodesBottomLeftCorner();
-    ret(1, 1) = nodesTopRightCorner();
+        ret(1, 0) = nodesBottomLeftCorner();
+        ret(1, 1) = nodesTopRightCorner();
 
-    ret(2, 0) = nodesBottomLeftCorner();
-    ret(2, 1) = nodesTopLeftCorner();
+        ret(2, 0) = nodesBottomLeftCorner();
+        ret(2, 1) = nodesTopLeftCorner();
 
-    size_t i = 3;
+        size_t i = 3;
 
-    xt::view(ret, xt::range(i, i + bot.size()), 0) = bot;
-    xt::view(ret, xt::range(i, i + bot.size()), 1) = top;
+        xt::view(ret, xt::range(i, i + bot.size()), 0) = bot;
+        xt::view(ret, xt::range(i, i + bot.size()), 1) = top;
 
-    i += bot.size();
+        i += bot.size();
 
-    xt::view(ret, xt::range(i, i + lft.size()), 0) = lft;
-    xt::view(ret, xt::range(i, i + lft.size()), 1) = rgt;
+        xt::view(ret, xt::range(i, i + lft.size()), 0) = lft;
+        xt::view(ret, xt::range(i, i + lft.size()), 1) = rgt;
 
-    return ret;
+        return ret;
+    });
 }
 
 inline size_t FineLayer::nodesOrigin() const
@@ -1053,28 +1182,31 @@ inline size_t FineLayer::nodesOrigin() const
     return nodesBottomLeftCorner();
 }
 
-inline xt::xtensor<size_t, 2> FineLayer::dofs() const
+inline const xt::xtensor<size_t, 2>& FineLayer::dofs() const
 {
-    return GooseFEM::Mesh::dofs(m_nnode, m_ndim);
+    return m_dofs.get([this]() {
+        return GooseFEM::Mesh::dofs(m_nnode, m_ndim);
+    });
 }
 
-inline xt::xtensor<size_t, 2> FineLayer::dofsPeriodic() const
+inline const xt::xtensor<size_t, 2>& FineLayer::dofsPeriodic() const
 {
-    xt::xtensor<size_t, 2> ret = GooseFEM::Mesh::dofs(m_nnode, m_ndim);
-    xt::xtensor<size_t, 2> nodePer = nodesPeriodic();
-    xt::xtensor<size_t, 1> independent = xt::view(nodePer, xt::all(), 0);
-    xt::xtensor<size_t, 1> dependent = xt::view(nodePer, xt::all(), 1);
+    return m_dofsPeriodic.get([this]() {
+        xt::xtensor<size_t, 2> ret = GooseFEM::Mesh::dofs(m_nnode, m_ndim);
+        xt::xtensor<size_t, 2> nodePer = nodesPeriodic();
+        xt::xtensor<size_t, 1> independent = xt::view(nodePer, xt::all(), 0);
+        xt::xtensor<size_t, 1> dependent = xt::view(nodePer, xt::all(), 1);
 
-    for (size_t j = 0; j < m_ndim; ++j) {
-        xt::view(ret, xt::keep(dependent), j) = xt::view(ret, xt::keep(independent), j);
-    }
+        for (size_t j = 0; j < m_ndim; ++j) {
+            xt::view(ret, xt::keep(dependent), j) = xt::view(ret, xt::keep(independent), j);
+        }
 
-    return GooseFEM::Mesh::renumber(ret);
+        return GooseFEM::Mesh::renumber(ret);
+    });
 }
 
-inline xt::xtensor<size_t, 1> FineLayer::roll(size_t n)
+inline xt::xtensor<size_t, 1> FineLayer::roll(size_t n) const
 {
-    auto conn = this->conn();
     size_t nely = static_cast<size_t>(m_nhy.size());
     xt::xtensor<size_t, 1> ret = xt::empty<size_t>({m_nelem});
 
@@ -1099,6 +1231,17 @@ inline xt::xtensor<size_t, 1> FineLayer::roll(size_t n)
     return ret;
 }
 
+inline Permutation FineLayer::rollElem(size_t n) const
+{
+    return Permutation(this->roll(n));
+}
+
+inline Permutation FineLayer::rollNode(size_t n) const
+{
+    return Permutation(
+        elemmap2nodemap(this->roll(n), this->coor(), this->conn(), ElementType::Quad4));
+}
+
 inline void FineLayer::map(const xt::xtensor<double, 2>& coor, const xt::xtensor<size_t, 2>& conn)
 {
     GOOSEFEM_ASSERT(coor.shape(1) == 2);
@@ -1173,6 +1316,17 @@ inline RefineRegular::RefineRegular(
                 elmat_fine, xt::range(i * ny, (i + 1) * ny), xt::range(j * nx, (j + 1) * nx)));
         }
     }
+
+    // transpose
+    m_fine2coarse = xt::empty<size_t>({m_fine.nelem()});
+    m_fine2coarse_index = xt::empty<size_t>({m_fine.nelem()});
+
+    for (size_t i = 0; i < m_coarse2fine.shape(0); ++i) {
+        for (size_t j = 0; j < m_coarse2fine.shape(1); ++j) {
+            m_fine2coarse(m_coarse2fine(i, j)) = i;
+            m_fine2coarse_index(m_coarse2fine(i, j)) = j;
+        }
+    }
 }
 
 inline GooseFEM::Mesh::Quad4::Regular RefineRegular::getCoarseMesh() const
@@ -1190,103 +1344,96 @@ inline xt::xtensor<size_t, 2> RefineRegular::getMap() const
     return m_coarse2fine;
 }
 
-inline xt::xtensor<double, 2> RefineRegular::mapToCoarse(const xt::xtensor<double, 1>& data) const
+template <class T, class R>
+inline void RefineRegular::map_to_coarse(const T& data, R& ret) const
 {
     GOOSEFEM_ASSERT(data.shape(0) == m_coarse2fine.size());
 
     size_t m = m_coarse2fine.shape(0);
     size_t n = m_coarse2fine.shape(1);
+    size_t stride = data.size() / data.shape(0);
+
+    GOOSEFEM_ASSERT(ret.size() == m * n * stride);
 
-    xt::xtensor<double, 2> ret = xt::empty<double>({m, n});
+    const double* in = data.data();
+    double* out = ret.data();
 
+    #pragma omp parallel for
     for (size_t i = 0; i < m; ++i) {
-        auto e = xt::view(m_coarse2fine, i, xt::all());
-        xt::view(ret, i) = xt::view(data, xt::keep(e));
+        for (size_t j = 0; j < n; ++j) {
+            std::copy(
+                in + m_coarse2fine(i, j) * stride,
+                in + (m_coarse2fine(i, j) + 1) * stride,
+                out + (i * n + j) * stride);
+        }
+    }
+}
+
+template <class T>
+inline void RefineRegular::map_to_fine(const T& data, T& ret) const
+{
+    GOOSEFEM_ASSERT(data.shape(0) == m_coarse2fine.shape(0));
+    GOOSEFEM_ASSERT(ret.shape(0) == m_fine2coarse.size());
+
+    size_t stride = data.size() / data.shape(0);
+    const double* in = data.data();
+    double* out = ret.data();
+
+    #pragma omp parallel for
+    for (size_t j = 0; j < m_fine2coarse.size(); ++j) {
+        std::copy(
+            in + m_fine2coarse(j) * stride, in + (m_fine2coarse(j) + 1) * stride, out + j * stride);
     }
+}
 
+inline xt::xtensor<double, 2> RefineRegular::mapToCoarse(const xt::xtensor<double, 1>& data) const
+{
+    xt::xtensor<double, 2> ret = xt::empty<double>(m_coarse2fine.shape());
+    this->map_to_coarse(data, ret);
     return ret;
 }
 
 inline xt::xtensor<double, 2> RefineRegular::mapToCoarse(const xt::xtensor<double, 2>& data) const
 {
-    GOOSEFEM_ASSERT(data.shape(0) == m_coarse2fine.size());
-
     size_t m = m_coarse2fine.shape(0);
     size_t n = m_coarse2fine.shape(1);
     size_t N = data.shape(1);
 
     xt::xtensor<double, 2> ret = xt::empty<double>({m, n * N});
-
-    for (size_t i = 0; i < m; ++i) {
-        auto e = xt::view(m_coarse2fine, i, xt::all());
-        for (size_t q = 0; q < data.shape(1); ++q) {
-            xt::view(ret, i, xt::range(q + 0, q + n * N, N)) = xt::view(data, xt::keep(e), q);
-        }
-    }
-
+    this->map_to_coarse(data, ret);
     return ret;
 }
 
 inline xt::xtensor<double, 4> RefineRegular::mapToCoarse(const xt::xtensor<double, 4>& data) const
 {
-    GOOSEFEM_ASSERT(data.shape(0) == m_coarse2fine.size());
-
     size_t m = m_coarse2fine.shape(0);
     size_t n = m_coarse2fine.shape(1);
     size_t N = data.shape(1);
 
     xt::xtensor<double, 4> ret = xt::empty<double>({m, n * N, data.shape(2), data.shape(3)});
-
-    for (size_t i = 0; i < m; ++i) {
-        auto e = xt::view(m_coarse2fine, i, xt::all());
-        for (size_t q = 0; q < data.shape(1); ++q) {
-            xt::view(ret, i, xt::range(q + 0, q + n * N, N)) = xt::view(data, xt::keep(e), q);
-        }
-    }
-
+    this->map_to_coarse(data, ret);
     return ret;
 }
 
 inline xt::xtensor<double, 1> RefineRegular::mapToFine(const xt::xtensor<double, 1>& data) const
 {
-    GOOSEFEM_ASSERT(data.shape(0) == m_coarse2fine.shape(0));
-
     xt::xtensor<double, 1> ret = xt::empty<double>({m_coarse2fine.size()});
-
-    for (size_t i = 0; i < m_coarse2fine.shape(0); ++i) {
-        auto e = xt::view(m_coarse2fine, i, xt::all());
-        xt::view(ret, xt::keep(e)) = data(i);
-    }
-
+    this->map_to_fine(data, ret);
     return ret;
 }
 
 inline xt::xtensor<double, 2> RefineRegular::mapToFine(const xt::xtensor<double, 2>& data) const
 {
-    GOOSEFEM_ASSERT(data.shape(0) == m_coarse2fine.shape(0));
-
     xt::xtensor<double, 2> ret = xt::empty<double>({m_coarse2fine.size(), data.shape(1)});
-
-    for (size_t i = 0; i < m_coarse2fine.shape(0); ++i) {
-        auto e = xt::view(m_coarse2fine, i, xt::all());
-        xt::view(ret, xt::keep(e)) = xt::view(data, i);
-    }
-
+    this->map_to_fine(data, ret);
     return ret;
 }
 
 inline xt::xtensor<double, 4> RefineRegular::mapToFine(const xt::xtensor<double, 4>& data) const
 {
-    GOOSEFEM_ASSERT(data.shape(0) == m_coarse2fine.shape(0));
-
     xt::xtensor<double, 4> ret =
         xt::empty<double>({m_coarse2fine.size(), data.shape(1), data.shape(2), data.shape(3)});
-
-    for (size_t i = 0; i < m_coarse2fine.shape(0); ++i) {
-        auto e = xt::view(m_coarse2fine, i, xt::all());
-        xt::view(ret, xt::keep(e)) = xt::view(data, i);
-    }
-
+    this->map_to_fine(data, ret);
     return ret;
 }
 
@@ -1304,9 +1451,9 @@ inline FineLayer2Regular::FineLayer2Regular(const GooseFEM::Mesh::Quad4::FineLay
     // mapping
     // -------
 
-    // allocate mapping
-    m_elem_regular.resize(m_finelayer.m_nelem);
-    m_frac_regular.resize(m_finelayer.m_nelem);
+    // allocate mapping (compressed below)
+    std::vector<std::vector<size_t>> elem(m_finelayer.m_nelem);
+    std::vector<std::vector<double>> frac(m_finelayer.m_nelem);
 
     // alias
     xt::xtensor<size_t, 1> nhx = m_finelayer.m_nhx;
@@ -1345,8 +1492,8 @@ inline FineLayer2Regular::FineLayer2Regular(const GooseFEM::Mesh::Quad4::FineLay
 
                 // write to mapping
                 for (auto& i : block) {
-                    m_elem_regular[el_old(ix)].push_back(i);
-                    m_frac_regular[el_old(ix)].push_back(1.0);
+                    elem[el_old(ix)].push_back(i);
+                    frac[el_old(ix)].push_back(1.0);
                 }
             }
         }
@@ -1371,16 +1518,16 @@ inline FineLayer2Regular::FineLayer2Regular(const GooseFEM::Mesh::Quad4::FineLay
                     for (size_t j = 0; j < nhy(iy) / 2; ++j) {
                         auto e = xt::view(block, j, xt::range(j, nhx(iy) - j));
 
-                        m_elem_regular[el_old(ix, 0)].push_back(e(0));
-                        m_frac_regular[el_old(ix, 0)].push_back(0.5);
+                        elem[el_old(ix, 0)].push_back(e(0));
+                        frac[el_old(ix, 0)].push_back(0.5);
 
                         for (size_t k = 1; k < e.size() - 1; ++k) {
-                            m_elem_regular[el_old(ix, 0)].push_back(e(k));
-                            m_frac_regular[el_old(ix, 0)].push_back(1.0);
+                            elem[el_old(ix, 0)].push_back(e(k));
+                            frac[el_old(ix, 0)].push_back(1.0);
                         }
 
-                        m_elem_regular[el_old(ix, 0)].push_back(e(e.size() - 1));
-                        m_frac_regular[el_old(ix, 0)].push_back(0.5);
+                        elem[el_old(ix, 0)].push_back(e(e.size() - 1));
+                        frac[el_old(ix, 0)].push_back(0.5);
                     }
                 }
 
@@ -1392,8 +1539,8 @@ inline FineLayer2Regular::FineLayer2Regular(const GooseFEM::Mesh::Quad4::FineLay
                         xt::range(1 * nhx(iy) / 3, 2 * nhx(iy) / 3));
 
                     for (auto& i : e) {
-                        m_elem_regular[el_old(ix, 2)].push_back(i);
-                        m_frac_regular[el_old(ix, 2)].push_back(1.0);
+                        elem[el_old(ix, 2)].push_back(i);
+                        frac[el_old(ix, 2)].push_back(1.0);
                     }
                 }
 
@@ -1404,12 +1551,12 @@ inline FineLayer2Regular::FineLayer2Regular(const GooseFEM::Mesh::Quad4::FineLay
                         auto e = xt::view(block, j, xt::range(0, j + 1));
 
                         for (size_t k = 0; k < e.size() - 1; ++k) {
-                            m_elem_regular[el_old(ix, 3)].push_back(e(k));
-                            m_frac_regular[el_old(ix, 3)].push_back(1.0);
+                            elem[el_old(ix, 3)].push_back(e(k));
+                            frac[el_old(ix, 3)].push_back(1.0);
                         }
 
-                        m_elem_regular[el_old(ix, 3)].push_back(e(e.size() - 1));
-                        m_frac_regular[el_old(ix, 3)].push_back(0.5);
+                        elem[el_old(ix, 3)].push_back(e(e.size() - 1));
+                        frac[el_old(ix, 3)].push_back(0.5);
                     }
 
                     // left-top: regular
@@ -1420,8 +1567,8 @@ inline FineLayer2Regular::FineLayer2Regular(const GooseFEM::Mesh::Quad4::FineLay
                             xt::range(0 * nhx(iy) / 3, 1 * nhx(iy) / 3));
 
                         for (auto& i : e) {
-                            m_elem_regular[el_old(ix, 3)].push_back(i);
-                            m_frac_regular[el_old(ix, 3)].push_back(1.0);
+                            elem[el_old(ix, 3)].push_back(i);
+                            frac[el_old(ix, 3)].push_back(1.0);
                         }
                     }
                 }
@@ -1432,12 +1579,12 @@ inline FineLayer2Regular::FineLayer2Regular(const GooseFEM::Mesh::Quad4::FineLay
                     for (size_t j = 0; j < nhy(iy) / 2; ++j) {
                         auto e = xt::view(block, j, xt::range(nhx(iy) - j - 1, nhx(iy)));
 
-                        m_elem_regular[el_old(ix, 1)].push_back(e(0));
-                        m_frac_regular[el_old(ix, 1)].push_back(0.5);
+                        elem[el_old(ix, 1)].push_back(e(0));
+                        frac[el_old(ix, 1)].push_back(0.5);
 
                         for (size_t k = 1; k < e.size(); ++k) {
-                            m_elem_regular[el_old(ix, 1)].push_back(e(k));
-                            m_frac_regular[el_old(ix, 1)].push_back(1.0);
+                            elem[el_old(ix, 1)].push_back(e(k));
+                            frac[el_old(ix, 1)].push_back(1.0);
                         }
                     }
 
@@ -1449,8 +1596,8 @@ inline FineLayer2Regular::FineLayer2Regular(const GooseFEM::Mesh::Quad4::FineLay
                             xt::range(2 * nhx(iy) / 3, 3 * nhx(iy) / 3));
 
                         for (auto& i : e) {
-                            m_elem_regular[el_old(ix, 1)].push_back(i);
-                            m_frac_regular[el_old(ix, 1)].push_back(1.0);
+                            elem[el_old(ix, 1)].push_back(i);
+                            frac[el_old(ix, 1)].push_back(1.0);
                         }
                     }
                 }
@@ -1478,16 +1625,16 @@ inline FineLayer2Regular::FineLayer2Regular(const GooseFEM::Mesh::Quad4::FineLay
                             nhy(iy) / 2 + j,
                             xt::range(1 * nhx(iy) / 3 - j - 1, 2 * nhx(iy) / 3 + j + 1));
 
-                        m_elem_regular[el_old(ix, 3)].push_back(e(0));
-                        m_frac_regular[el_old(ix, 3)].push_back(0.5);
+                        elem[el_old(ix, 3)].push_back(e(0));
+                        frac[el_old(ix, 3)].push_back(0.5);
 
                         for (size_t k = 1; k < e.size() - 1; ++k) {
-                            m_elem_regular[el_old(ix, 3)].push_back(e(k));
-                            m_frac_regular[el_old(ix, 3)].push_back(1.0);
+                            elem[el_old(ix, 3)].push_back(e(k));
+                            frac[el_old(ix, 3)].push_back(1.0);
                         }
 
-                        m_elem_regular[el_old(ix, 3)].push_back(e(e.size() - 1));
-                        m_frac_regular[el_old(ix, 3)].push_back(0.5);
+                        elem[el_old(ix, 3)].push_back(e(e.size() - 1));
+                        frac[el_old(ix, 3)].push_back(0.5);
                     }
                 }
 
@@ -1499,8 +1646,8 @@ inline FineLayer2Regular::FineLayer2Regular(const GooseFEM::Mesh::Quad4::FineLay
                         xt::range(1 * nhx(iy) / 3, 2 * nhx(iy) / 3));
 
                     for (auto& i : e) {
-                        m_elem_regular[el_old(ix, 1)].push_back(i);
-                        m_frac_regular[el_old(ix, 1)].push_back(1.0);
+                        elem[el_old(ix, 1)].push_back(i);
+                        frac[el_old(ix, 1)].push_back(1.0);
                     }
                 }
 
@@ -1514,8 +1661,8 @@ inline FineLayer2Regular::FineLayer2Regular(const GooseFEM::Mesh::Quad4::FineLay
                             xt::range(0 * nhx(iy) / 3, 1 * nhx(iy) / 3));
 
                         for (auto& i : e) {
-                            m_elem_regular[el_old(ix, 0)].push_back(i);
-                            m_frac_regular[el_old(ix, 0)].push_back(1.0);
+                            elem[el_old(ix, 0)].push_back(i);
+                            frac[el_old(ix, 0)].push_back(1.0);
                         }
                     }
 
@@ -1525,12 +1672,12 @@ inline FineLayer2Regular::FineLayer2Regular(const GooseFEM::Mesh::Quad4::FineLay
                             xt::view(block, nhy(iy) / 2 + j, xt::range(0, 1 * nhx(iy) / 3 - j));
 
                         for (size_t k = 0; k < e.size() - 1; ++k) {
-                            m_elem_regular[el_old(ix, 0)].push_back(e(k));
-                            m_frac_regular[el_old(ix, 0)].push_back(1.0);
+                            elem[el_old(ix, 0)].push_back(e(k));
+                            frac[el_old(ix, 0)].push_back(1.0);
                         }
 
-                        m_elem_regular[el_old(ix, 0)].push_back(e(e.size() - 1));
-                        m_frac_regular[el_old(ix, 0)].push_back(0.5);
+                        elem[el_old(ix, 0)].push_back(e(e.size() - 1));
+                        frac[el_old(ix, 0)].push_back(0.5);
                     }
                 }
 
@@ -1544,8 +1691,8 @@ inline FineLayer2Regular::FineLayer2Regular(const GooseFEM::Mesh::Quad4::FineLay
                             xt::range(2 * nhx(iy) / 3, 3 * nhx(iy) / 3));
 
                         for (auto& i : e) {
-                            m_elem_regular[el_old(ix, 2)].push_back(i);
-                            m_frac_regular[el_old(ix, 2)].push_back(1.0);
+                            elem[el_old(ix, 2)].push_back(i);
+                            frac[el_old(ix, 2)].push_back(1.0);
                         }
                     }
 
@@ -1554,18 +1701,60 @@ inline FineLayer2Regular::FineLayer2Regular(const GooseFEM::Mesh::Quad4::FineLay
                         auto e = xt::view(
                             block, nhy(iy) / 2 + j, xt::range(2 * nhx(iy) / 3 + j, nhx(iy)));
 
-                        m_elem_regular[el_old(ix, 2)].push_back(e(0));
-                        m_frac_regular[el_old(ix, 2)].push_back(0.5);
+                        elem[el_old(ix, 2)].push_back(e(0));
+                        frac[el_old(ix, 2)].push_back(0.5);
 
                         for (size_t k = 1; k < e.size(); ++k) {
-                            m_elem_regular[el_old(ix, 2)].push_back(e(k));
-                            m_frac_regular[el_old(ix, 2)].push_back(1.0);
+                            elem[el_old(ix, 2)].push_back(e(k));
+                            frac[el_old(ix, 2)].push_back(1.0);
                         }
                     }
                 }
             }
         }
     }
+
+    // --------------------
+    // compress & transpose
+    // --------------------
+
+    size_t nfine = m_finelayer.m_nelem;
+    size_t nreg = m_regular.nelem();
+
+    m_offsets_regular = xt::zeros<size_t>({nfine + 1});
+    m_offsets_finelayer = xt::zeros<size_t>({nreg + 1});
+
+    for (size_t e = 0; e < nfine; ++e) {
+        m_offsets_regular(e + 1) = m_offsets_regular(e) + elem[e].size();
+        for (auto& i : elem[e]) {
+            m_offsets_finelayer(i + 1)++;
+        }
+    }
+
+    std::partial_sum(
+        m_offsets_finelayer.begin(), m_offsets_finelayer.end(), m_offsets_finelayer.begin());
+
+    size_t nnz = m_offsets_regular(nfine);
+    GOOSEFEM_ASSERT(m_offsets_finelayer(nreg) == nnz);
+
+    m_elem_regular = xt::empty<size_t>({nnz});
+    m_frac_regular = xt::empty<double>({nnz});
+    m_elem_finelayer = xt::empty<size_t>({nnz});
+    m_frac_finelayer = xt::empty<double>({nnz});
+
+    std::vector<size_t> cursor(m_offsets_finelayer.begin(), m_offsets_finelayer.end() - 1);
+
+    // (looping over "e" in ascending order, such that the transposed rows are sorted)
+    for (size_t e = 0; e < nfine; ++e) {
+        for (size_t k = 0; k < elem[e].size(); ++k) {
+            size_t i = elem[e][k];
+            m_elem_regular(m_offsets_regular(e) + k) = i;
+            m_frac_regular(m_offsets_regular(e) + k) = frac[e][k];
+            m_elem_finelayer(cursor[i]) = e;
+            m_frac_finelayer(cursor[i]) = frac[e][k];
+            cursor[i]++;
+        }
+    }
 }
 
 inline GooseFEM::Mesh::Quad4::Regular FineLayer2Regular::getRegularMesh() const
@@ -1580,61 +1769,75 @@ inline GooseFEM::Mesh::Quad4::FineLayer FineLayer2Regular::getFineLayerMesh() co
 
 inline std::vector<std::vector<size_t>> FineLayer2Regular::getMap() const
 {
-    return m_elem_regular;
-}
+    std::vector<std::vector<size_t>> ret(m_finelayer.nelem());
 
-inline std::vector<std::vector<double>> FineLayer2Regular::getMapFraction() const
-{
-    return m_frac_regular;
+    for (size_t e = 0; e < m_finelayer.nelem(); ++e) {
+        ret[e].assign(
+            m_elem_regular.begin() + m_offsets_regular(e),
+            m_elem_regular.begin() + m_offsets_regular(e + 1));
+    }
+
+    return ret;
 }
 
-inline xt::xtensor<double, 1>
-FineLayer2Regular::mapToRegular(const xt::xtensor<double, 1>& data) const
+inline std::vector<std::vector<double>> FineLayer2Regular::getMapFraction() const
 {
-    GOOSEFEM_ASSERT(data.shape(0) == m_finelayer.nelem());
-
-    xt::xtensor<double, 1> ret = xt::zeros<double>({m_regular.nelem()});
+    std::vector<std::vector<double>> ret(m_finelayer.nelem());
 
     for (size_t e = 0; e < m_finelayer.nelem(); ++e) {
-        for (size_t i = 0; i < m_elem_regular[e].size(); ++i) {
-            ret(m_elem_regular[e][i]) += m_frac_regular[e][i] * data(e);
-        }
+        ret[e].assign(
+            m_frac_regular.begin() + m_offsets_regular(e),
+            m_frac_regular.begin() + m_offsets_regular(e + 1));
     }
 
     return ret;
 }
 
-inline xt::xtensor<double, 2>
-FineLayer2Regular::mapToRegular(const xt::xtensor<double, 2>& data) const
+template <class T>
+inline T FineLayer2Regular::map_to_regular(const T& data) const
 {
     GOOSEFEM_ASSERT(data.shape(0) == m_finelayer.nelem());
 
-    xt::xtensor<double, 2> ret = xt::zeros<double>({m_regular.nelem(), data.shape(1)});
-
-    for (size_t e = 0; e < m_finelayer.nelem(); ++e) {
-        for (size_t i = 0; i < m_elem_regular[e].size(); ++i) {
-            xt::view(ret, m_elem_regular[e][i]) += m_frac_regular[e][i] * xt::view(data, e);
+    auto shape = data.shape();
+    shape[0] = m_regular.nelem();
+    T ret = xt::empty<double>(shape);
+
+    size_t stride = data.size() / data.shape(0);
+    const double* in = data.data();
+    double* out = ret.data();
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < m_regular.nelem(); ++i) {
+        double* row = out + i * stride;
+        std::fill(row, row + stride, 0.0);
+        for (size_t j = m_offsets_finelayer(i); j < m_offsets_finelayer(i + 1); ++j) {
+            const double* src = in + m_elem_finelayer(j) * stride;
+            double w = m_frac_finelayer(j);
+            for (size_t k = 0; k < stride; ++k) {
+                row[k] += w * src[k];
+            }
         }
     }
 
     return ret;
 }
 
-inline xt::xtensor<double, 4>
-FineLayer2Regular::mapToRegular(const xt::xtensor<double, 4>& data) const
+inline xt::xtensor<double, 1>
+FineLayer2Regular::mapToRegular(const xt::xtensor<double, 1>& data) const
 {
-    GOOSEFEM_ASSERT(data.shape(0) == m_finelayer.nelem());
-
-    xt::xtensor<double, 4> ret =
-        xt::zeros<double>({m_regular.nelem(), data.shape(1), data.shape(2), data.shape(3)});
+    return this->map_to_regular(data);
+}
 
-    for (size_t e = 0; e < m_finelayer.nelem(); ++e) {
-        for (size_t i = 0; i < m_elem_regular[e].size(); ++i) {
-            xt::view(ret, m_elem_regular[e][i]) += m_frac_regular[e][i] * xt::view(data, e);
-        }
-    }
+inline xt::xtensor<double, 2>
+FineLayer2Regular::mapToRegular(const xt::xtensor<double, 2>& data) const
+{
+    return this->map_to_regular(data);
+}
 
-    return ret;
+inline xt::xtensor<double, 4>
+FineLayer2Regular::mapToRegular(const xt::xtensor<double, 4>& data) const
+{
+    return this->map_to_regular(data);
 }
 
 } // namespace Map
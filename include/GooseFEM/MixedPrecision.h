@@ -0,0 +1,97 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_MIXEDPRECISION_H
+#define GOOSEFEM_MIXEDPRECISION_H
+
+#include "config.h"
+
+#include <Eigen/Eigen>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+namespace GooseFEM {
+
+/*
+  Direct solver with a single precision factorization, refined to double precision accuracy
+  (iterative refinement):
+
+    x_0 = A_f^{-1} b
+    x_{k+1} = x_k + A_f^{-1} (b - A x_k)
+
+  with "A_f" the factorization in single precision, and the residual computed using the double
+  precision matrix "A". The memory (and memory bandwidth) of the factorization is halved, while
+  for a reasonably conditioned matrix only a few refinement steps are needed, e.g.:
+
+    GooseFEM::MatrixSolver<GooseFEM::MixedPrecision<>> Solver;
+    Solver.solver().setTolerance(1e-12);
+    Solver.solve(K, b, x);
+
+  -   "Solver" should follow Eigen's sparse solver concept for "Eigen::SparseMatrix<float>".
+  -   A copy of "A" is stored to compute the residual (its size is that of the matrix, which for
+      a sparse factorization is only a fraction of the size of the factorization).
+  -   Refinement stops if the relative residual "|b - A x| / |b|" is smaller than the tolerance,
+      or if the maximum number of iterations is reached ("info()" is then "NoConvergence").
+*/
+
+template <class Solver = Eigen::SimplicialLDLT<Eigen::SparseMatrix<float>>>
+class MixedPrecision {
+public:
+    // Constructors
+    MixedPrecision() = default;
+
+    // Settings
+    void setTolerance(double tol);   // relative residual (default: 1e-12)
+    void setMaxIterations(size_t n); // maximum number of solves (default: 10)
+
+    // Dimensions
+    Eigen::Index rows() const;
+    Eigen::Index cols() const;
+
+    // Solver concept
+    template <class T>
+    MixedPrecision& compute(const T& A);
+
+    template <class Rhs>
+    Eigen::Matrix<double, Eigen::Dynamic, Rhs::ColsAtCompileTime>
+    solve(const Eigen::MatrixBase<Rhs>& b) const;
+
+    // Start the refinement from "x0" (e.g. the solution of a previous step)
+    template <class Rhs, class Guess>
+    Eigen::Matrix<double, Eigen::Dynamic, Rhs::ColsAtCompileTime>
+    solveWithGuess(const Eigen::MatrixBase<Rhs>& b, const Guess& x0) const;
+
+    Eigen::ComputationInfo info() const;
+
+    // Statistics of the last solve
+    size_t iterations() const; // number of solves using the factorization
+    double error() const;      // relative residual
+
+    // The underlying (single precision) solver
+    const Solver& solver() const;
+
+private:
+    // Refine "x" in-place
+    template <class Rhs, class X>
+    void refine(const Eigen::MatrixBase<Rhs>& b, X& x) const;
+
+    // Solve using the factorization, scaling the right-hand side to avoid underflow
+    Eigen::MatrixXd correction(const Eigen::MatrixXd& r) const;
+
+    Solver m_solver;
+    Eigen::SparseMatrix<double> m_A;
+    double m_tol = 1e-12;
+    size_t m_maxiter = 10;
+    mutable size_t m_iterations = 0;
+    mutable double m_error = 0.0;
+    mutable Eigen::ComputationInfo m_info = Eigen::InvalidInput;
+};
+
+} // namespace GooseFEM
+
+#include "MixedPrecision.hpp"
+
+#endif
@@ -0,0 +1,159 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_MIXEDPRECISION_HPP
+#define GOOSEFEM_MIXEDPRECISION_HPP
+
+#include "MixedPrecision.h"
+
+namespace GooseFEM {
+
+template <class Solver>
+inline void MixedPrecision<Solver>::setTolerance(double tol)
+{
+    m_tol = tol;
+}
+
+template <class Solver>
+inline void MixedPrecision<Solver>::setMaxIterations(size_t n)
+{
+    m_maxiter = n;
+}
+
+template <class Solver>
+inline Eigen::Index MixedPrecision<Solver>::rows() const
+{
+    return m_A.rows();
+}
+
+template <class Solver>
+inline Eigen::Index MixedPrecision<Solver>::cols() const
+{
+    return m_A.cols();
+}
+
+template <class Solver>
+template <class T>
+inline MixedPrecision<Solver>& MixedPrecision<Solver>::compute(const T& A)
+{
+    m_A = A;
+    m_solver.compute(m_A.template cast<float>());
+    m_info = m_solver.info();
+    m_iterations = 0;
+    m_error = 0.0;
+    return *this;
+}
+
+template <class Solver>
+inline Eigen::MatrixXd MixedPrecision<Solver>::correction(const Eigen::MatrixXd& r) const
+{
+    Eigen::VectorXd scale = r.cwiseAbs().colwise().maxCoeff().transpose();
+    Eigen::MatrixXf rf(r.rows(), r.cols());
+
+    for (Eigen::Index j = 0; j < r.cols(); ++j) {
+        if (scale(j) == 0.0) {
+            scale(j) = 1.0;
+        }
+        rf.col(j) = (r.col(j) / scale(j)).template cast<float>();
+    }
+
+    Eigen::MatrixXf xf = m_solver.solve(rf);
+    return xf.template cast<double>() * scale.asDiagonal();
+}
+
+template <class Solver>
+template <class Rhs, class X>
+inline void MixedPrecision<Solver>::refine(const Eigen::MatrixBase<Rhs>& b, X& x) const
+{
+    m_iterations = 0;
+    m_error = 0.0;
+    m_info = m_solver.info();
+
+    if (m_info != Eigen::Success) {
+        return;
+    }
+
+    Eigen::VectorXd norm = b.colwise().norm().transpose();
+
+    for (Eigen::Index j = 0; j < norm.size(); ++j) {
+        if (norm(j) == 0.0) {
+            norm(j) = 1.0;
+        }
+    }
+
+    while (true) {
+        Eigen::MatrixXd r = b - m_A * x;
+        m_error = (r.colwise().norm().transpose().cwiseQuotient(norm)).maxCoeff();
+
+        if (m_error <= m_tol) {
+            return;
+        }
+
+        if (m_iterations >= m_maxiter) {
+            m_info = Eigen::NoConvergence;
+            return;
+        }
+
+        x += this->correction(r);
+        m_iterations++;
+    }
+}
+
+template <class Solver>
+template <class Rhs>
+inline Eigen::Matrix<double, Eigen::Dynamic, Rhs::ColsAtCompileTime>
+MixedPrecision<Solver>::solve(const Eigen::MatrixBase<Rhs>& b) const
+{
+    GOOSEFEM_ASSERT(b.rows() == m_A.rows());
+
+    Eigen::Matrix<double, Eigen::Dynamic, Rhs::ColsAtCompileTime> x =
+        Eigen::Matrix<double, Eigen::Dynamic, Rhs::ColsAtCompileTime>::Zero(b.rows(), b.cols());
+
+    this->refine(b, x);
+    return x;
+}
+
+template <class Solver>
+template <class Rhs, class Guess>
+inline Eigen::Matrix<double, Eigen::Dynamic, Rhs::ColsAtCompileTime>
+MixedPrecision<Solver>::solveWithGuess(const Eigen::MatrixBase<Rhs>& b, const Guess& x0) const
+{
+    GOOSEFEM_ASSERT(b.rows() == m_A.rows());
+    GOOSEFEM_ASSERT(x0.rows() == b.rows() && x0.cols() == b.cols());
+
+    Eigen::Matrix<double, Eigen::Dynamic, Rhs::ColsAtCompileTime> x = x0;
+
+    this->refine(b, x);
+    return x;
+}
+
+template <class Solver>
+inline Eigen::ComputationInfo MixedPrecision<Solver>::info() const
+{
+    return m_info;
+}
+
+template <class Solver>
+inline size_t MixedPrecision<Solver>::iterations() const
+{
+    return m_iterations;
+}
+
+template <class Solver>
+inline double MixedPrecision<Solver>::error() const
+{
+    return m_error;
+}
+
+template <class Solver>
+inline const Solver& MixedPrecision<Solver>::solver() const
+{
+    return m_solver;
+}
+
+} // namespace GooseFEM
+
+#endif
@@ -0,0 +1,151 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_MULTIGRID_H
+#define GOOSEFEM_MULTIGRID_H
+
+#include "config.h"
+
+#include <Eigen/Eigen>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+namespace GooseFEM {
+
+/*
+  Multigrid hierarchy and (symmetric) V-cycle, shared by "Multigrid" and "AMG":
+
+  -   Coarse operators: Galerkin "A_{l+1} = P_l^T * A_l * P_l".
+  -   Smoother: Chebyshev polynomial of "D^{-1} A", which is symmetric and is applied using
+      matrix-vector products only.
+  -   Coarsest level: sparse direct solver.
+
+  Follows Eigen's preconditioner concept (together with the derived class' "compute").
+*/
+
+class MultigridBase {
+public:
+    using StorageIndex = typename Eigen::SparseMatrix<double>::StorageIndex;
+    enum { ColsAtCompileTime = Eigen::Dynamic, MaxColsAtCompileTime = Eigen::Dynamic };
+
+    // Settings
+    void setSmootherDegree(size_t n); // degree of the Chebyshev polynomial (default: 2)
+
+    // Dimensions
+    Eigen::Index rows() const;
+    Eigen::Index cols() const;
+
+    // Apply the preconditioner: one V-cycle (starting from zero)
+    template <class Rhs>
+    Eigen::VectorXd solve(const Eigen::MatrixBase<Rhs>& b) const;
+
+    Eigen::ComputationInfo info() const;
+
+    // Statistics
+    size_t nlevel() const;             // number of levels
+    size_t size(size_t level) const;   // number of rows of the operator of a level
+    double operatorComplexity() const; // sum of "nnz" of all levels, relative to the finest
+
+protected:
+    // Per level: the operator, the prolongator to this level from the next (coarser) level,
+    // and data of the smoother
+    struct Level {
+        Eigen::SparseMatrix<double> A;
+        Eigen::SparseMatrix<double> P;
+        Eigen::VectorXd invdiag;
+        double rho; // estimated largest eigenvalue of "D^{-1} A"
+    };
+
+    // Start a new hierarchy with operator "A" on the finest level
+    void init(const Eigen::SparseMatrix<double>& A);
+
+    // Set the prolongator "P" of the currently coarsest level, and add the next level
+    // (Galerkin operator)
+    void coarsen(const Eigen::SparseMatrix<double>& P);
+
+    // Add a level with operator "A" (computing the data of the smoother)
+    void push(Eigen::SparseMatrix<double>&& A);
+
+    // Factorize the coarsest level
+    void finalize();
+
+    // Apply "degree" Chebyshev iterations to "x" for "A x = b" on level "l"
+    void smooth(size_t l, const Eigen::VectorXd& b, Eigen::VectorXd& x) const;
+
+    // V-cycle on level "l", starting from zero
+    Eigen::VectorXd cycle(size_t l, const Eigen::VectorXd& b) const;
+
+    size_t m_degree = 2;
+    Eigen::Index m_n = 0;
+    std::vector<Level> m_levels;
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> m_coarse;
+    Eigen::ComputationInfo m_info = Eigen::InvalidInput;
+};
+
+/*
+  Geometric multigrid (symmetric V-cycle), for use as preconditioner of "PCG", using given
+  prolongators. For Regular meshes the prolongators are obtained from "RefineRegular" using
+  "prolongation" below, e.g. for three levels:
+
+    GooseFEM::Mesh::Quad4::Map::RefineRegular map1(mesh2, 2, 2); // mesh1 -> mesh2 (coarser)
+    GooseFEM::Mesh::Quad4::Map::RefineRegular map0(map1.getFineMesh(), 2, 2);
+    ...
+    GooseFEM::MatrixPartitionedSolver<GooseFEM::PCG<GooseFEM::Multigrid>> Solver;
+    Solver.solver().preconditioner().setProlongators({
+        GooseFEM::prolongation(map0, dofs1, iiu1, dofs0, iiu0),
+        GooseFEM::prolongation(map1, dofs2, iiu2, dofs1, iiu1)});
+*/
+
+class Multigrid : public MultigridBase {
+public:
+    // Constructors
+    Multigrid() = default;
+
+    // Prolongators: "P[l]" interpolates level "l + 1" to level "l" (level 0 is the finest)
+    void setProlongators(const std::vector<Eigen::SparseMatrix<double>>& P);
+
+    // Preconditioner concept
+    template <class T>
+    Multigrid& analyzePattern(const T& A);
+
+    template <class T>
+    Multigrid& factorize(const T& A);
+
+    template <class T>
+    Multigrid& compute(const T& A);
+
+private:
+    std::vector<Eigen::SparseMatrix<double>> m_P;
+};
+
+/*
+  Prolongation [iiu_fine.size(), iiu_coarse.size()] from the coarse to the fine mesh of a
+  "RefineRegular" map: the interpolation of the nodal values using the shape functions of the
+  coarse elements. Row "r" corresponds to DOF "iiu_fine(r)" of "dofs_fine" (and likewise for the
+  columns), such that also periodic DOFs (e.g. "dofsPeriodic()") are supported. A coarse DOF
+  that is not in "iiu_coarse" is considered prescribed (zero). Omit "iiu_..." if all DOFs are
+  unknown.
+*/
+
+template <class Map>
+Eigen::SparseMatrix<double> prolongation(
+    const Map& map,
+    const xt::xtensor<size_t, 2>& dofs_coarse,
+    const xt::xtensor<size_t, 1>& iiu_coarse,
+    const xt::xtensor<size_t, 2>& dofs_fine,
+    const xt::xtensor<size_t, 1>& iiu_fine);
+
+template <class Map>
+Eigen::SparseMatrix<double> prolongation(
+    const Map& map,
+    const xt::xtensor<size_t, 2>& dofs_coarse,
+    const xt::xtensor<size_t, 2>& dofs_fine);
+
+} // namespace GooseFEM
+
+#include "Multigrid.hpp"
+
+#endif
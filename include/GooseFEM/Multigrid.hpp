@@ -0,0 +1,331 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_MULTIGRID_HPP
+#define GOOSEFEM_MULTIGRID_HPP
+
+#include "Multigrid.h"
+
+namespace GooseFEM {
+
+namespace detail {
+
+    // Estimate the largest eigenvalue of "D^{-1} A" (power iteration). The start vector is
+    // pseudo-random (xorshift), as any smooth start vector is nearly orthogonal to the highest
+    // modes of (periodic) regular meshes, which leads to an underestimate.
+    inline double spectral_radius(
+        const Eigen::SparseMatrix<double>& A, const Eigen::VectorXd& invdiag, size_t niter = 15)
+    {
+        Eigen::Index n = A.rows();
+        Eigen::VectorXd x(n);
+        double ret = 0.0;
+        uint64_t state = 88172645463325252ull;
+
+        for (Eigen::Index i = 0; i < n; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            x(i) = static_cast<double>(state >> 11) / 9007199254740992.0 - 0.5;
+        }
+
+        x.normalize();
+
+        for (size_t k = 0; k < niter; ++k) {
+            Eigen::VectorXd y = invdiag.cwiseProduct(A * x);
+            ret = y.norm();
+            if (ret == 0.0) {
+                return 1.0;
+            }
+            x = y / ret;
+        }
+
+        return ret;
+    }
+
+} // namespace detail
+
+inline void MultigridBase::setSmootherDegree(size_t n)
+{
+    GOOSEFEM_CHECK(n > 0);
+    m_degree = n;
+}
+
+inline Eigen::Index MultigridBase::rows() const
+{
+    return m_n;
+}
+
+inline Eigen::Index MultigridBase::cols() const
+{
+    return m_n;
+}
+
+inline void MultigridBase::init(const Eigen::SparseMatrix<double>& A)
+{
+    m_n = A.rows();
+    m_levels.clear();
+    this->push(Eigen::SparseMatrix<double>(A));
+}
+
+inline void MultigridBase::push(Eigen::SparseMatrix<double>&& A)
+{
+    Level level;
+    level.A = std::move(A);
+    level.invdiag = level.A.diagonal().cwiseInverse();
+    level.rho = detail::spectral_radius(level.A, level.invdiag);
+    m_levels.push_back(std::move(level));
+}
+
+inline void MultigridBase::coarsen(const Eigen::SparseMatrix<double>& P)
+{
+    using SpMat = Eigen::SparseMatrix<double>;
+
+    Level& level = m_levels.back();
+    GOOSEFEM_CHECK(P.rows() == level.A.rows());
+    level.P = P;
+
+    SpMat AP = level.A * level.P;
+    SpMat Ac = SpMat(level.P.transpose()) * AP;
+
+    this->push(std::move(Ac));
+}
+
+inline void MultigridBase::finalize()
+{
+    m_coarse.compute(m_levels.back().A);
+    m_info = m_coarse.info();
+}
+
+inline void MultigridBase::smooth(size_t l, const Eigen::VectorXd& b, Eigen::VectorXd& x) const
+{
+    const Level& level = m_levels[l];
+
+    // eigenvalue interval of "D^{-1} A" targeted by the polynomial
+    double upper = 1.1 * level.rho;
+    double lower = 0.1 * level.rho;
+    double theta = 0.5 * (upper + lower);
+    double delta = 0.5 * (upper - lower);
+    double sigma = theta / delta;
+    double rho = 1.0 / sigma;
+
+    Eigen::VectorXd r = b - level.A * x;
+    Eigen::VectorXd d = level.invdiag.cwiseProduct(r) / theta;
+
+    for (size_t k = 0; k < m_degree; ++k) {
+        x += d;
+        if (k + 1 == m_degree) {
+            break;
+        }
+        r -= level.A * d;
+        double rho_new = 1.0 / (2.0 * sigma - rho);
+        d = (rho_new * rho) * d + (2.0 * rho_new / delta) * level.invdiag.cwiseProduct(r);
+        rho = rho_new;
+    }
+}
+
+inline Eigen::VectorXd MultigridBase::cycle(size_t l, const Eigen::VectorXd& b) const
+{
+    if (l + 1 == m_levels.size()) {
+        return m_coarse.solve(b);
+    }
+
+    const Level& level = m_levels[l];
+    Eigen::VectorXd x = Eigen::VectorXd::Zero(b.size());
+
+    this->smooth(l, b, x);
+    Eigen::VectorXd r = level.P.transpose() * (b - level.A * x);
+    x += level.P * this->cycle(l + 1, r);
+    this->smooth(l, b, x);
+
+    return x;
+}
+
+template <class Rhs>
+inline Eigen::VectorXd MultigridBase::solve(const Eigen::MatrixBase<Rhs>& b) const
+{
+    GOOSEFEM_ASSERT(b.rows() == m_n);
+    return this->cycle(0, Eigen::VectorXd(b));
+}
+
+inline Eigen::ComputationInfo MultigridBase::info() const
+{
+    return m_info;
+}
+
+inline size_t MultigridBase::nlevel() const
+{
+    return m_levels.size();
+}
+
+inline size_t MultigridBase::size(size_t level) const
+{
+    GOOSEFEM_ASSERT(level < m_levels.size());
+    return static_cast<size_t>(m_levels[level].A.rows());
+}
+
+inline double MultigridBase::operatorComplexity() const
+{
+    double ret = 0.0;
+
+    for (auto& level : m_levels) {
+        ret += static_cast<double>(level.A.nonZeros());
+    }
+
+    return ret / static_cast<double>(m_levels.front().A.nonZeros());
+}
+
+inline void Multigrid::setProlongators(const std::vector<Eigen::SparseMatrix<double>>& P)
+{
+    for (size_t l = 1; l < P.size(); ++l) {
+        GOOSEFEM_CHECK(P[l].rows() == P[l - 1].cols());
+    }
+
+    m_P = P;
+}
+
+template <class T>
+inline Multigrid& Multigrid::analyzePattern(const T&)
+{
+    return *this;
+}
+
+template <class T>
+inline Multigrid& Multigrid::factorize(const T& A)
+{
+    return this->compute(A);
+}
+
+template <class T>
+inline Multigrid& Multigrid::compute(const T& A)
+{
+    this->init(Eigen::SparseMatrix<double>(A));
+
+    for (auto& P : m_P) {
+        this->coarsen(P);
+    }
+
+    this->finalize();
+    return *this;
+}
+
+template <class Map>
+inline Eigen::SparseMatrix<double> prolongation(
+    const Map& map,
+    const xt::xtensor<size_t, 2>& dofs_coarse,
+    const xt::xtensor<size_t, 1>& iiu_coarse,
+    const xt::xtensor<size_t, 2>& dofs_fine,
+    const xt::xtensor<size_t, 1>& iiu_fine)
+{
+    auto coarse = map.getCoarseMesh();
+    auto fine = map.getFineMesh();
+
+    xt::xtensor<double, 2> coor_c = coarse.coor();
+    xt::xtensor<double, 2> coor_f = fine.coor();
+    xt::xtensor<size_t, 2> conn_c = coarse.conn();
+    xt::xtensor<size_t, 2> conn_f = fine.conn();
+    xt::xtensor<size_t, 2> coarse2fine = map.getMap();
+
+    size_t ndim = coor_c.shape(1);
+    size_t nne = conn_c.shape(1);
+    double h = coarse.h();
+
+    GOOSEFEM_ASSERT(dofs_coarse.shape(0) == coor_c.shape(0));
+    GOOSEFEM_ASSERT(dofs_coarse.shape(1) == ndim);
+    GOOSEFEM_ASSERT(dofs_fine.shape(0) == coor_f.shape(0));
+    GOOSEFEM_ASSERT(dofs_fine.shape(1) == ndim);
+
+    // the fine mesh has the same element size as the coarse mesh: scale its coordinates to
+    // those of the coarse mesh, per direction
+    std::vector<double> scale(ndim);
+
+    for (size_t d = 0; d < ndim; ++d) {
+        double lc = 0.0;
+        double lf = 0.0;
+        for (size_t m = 0; m < coor_c.shape(0); ++m) {
+            lc = std::max(lc, coor_c(m, d));
+        }
+        for (size_t m = 0; m < coor_f.shape(0); ++m) {
+            lf = std::max(lf, coor_f(m, d));
+        }
+        scale[d] = lc / lf;
+    }
+
+    // DOF -> row (fine) or column (coarse), "-1" if prescribed
+
+    std::vector<ptrdiff_t> row(xt::amax(dofs_fine)() + 1, -1);
+    std::vector<ptrdiff_t> col(xt::amax(dofs_coarse)() + 1, -1);
+
+    for (size_t r = 0; r < iiu_fine.size(); ++r) {
+        GOOSEFEM_ASSERT(iiu_fine(r) < row.size());
+        row[iiu_fine(r)] = r;
+    }
+
+    for (size_t c = 0; c < iiu_coarse.size(); ++c) {
+        GOOSEFEM_ASSERT(iiu_coarse(c) < col.size());
+        col[iiu_coarse(c)] = c;
+    }
+
+    // interpolate each row once (the first occurrence of the fine DOF)
+
+    std::vector<bool> done(iiu_fine.size(), false);
+    std::vector<double> N(nne);
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(iiu_fine.size() * nne);
+
+    for (size_t c = 0; c < coarse2fine.shape(0); ++c) {
+        for (size_t f = 0; f < coarse2fine.shape(1); ++f) {
+            size_t e = coarse2fine(c, f);
+            for (size_t n = 0; n < conn_f.shape(1); ++n) {
+                size_t m = conn_f(e, n);
+
+                // shape functions of the coarse element, at fine node "m"
+                std::fill(N.begin(), N.end(), 1.0);
+                for (size_t k = 0; k < nne; ++k) {
+                    for (size_t d = 0; d < ndim; ++d) {
+                        double x = coor_f(m, d) * scale[d] - coor_c(conn_c(c, k), d);
+                        N[k] *= std::max(0.0, 1.0 - std::abs(x) / h);
+                    }
+                }
+
+                for (size_t i = 0; i < ndim; ++i) {
+                    ptrdiff_t r = row[dofs_fine(m, i)];
+                    if (r < 0 || done[r]) {
+                        continue;
+                    }
+                    done[r] = true;
+                    for (size_t k = 0; k < nne; ++k) {
+                        ptrdiff_t j = col[dofs_coarse(conn_c(c, k), i)];
+                        if (j >= 0 && N[k] > 0.0) {
+                            triplets.emplace_back(r, j, N[k]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    Eigen::SparseMatrix<double> ret(iiu_fine.size(), iiu_coarse.size());
+    ret.setFromTriplets(triplets.begin(), triplets.end());
+    return ret;
+}
+
+template <class Map>
+inline Eigen::SparseMatrix<double> prolongation(
+    const Map& map,
+    const xt::xtensor<size_t, 2>& dofs_coarse,
+    const xt::xtensor<size_t, 2>& dofs_fine)
+{
+    return prolongation(
+        map,
+        dofs_coarse,
+        xt::arange<size_t>(xt::amax(dofs_coarse)() + 1),
+        dofs_fine,
+        xt::arange<size_t>(xt::amax(dofs_fine)() + 1));
+}
+
+} // namespace GooseFEM
+
+#endif
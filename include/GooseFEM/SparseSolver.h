@@ -0,0 +1,148 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_SPARSESOLVER_H
+#define GOOSEFEM_SPARSESOLVER_H
+
+#include "config.h"
+#include "AMG.h"
+#include "IterativeSolver.h"
+#include "MixedPrecision.h"
+#include "SupernodalLDLT.h"
+
+#include <chrono>
+#include <functional>
+#include <map>
+
+#include <Eigen/Eigen>
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+#include <Eigen/SparseLU>
+
+namespace GooseFEM {
+
+/*
+  Interface of a backend of "SparseSolver": a linear solver for a sparse matrix.
+  Implement to add a solver to the registry, see "SparseSolver::add".
+*/
+
+class SparseSolverBackend {
+public:
+    virtual ~SparseSolverBackend() = default;
+
+    // Factorize (or set-up) for matrix "A"
+    virtual void compute(const Eigen::SparseMatrix<double>& A) = 0;
+
+    // Solve "A * x = b" for the matrix "A" passed to "compute"
+    virtual Eigen::VectorXd solve(const Eigen::VectorXd& b) = 0;
+
+    // Solve using "x0" as initial guess (default: ignore "x0", as for direct solvers)
+    virtual Eigen::VectorXd solveWithGuess(const Eigen::VectorXd& b, const Eigen::VectorXd& x0);
+
+    // Status of the last "compute" or "solve"
+    virtual Eigen::ComputationInfo info() const = 0;
+
+    // Number of non-zeros of the factorization (zero for iterative solvers)
+    virtual size_t nnz() const;
+
+    // Number of iterations, and estimated relative residual, of the last "solve"
+    // (zero for direct solvers)
+    virtual size_t iterations() const;
+    virtual double error() const;
+};
+
+/*
+  Wrap a solver that follows Eigen's sparse solver concept ("compute", "solve", and "info"),
+  e.g. "SparseSolverEigen<Eigen::SparseLU<Eigen::SparseMatrix<double>>>".
+*/
+
+template <class Solver>
+class SparseSolverEigen : public SparseSolverBackend {
+public:
+    void compute(const Eigen::SparseMatrix<double>& A) override;
+    Eigen::VectorXd solve(const Eigen::VectorXd& b) override;
+    Eigen::VectorXd solveWithGuess(const Eigen::VectorXd& b, const Eigen::VectorXd& x0) override;
+    Eigen::ComputationInfo info() const override;
+    size_t nnz() const override;
+    size_t iterations() const override;
+    double error() const override;
+
+    // The wrapped solver (e.g. to set the tolerance of an iterative solver)
+    Solver& solver();
+
+private:
+    Solver m_solver;
+};
+
+/*
+  Sparse solver with a backend selected (by name) at runtime, e.g.:
+
+    GooseFEM::MatrixPartitionedSolver<GooseFEM::SparseSolver> Solver;
+    Solver.solver() = GooseFEM::SparseSolver("SparseLU");
+
+  Built-in backends:
+  -   "SimplicialLDLT" (default), "SimplicialLLT"
+  -   "SupernodalLDLT" (multi-threaded, see "SupernodalLDLT")
+  -   "SimplicialLDLTMixedPrecision" (single precision factorization, see "MixedPrecision")
+  -   "SparseLU"
+  -   "ConjugateGradient" (Jacobi preconditioner), "ConjugateGradientIncompleteCholesky",
+      "ConjugateGradientAMG" (without near-nullspace, see "AMG"), "BiCGSTAB"
+  -   "CholmodSupernodalLLT", "UmfPackLU", "PardisoLDLT": not built-in (they depend on external
+      libraries), register them using "SparseSolverSupport.h".
+
+  Backends can be added, see "SparseSolver::add". For each call, the wall-time is recorded.
+*/
+
+class SparseSolver {
+public:
+    // Factory of a backend
+    using Factory = std::function<std::unique_ptr<SparseSolverBackend>()>;
+
+    // Constructors
+    SparseSolver(); // "SimplicialLDLT"
+    SparseSolver(const std::string& name);
+
+    // Registry: add (or replace) a backend, check if a backend exists, list all backends (sorted)
+    static void add(const std::string& name, Factory factory);
+    static bool has(const std::string& name);
+    static std::vector<std::string> available();
+
+    // Name of the backend
+    std::string name() const;
+
+    // Solver concept (as Eigen), such that e.g. "MatrixSolver<SparseSolver>" can be used
+    void compute(const Eigen::SparseMatrix<double>& A);
+    Eigen::VectorXd solve(const Eigen::VectorXd& b);
+    Eigen::VectorXd solveWithGuess(const Eigen::VectorXd& b, const Eigen::VectorXd& x0);
+    Eigen::ComputationInfo info() const;
+
+    // Statistics
+    size_t nnz() const;          // number of non-zeros of the factorization
+    size_t iterations() const;   // number of iterations of the last "solve"
+    double error() const;        // estimated relative residual of the last "solve"
+    double time_compute() const; // wall-time of the last "compute" [s]
+    double time_solve() const;   // wall-time of the last "solve" [s]
+
+    // The backend (e.g. to "dynamic_cast" to a specific backend to change its settings)
+    SparseSolverBackend& backend();
+    const SparseSolverBackend& backend() const;
+
+private:
+    // Registry of backends (initialised with the built-in backends on first use)
+    static std::map<std::string, Factory>& registry();
+
+    std::string m_name;
+    std::unique_ptr<SparseSolverBackend> m_backend;
+    double m_time_compute = 0.0;
+    double m_time_solve = 0.0;
+};
+
+} // namespace GooseFEM
+
+#include "SparseSolver.hpp"
+
+#endif
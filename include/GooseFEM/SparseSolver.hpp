@@ -0,0 +1,313 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_SPARSESOLVER_HPP
+#define GOOSEFEM_SPARSESOLVER_HPP
+
+#include "SparseSolver.h"
+
+namespace GooseFEM {
+
+namespace detail {
+
+    // Number of non-zeros of the factorization (default: unknown/none)
+    template <class Solver>
+    inline size_t factor_nnz(const Solver&)
+    {
+        return 0;
+    }
+
+    template <class M, int UpLo, class O>
+    inline size_t factor_nnz(const Eigen::SimplicialLDLT<M, UpLo, O>& solver)
+    {
+        return static_cast<size_t>(solver.matrixL().nestedExpression().nonZeros());
+    }
+
+    template <class M, int UpLo, class O>
+    inline size_t factor_nnz(const Eigen::SimplicialLLT<M, UpLo, O>& solver)
+    {
+        return static_cast<size_t>(solver.matrixL().nestedExpression().nonZeros());
+    }
+
+    template <class M, class O>
+    inline size_t factor_nnz(const Eigen::SparseLU<M, O>& solver)
+    {
+        return static_cast<size_t>(solver.nnzL() + solver.nnzU());
+    }
+
+    inline size_t factor_nnz(const SupernodalLDLT& solver)
+    {
+        return solver.nnz();
+    }
+
+    template <class S>
+    inline size_t factor_nnz(const MixedPrecision<S>& solver)
+    {
+        return factor_nnz(solver.solver());
+    }
+
+    // Number of iterations and estimated error (default: direct solver)
+    template <class Solver>
+    inline size_t iterations(const Solver&)
+    {
+        return 0;
+    }
+
+    template <class M, int UpLo, class P>
+    inline size_t iterations(const Eigen::ConjugateGradient<M, UpLo, P>& solver)
+    {
+        return static_cast<size_t>(solver.iterations());
+    }
+
+    template <class M, class P>
+    inline size_t iterations(const Eigen::BiCGSTAB<M, P>& solver)
+    {
+        return static_cast<size_t>(solver.iterations());
+    }
+
+    template <class S>
+    inline size_t iterations(const MixedPrecision<S>& solver)
+    {
+        return solver.iterations();
+    }
+
+    template <class Solver>
+    inline double error(const Solver&)
+    {
+        return 0.0;
+    }
+
+    template <class M, int UpLo, class P>
+    inline double error(const Eigen::ConjugateGradient<M, UpLo, P>& solver)
+    {
+        return solver.error();
+    }
+
+    template <class M, class P>
+    inline double error(const Eigen::BiCGSTAB<M, P>& solver)
+    {
+        return solver.error();
+    }
+
+    template <class S>
+    inline double error(const MixedPrecision<S>& solver)
+    {
+        return solver.error();
+    }
+
+    template <class Solver>
+    inline std::unique_ptr<SparseSolverBackend> make_backend()
+    {
+        return std::unique_ptr<SparseSolverBackend>(new SparseSolverEigen<Solver>());
+    }
+
+    inline double elapsed(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+} // namespace detail
+
+inline Eigen::VectorXd
+SparseSolverBackend::solveWithGuess(const Eigen::VectorXd& b, const Eigen::VectorXd& x0)
+{
+    UNUSED(x0);
+    return this->solve(b);
+}
+
+inline size_t SparseSolverBackend::nnz() const
+{
+    return 0;
+}
+
+inline size_t SparseSolverBackend::iterations() const
+{
+    return 0;
+}
+
+inline double SparseSolverBackend::error() const
+{
+    return 0.0;
+}
+
+template <class Solver>
+inline void SparseSolverEigen<Solver>::compute(const Eigen::SparseMatrix<double>& A)
+{
+    m_solver.compute(A);
+}
+
+template <class Solver>
+inline Eigen::VectorXd SparseSolverEigen<Solver>::solve(const Eigen::VectorXd& b)
+{
+    return m_solver.solve(b);
+}
+
+template <class Solver>
+inline Eigen::VectorXd
+SparseSolverEigen<Solver>::solveWithGuess(const Eigen::VectorXd& b, const Eigen::VectorXd& x0)
+{
+    return detail::solve_with_guess(m_solver, b, x0);
+}
+
+template <class Solver>
+inline Eigen::ComputationInfo SparseSolverEigen<Solver>::info() const
+{
+    return m_solver.info();
+}
+
+template <class Solver>
+inline size_t SparseSolverEigen<Solver>::nnz() const
+{
+    return detail::factor_nnz(m_solver);
+}
+
+template <class Solver>
+inline size_t SparseSolverEigen<Solver>::iterations() const
+{
+    return detail::iterations(m_solver);
+}
+
+template <class Solver>
+inline double SparseSolverEigen<Solver>::error() const
+{
+    return detail::error(m_solver);
+}
+
+template <class Solver>
+inline Solver& SparseSolverEigen<Solver>::solver()
+{
+    return m_solver;
+}
+
+inline std::map<std::string, SparseSolver::Factory>& SparseSolver::registry()
+{
+    using SpMat = Eigen::SparseMatrix<double>;
+
+    static std::map<std::string, Factory> ret = {
+        {"SimplicialLDLT", detail::make_backend<Eigen::SimplicialLDLT<SpMat>>},
+        {"SimplicialLLT", detail::make_backend<Eigen::SimplicialLLT<SpMat>>},
+        {"SupernodalLDLT", detail::make_backend<SupernodalLDLT>},
+        {"SimplicialLDLTMixedPrecision", detail::make_backend<MixedPrecision<>>},
+        {"SparseLU", detail::make_backend<Eigen::SparseLU<SpMat>>},
+        {"ConjugateGradient",
+         detail::make_backend<Eigen::ConjugateGradient<SpMat, Eigen::Lower | Eigen::Upper>>},
+        {"ConjugateGradientAMG", detail::make_backend<PCG<AMG>>},
+        {"ConjugateGradientIncompleteCholesky",
+         detail::make_backend<PCG<Eigen::IncompleteCholesky<double>>>},
+        {"BiCGSTAB", detail::make_backend<Eigen::BiCGSTAB<SpMat>>},
+    };
+
+    return ret;
+}
+
+inline void SparseSolver::add(const std::string& name, Factory factory)
+{
+    registry()[name] = std::move(factory);
+}
+
+inline bool SparseSolver::has(const std::string& name)
+{
+    return registry().count(name) > 0;
+}
+
+inline std::vector<std::string> SparseSolver::available()
+{
+    std::vector<std::string> ret;
+
+    for (auto& item : registry()) {
+        ret.push_back(item.first);
+    }
+
+    return ret;
+}
+
+inline SparseSolver::SparseSolver() : SparseSolver("SimplicialLDLT")
+{
+}
+
+inline SparseSolver::SparseSolver(const std::string& name) : m_name(name)
+{
+    auto it = registry().find(name);
+
+    if (it == registry().end()) {
+        throw std::runtime_error("Unknown solver: '" + name + "'");
+    }
+
+    m_backend = it->second();
+}
+
+inline std::string SparseSolver::name() const
+{
+    return m_name;
+}
+
+inline void SparseSolver::compute(const Eigen::SparseMatrix<double>& A)
+{
+    auto start = std::chrono::steady_clock::now();
+    m_backend->compute(A);
+    m_time_compute = detail::elapsed(start);
+}
+
+inline Eigen::VectorXd SparseSolver::solve(const Eigen::VectorXd& b)
+{
+    auto start = std::chrono::steady_clock::now();
+    Eigen::VectorXd x = m_backend->solve(b);
+    m_time_solve = detail::elapsed(start);
+    return x;
+}
+
+inline Eigen::VectorXd
+SparseSolver::solveWithGuess(const Eigen::VectorXd& b, const Eigen::VectorXd& x0)
+{
+    auto start = std::chrono::steady_clock::now();
+    Eigen::VectorXd x = m_backend->solveWithGuess(b, x0);
+    m_time_solve = detail::elapsed(start);
+    return x;
+}
+
+inline Eigen::ComputationInfo SparseSolver::info() const
+{
+    return m_backend->info();
+}
+
+inline size_t SparseSolver::nnz() const
+{
+    return m_backend->nnz();
+}
+
+inline size_t SparseSolver::iterations() const
+{
+    return m_backend->iterations();
+}
+
+inline double SparseSolver::error() const
+{
+    return m_backend->error();
+}
+
+inline double SparseSolver::time_compute() const
+{
+    return m_time_compute;
+}
+
+inline double SparseSolver::time_solve() const
+{
+    return m_time_solve;
+}
+
+inline SparseSolverBackend& SparseSolver::backend()
+{
+    return *m_backend;
+}
+
+inline const SparseSolverBackend& SparseSolver::backend() const
+{
+    return *m_backend;
+}
+
+} // namespace GooseFEM
+
+#endif
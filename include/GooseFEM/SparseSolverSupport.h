@@ -0,0 +1,50 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_SPARSESOLVERSUPPORT_H
+#define GOOSEFEM_SPARSESOLVERSUPPORT_H
+
+#include "config.h"
+#include "SparseSolver.h"
+
+namespace GooseFEM {
+
+/*
+  Register the backends of "SparseSolver" that use an external library, through Eigen's support
+  modules. The module should be included before this header (and the library linked), and the
+  backend is registered explicitly, e.g.:
+
+    #include <Eigen/UmfPackSupport>
+    #include <GooseFEM/SparseSolverSupport.h>
+
+    GooseFEM::SparseSolverSupport::addUmfPackLU();
+    GooseFEM::SparseSolver solver("UmfPackLU");
+
+  A function only exists if its module is included. The registry itself does not depend on the
+  included modules, such that it is the same in all translation units.
+*/
+
+namespace SparseSolverSupport {
+
+    #ifdef EIGEN_CHOLMODSUPPORT_MODULE_H
+    void addCholmodSupernodalLLT(); // "CholmodSupernodalLLT"
+    #endif
+
+    #ifdef EIGEN_UMFPACKSUPPORT_MODULE_H
+    void addUmfPackLU(); // "UmfPackLU"
+    #endif
+
+    #ifdef EIGEN_PARDISOSUPPORT_MODULE_H
+    void addPardisoLDLT(); // "PardisoLDLT"
+    #endif
+
+} // namespace SparseSolverSupport
+
+} // namespace GooseFEM
+
+#include "SparseSolverSupport.hpp"
+
+#endif
@@ -0,0 +1,43 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_SPARSESOLVERSUPPORT_HPP
+#define GOOSEFEM_SPARSESOLVERSUPPORT_HPP
+
+#include "SparseSolverSupport.h"
+
+namespace GooseFEM {
+namespace SparseSolverSupport {
+
+    #ifdef EIGEN_CHOLMODSUPPORT_MODULE_H
+    inline void addCholmodSupernodalLLT()
+    {
+        SparseSolver::add(
+            "CholmodSupernodalLLT",
+            detail::make_backend<Eigen::CholmodSupernodalLLT<Eigen::SparseMatrix<double>>>);
+    }
+    #endif
+
+    #ifdef EIGEN_UMFPACKSUPPORT_MODULE_H
+    inline void addUmfPackLU()
+    {
+        SparseSolver::add(
+            "UmfPackLU", detail::make_backend<Eigen::UmfPackLU<Eigen::SparseMatrix<double>>>);
+    }
+    #endif
+
+    #ifdef EIGEN_PARDISOSUPPORT_MODULE_H
+    inline void addPardisoLDLT()
+    {
+        SparseSolver::add(
+            "PardisoLDLT", detail::make_backend<Eigen::PardisoLDLT<Eigen::SparseMatrix<double>>>);
+    }
+    #endif
+
+} // namespace SparseSolverSupport
+} // namespace GooseFEM
+
+#endif
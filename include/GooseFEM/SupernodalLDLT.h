@@ -0,0 +1,142 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_SUPERNODALLDLT_H
+#define GOOSEFEM_SUPERNODALLDLT_H
+
+#include "config.h"
+
+#include <Eigen/Eigen>
+#include <Eigen/OrderingMethods>
+#include <Eigen/Sparse>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace GooseFEM {
+
+/*
+  Sparse LDLT factorization "P * A * P^T = L * D * L^T" of a symmetric matrix (using its lower
+  triangle), without pivoting (as "Eigen::SimplicialLDLT"), using a multifrontal method:
+
+  -   The matrix is reordered using AMD, followed by a postorder of the elimination tree.
+
+  -   Columns with the same sparsity pattern of "L" are grouped in supernodes, such that each
+      supernode is factorized (and its contribution to the rest of the matrix is computed) using
+      dense (blocked) kernels on its frontal matrix.
+
+  -   Independent subtrees of the (supernodal) elimination tree are factorized in parallel.
+      The frontal matrices near the root, which are the largest, are factorized one after the
+      other, using parallel dense kernels instead.
+
+  The class follows Eigen's sparse solver concept, such that it can be used as solver of
+  "MatrixSolver", "MatrixPartitionedSolver", and "MatrixPartitionedTyingsSolver", e.g.:
+
+    GooseFEM::MatrixPartitionedSolver<GooseFEM::SupernodalLDLT> Solver;
+
+  Parallelisation uses OpenMP: compile with OpenMP enabled (e.g. "-fopenmp").
+*/
+
+class SupernodalLDLT {
+public:
+    // Constructors
+    SupernodalLDLT() = default;
+    SupernodalLDLT(const Eigen::SparseMatrix<double>& A); // "compute(A)"
+
+    // Symbolic analysis: ordering, elimination tree, supernodes, and their sparsity pattern
+    void analyzePattern(const Eigen::SparseMatrix<double>& A);
+
+    // Numerical factorization, for a matrix with the sparsity pattern passed to "analyzePattern"
+    void factorize(const Eigen::SparseMatrix<double>& A);
+
+    // Factorize, the symbolic analysis is only repeated if the sparsity pattern changed
+    void compute(const Eigen::SparseMatrix<double>& A);
+
+    // Solve "A * x = b", for one or several (columns of) right-hand-sides
+    template <class Rhs>
+    Eigen::Matrix<double, Eigen::Dynamic, Rhs::ColsAtCompileTime>
+    solve(const Eigen::MatrixBase<Rhs>& b) const;
+
+    // Status of the last factorization: "Eigen::NumericalIssue" if a zero pivot was encountered
+    Eigen::ComputationInfo info() const;
+
+    // Dimensions
+    Eigen::Index rows() const;
+    Eigen::Index cols() const;
+    size_t nsuper() const; // number of supernodes
+    size_t nnz() const;    // number of non-zeros of "L" (including the diagonal, which stores "D")
+
+    // The diagonal matrix "D" (in the permuted numbering)
+    const Eigen::VectorXd& vectorD() const;
+
+    // The permutation "P"
+    const Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int>& permutationP() const;
+
+private:
+    // Lower triangle of "P * A * P^T", with sorted row-indices
+    Eigen::SparseMatrix<double> permute(const Eigen::SparseMatrix<double>& A) const;
+
+    // Assemble and (partially) factorize the frontal matrix of supernode "K" (of the permuted
+    // lower triangle "C"), store its update matrix in "update[K]". Returns "false" for a zero
+    // pivot. The dense kernels are run in parallel if "parallel == true".
+    bool front(
+        const Eigen::SparseMatrix<double>& C,
+        size_t K,
+        std::vector<Eigen::MatrixXd>& update,
+        bool parallel);
+
+    // Solve "L * D * L^T * x = b" in place, for "x" in the permuted numbering
+    template <class T>
+    void solve_in_place(T& x) const;
+
+    // Check if the sparsity pattern of "A" equals the analyzed pattern
+    bool same_pattern(const Eigen::SparseMatrix<double>& A) const;
+
+private:
+    // Dimensions
+    size_t m_n = 0;      // number of rows (and columns)
+    size_t m_nsuper = 0; // number of supernodes
+
+    // Permutation, and analyzed sparsity pattern of the input
+    Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int> m_perm;
+    std::vector<Eigen::Index> m_outer;
+    std::vector<Eigen::Index> m_inner;
+
+    // Supernode "K": columns "m_super[K] <= j < m_super[K + 1]", sparsity pattern (row-numbers,
+    // sorted, the first rows are the supernode's columns) "m_rows[m_rows_ptr[K]: ...[K + 1]]"
+    std::vector<size_t> m_super;
+    std::vector<size_t> m_rows_ptr;
+    std::vector<size_t> m_rows;
+
+    // Supernodal elimination tree: parent (-1 for a root), children (in CSR storage), and the
+    // first supernode of the subtree rooted at "K" (the subtree is "m_first[K] <= k <= K")
+    std::vector<ptrdiff_t> m_parent;
+    std::vector<size_t> m_child_ptr;
+    std::vector<size_t> m_child;
+    std::vector<size_t> m_first;
+
+    // Scheduling: roots of subtrees factorized in parallel, followed by the remaining supernodes
+    // (in order) factorized using parallel dense kernels
+    std::vector<size_t> m_roots;
+    std::vector<size_t> m_top;
+
+    // Factorization: per supernode a dense column-major block [nrows, ncols] (offset
+    // "m_values_ptr[K]"), with "L" below the diagonal, and "D" on the diagonal
+    std::vector<size_t> m_values_ptr;
+    std::vector<double> m_values;
+    Eigen::VectorXd m_diag;
+
+    // Status
+    bool m_analyzed = false;
+    Eigen::ComputationInfo m_info = Eigen::InvalidInput;
+};
+
+} // namespace GooseFEM
+
+#include "SupernodalLDLT.hpp"
+
+#endif
@@ -0,0 +1,610 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_SUPERNODALLDLT_HPP
+#define GOOSEFEM_SUPERNODALLDLT_HPP
+
+#include "SupernodalLDLT.h"
+
+namespace GooseFEM {
+
+namespace detail {
+
+    // Number of threads available for parallel regions
+    inline size_t num_threads()
+    {
+        #ifdef _OPENMP
+        return static_cast<size_t>(omp_get_max_threads());
+        #else
+        return 1;
+        #endif
+    }
+
+    // Block-size of the dense kernels
+    constexpr size_t ldlt_block = 64;
+
+    // Blocked right-looking LDLT of the first "nc" columns of the (lower triangle of the) dense
+    // symmetric matrix "F" [m, m]. On output: "L" below the diagonal, "D" on the diagonal of the
+    // first "nc" columns, and the Schur complement in "F[nc:, nc:]" (lower triangle).
+    // Returns "false" for a zero pivot.
+    inline bool partial_ldlt(Eigen::MatrixXd& F, size_t nc, bool parallel)
+    {
+        size_t m = static_cast<size_t>(F.rows());
+        size_t nb = ldlt_block;
+
+        for (size_t k0 = 0; k0 < nc; k0 += nb) {
+
+            size_t kb = std::min(nb, nc - k0);
+            size_t k1 = k0 + kb;
+
+            // panel: left-looking within the columns "k0 <= j < k1"
+            for (size_t j = k0; j < k1; ++j) {
+                size_t t = j - k0;
+                size_t r = m - j;
+
+                if (t > 0) {
+                    Eigen::VectorXd w =
+                        F.block(j, k0, 1, t).transpose().cwiseProduct(F.diagonal().segment(k0, t));
+                    F.block(j, j, r, 1).noalias() -= F.block(j, k0, r, t) * w;
+                }
+
+                double d = F(j, j);
+
+                if (d == 0.0) {
+                    return false;
+                }
+
+                F.block(j + 1, j, r - 1, 1) /= d;
+            }
+
+            if (k1 == m) {
+                continue;
+            }
+
+            // trailing update (lower triangle, per block of columns)
+            size_t n = m - k1;
+            size_t ncb = (n + nb - 1) / nb;
+            Eigen::MatrixXd W = F.block(k1, k0, n, kb) * F.diagonal().segment(k0, kb).asDiagonal();
+
+            #pragma omp parallel for schedule(dynamic) if (parallel)
+            for (size_t cb = 0; cb < ncb; ++cb) {
+                size_t c0 = cb * nb;
+                size_t cw = std::min(nb, n - c0);
+                F.block(k1 + c0, k1 + c0, n - c0, cw).noalias() -=
+                    W.bottomRows(n - c0) * F.block(k1 + c0, k0, cw, kb).transpose();
+            }
+        }
+
+        return true;
+    }
+
+} // namespace detail
+
+inline SupernodalLDLT::SupernodalLDLT(const Eigen::SparseMatrix<double>& A)
+{
+    this->compute(A);
+}
+
+inline void SupernodalLDLT::compute(const Eigen::SparseMatrix<double>& A)
+{
+    if (!m_analyzed || !this->same_pattern(A)) {
+        this->analyzePattern(A);
+    }
+
+    this->factorize(A);
+}
+
+inline bool SupernodalLDLT::same_pattern(const Eigen::SparseMatrix<double>& A) const
+{
+    if (!A.isCompressed() || static_cast<size_t>(A.rows()) != m_n) {
+        return false;
+    }
+
+    if (static_cast<size_t>(A.nonZeros()) != m_inner.size()) {
+        return false;
+    }
+
+    return std::equal(A.outerIndexPtr(), A.outerIndexPtr() + m_n + 1, m_outer.begin()) &&
+           std::equal(A.innerIndexPtr(), A.innerIndexPtr() + m_inner.size(), m_inner.begin());
+}
+
+inline void SupernodalLDLT::analyzePattern(const Eigen::SparseMatrix<double>& A)
+{
+    using SpMat = Eigen::SparseMatrix<double>;
+    using Perm = Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int>;
+
+    GOOSEFEM_ASSERT(A.rows() == A.cols());
+
+    size_t n = static_cast<size_t>(A.rows());
+    m_n = n;
+    m_analyzed = false;
+
+    // store pattern (to skip the analysis for a new matrix with the same pattern)
+
+    m_outer.clear();
+    m_inner.clear();
+
+    if (A.isCompressed()) {
+        m_outer.assign(A.outerIndexPtr(), A.outerIndexPtr() + n + 1);
+        m_inner.assign(A.innerIndexPtr(), A.innerIndexPtr() + A.nonZeros());
+    }
+
+    // fill-reducing ordering
+
+    Perm P;
+    {
+        SpMat S = A.selfadjointView<Eigen::Lower>();
+        Perm Pinv;
+        Eigen::AMDOrdering<int> ordering;
+        ordering(S, Pinv);
+        P = Pinv.inverse();
+    }
+
+    // elimination tree (of the upper triangle, stored per column)
+
+    std::vector<ptrdiff_t> parent(n, -1);
+    {
+        SpMat C(n, n);
+        C.selfadjointView<Eigen::Upper>() =
+            A.selfadjointView<Eigen::Lower>().twistedBy(P);
+
+        std::vector<ptrdiff_t> ancestor(n, -1);
+
+        for (size_t k = 0; k < n; ++k) {
+            for (SpMat::InnerIterator it(C, k); it; ++it) {
+                ptrdiff_t i = it.row();
+                while (i != -1 && i < static_cast<ptrdiff_t>(k)) {
+                    ptrdiff_t inext = ancestor[i];
+                    ancestor[i] = k;
+                    if (inext == -1) {
+                        parent[i] = k;
+                    }
+                    i = inext;
+                }
+            }
+        }
+    }
+
+    // postorder of the elimination tree, combined with the fill-reducing ordering
+
+    std::vector<size_t> post_inv(n);
+    {
+        std::vector<ptrdiff_t> head(n, -1);
+        std::vector<ptrdiff_t> next(n, -1);
+        std::vector<size_t> stack;
+        size_t k = 0;
+
+        for (size_t j = n; j-- > 0;) {
+            if (parent[j] != -1) {
+                next[j] = head[parent[j]];
+                head[parent[j]] = j;
+            }
+        }
+
+        for (size_t root = 0; root < n; ++root) {
+            if (parent[root] != -1) {
+                continue;
+            }
+            stack.push_back(root);
+            while (!stack.empty()) {
+                size_t p = stack.back();
+                ptrdiff_t i = head[p];
+                if (i == -1) {
+                    stack.pop_back();
+                    post_inv[p] = k++;
+                }
+                else {
+                    head[p] = next[i];
+                    stack.push_back(i);
+                }
+            }
+        }
+    }
+
+    m_perm.resize(n);
+
+    for (size_t i = 0; i < n; ++i) {
+        m_perm.indices()(i) = static_cast<int>(post_inv[P.indices()(i)]);
+    }
+
+    {
+        std::vector<ptrdiff_t> tmp(n, -1);
+        for (size_t j = 0; j < n; ++j) {
+            if (parent[j] != -1) {
+                tmp[post_inv[j]] = post_inv[parent[j]];
+            }
+        }
+        parent = std::move(tmp);
+    }
+
+    SpMat C = this->permute(A);
+
+    // (fundamental) supernodes, and their sparsity pattern:
+    // column "j" is added to the supernode of "j - 1" if "j - 1" is its only child, and the
+    // sparsity pattern of "j" is that of "j - 1" (without "j - 1")
+
+    std::vector<size_t> nchild(n, 0);
+
+    for (size_t j = 0; j < n; ++j) {
+        if (parent[j] != -1) {
+            nchild[parent[j]]++;
+        }
+    }
+
+    m_super.clear();
+    m_rows_ptr.assign(1, 0);
+    m_rows.clear();
+
+    std::vector<size_t> mark(n, std::numeric_limits<size_t>::max());
+    std::vector<ptrdiff_t> child_head(n, -1); // finalized supernodes per parent column
+    std::vector<ptrdiff_t> child_next;
+    size_t K = 0;
+
+    for (size_t j = 0; j < n; ++j) {
+
+        if (j > 0 && parent[j - 1] == static_cast<ptrdiff_t>(j) && nchild[j] == 1) {
+            bool join = true;
+            for (SpMat::InnerIterator it(C, j); it; ++it) {
+                if (mark[it.row()] != K) {
+                    join = false;
+                    break;
+                }
+            }
+            if (join) {
+                continue;
+            }
+        }
+
+        // finalize the previous supernode
+        if (j > 0 && parent[j - 1] != -1) {
+            child_next[K] = child_head[parent[j - 1]];
+            child_head[parent[j - 1]] = K;
+        }
+
+        // new supernode: merge the pattern of column "j" and that of the child supernodes
+        K = m_super.size();
+        m_super.push_back(j);
+        child_next.push_back(-1);
+        size_t start = m_rows.size();
+        mark[j] = K;
+        m_rows.push_back(j);
+
+        for (SpMat::InnerIterator it(C, j); it; ++it) {
+            size_t i = it.row();
+            if (mark[i] != K) {
+                mark[i] = K;
+                m_rows.push_back(i);
+            }
+        }
+
+        for (ptrdiff_t c = child_head[j]; c != -1; c = child_next[c]) {
+            size_t nc = m_super[c + 1] - m_super[c];
+            for (size_t r = m_rows_ptr[c] + nc; r < m_rows_ptr[c + 1]; ++r) {
+                size_t i = m_rows[r];
+                if (mark[i] != K) {
+                    mark[i] = K;
+                    m_rows.push_back(i);
+                }
+            }
+        }
+
+        std::sort(m_rows.begin() + start, m_rows.end());
+        m_rows_ptr.push_back(m_rows.size());
+    }
+
+    m_nsuper = m_super.size();
+    m_super.push_back(n);
+
+    // supernodal elimination tree
+
+    std::vector<size_t> col2super(n);
+
+    for (size_t k = 0; k < m_nsuper; ++k) {
+        for (size_t j = m_super[k]; j < m_super[k + 1]; ++j) {
+            col2super[j] = k;
+        }
+    }
+
+    m_parent.assign(m_nsuper, -1);
+    m_child_ptr.assign(m_nsuper + 1, 0);
+    m_child.resize(m_nsuper);
+
+    for (size_t k = 0; k < m_nsuper; ++k) {
+        ptrdiff_t p = parent[m_super[k + 1] - 1];
+        if (p != -1) {
+            m_parent[k] = col2super[p];
+            m_child_ptr[m_parent[k] + 1]++;
+        }
+    }
+
+    std::partial_sum(m_child_ptr.begin(), m_child_ptr.end(), m_child_ptr.begin());
+
+    {
+        std::vector<size_t> cursor(m_child_ptr.begin(), m_child_ptr.end() - 1);
+        for (size_t k = 0; k < m_nsuper; ++k) {
+            if (m_parent[k] != -1) {
+                m_child[cursor[m_parent[k]]++] = k;
+            }
+        }
+    }
+
+    // storage of the factorization
+
+    m_values_ptr.assign(m_nsuper + 1, 0);
+
+    for (size_t k = 0; k < m_nsuper; ++k) {
+        size_t nc = m_super[k + 1] - m_super[k];
+        size_t m = m_rows_ptr[k + 1] - m_rows_ptr[k];
+        m_values_ptr[k + 1] = m_values_ptr[k] + m * nc;
+    }
+
+    // scheduling: estimated work of each subtree (the subtree of "k" is "m_first[k] <= i <= k",
+    // as the supernodes are in postorder)
+
+    std::vector<double> work(m_nsuper, 0.0);
+    std::vector<size_t> size(m_nsuper, 1);
+    double total = 0.0;
+
+    for (size_t k = 0; k < m_nsuper; ++k) {
+        double nc = static_cast<double>(m_super[k + 1] - m_super[k]);
+        double m = static_cast<double>(m_rows_ptr[k + 1] - m_rows_ptr[k]);
+        work[k] += nc * m * m;
+        total += nc * m * m;
+        if (m_parent[k] != -1) {
+            work[m_parent[k]] += work[k];
+            size[m_parent[k]] += size[k];
+        }
+    }
+
+    m_first.resize(m_nsuper);
+
+    for (size_t k = 0; k < m_nsuper; ++k) {
+        m_first[k] = k + 1 - size[k];
+    }
+
+    size_t nthreads = detail::num_threads();
+    double threshold = total / static_cast<double>(4 * nthreads);
+    std::vector<bool> top(m_nsuper, false);
+
+    m_roots.clear();
+    m_top.clear();
+
+    for (size_t k = 0; k < m_nsuper; ++k) {
+        top[k] = nthreads > 1 && work[k] > threshold;
+        if (top[k]) {
+            m_top.push_back(k);
+        }
+    }
+
+    for (size_t k = 0; k < m_nsuper; ++k) {
+        if (!top[k] && (m_parent[k] == -1 || top[m_parent[k]])) {
+            m_roots.push_back(k);
+        }
+    }
+
+    std::sort(m_roots.begin(), m_roots.end(), [&](size_t a, size_t b) {
+        return work[a] > work[b];
+    });
+
+    m_analyzed = true;
+}
+
+inline Eigen::SparseMatrix<double>
+SupernodalLDLT::permute(const Eigen::SparseMatrix<double>& A) const
+{
+    Eigen::SparseMatrix<double> C(m_n, m_n);
+    C.selfadjointView<Eigen::Lower>() = A.selfadjointView<Eigen::Lower>().twistedBy(m_perm);
+
+    // sort the row-indices (by transposing twice)
+    Eigen::SparseMatrix<double, Eigen::RowMajor> T = C;
+    return T;
+}
+
+inline bool SupernodalLDLT::front(
+    const Eigen::SparseMatrix<double>& C,
+    size_t K,
+    std::vector<Eigen::MatrixXd>& update,
+    bool parallel)
+{
+    size_t f = m_super[K];
+    size_t l = m_super[K + 1];
+    size_t nc = l - f;
+    size_t m = m_rows_ptr[K + 1] - m_rows_ptr[K];
+    const size_t* rows = &m_rows[m_rows_ptr[K]];
+
+    Eigen::MatrixXd F = Eigen::MatrixXd::Zero(m, m);
+
+    // assemble the columns of the matrix
+    for (size_t j = f; j < l; ++j) {
+        size_t a = j - f;
+        for (Eigen::SparseMatrix<double>::InnerIterator it(C, j); it; ++it) {
+            size_t i = it.row();
+            while (rows[a] < i) {
+                ++a;
+            }
+            F(a, j - f) += it.value();
+        }
+    }
+
+    // extend-add the update matrices of the children
+    for (size_t c = m_child_ptr[K]; c < m_child_ptr[K + 1]; ++c) {
+        size_t child = m_child[c];
+        size_t cnc = m_super[child + 1] - m_super[child];
+        size_t cm = m_rows_ptr[child + 1] - m_rows_ptr[child] - cnc;
+        const size_t* crows = &m_rows[m_rows_ptr[child] + cnc];
+        Eigen::MatrixXd& U = update[child];
+
+        std::vector<size_t> pos(cm);
+
+        for (size_t a = 0, b = 0; b < cm; ++b) {
+            while (rows[a] < crows[b]) {
+                ++a;
+            }
+            pos[b] = a;
+        }
+
+        #pragma omp parallel for if (parallel)
+        for (size_t jb = 0; jb < cm; ++jb) {
+            for (size_t ib = jb; ib < cm; ++ib) {
+                F(pos[ib], pos[jb]) += U(ib, jb);
+            }
+        }
+
+        U.resize(0, 0);
+    }
+
+    bool ret = detail::partial_ldlt(F, nc, parallel);
+
+    Eigen::Map<Eigen::MatrixXd>(&m_values[m_values_ptr[K]], m, nc) = F.leftCols(nc);
+    m_diag.segment(f, nc) = F.diagonal().head(nc);
+
+    if (m_parent[K] != -1) {
+        update[K] = F.bottomRightCorner(m - nc, m - nc);
+    }
+
+    return ret;
+}
+
+inline void SupernodalLDLT::factorize(const Eigen::SparseMatrix<double>& A)
+{
+    GOOSEFEM_CHECK(m_analyzed);
+    GOOSEFEM_ASSERT(static_cast<size_t>(A.rows()) == m_n);
+    GOOSEFEM_ASSERT(static_cast<size_t>(A.cols()) == m_n);
+
+    Eigen::SparseMatrix<double> C = this->permute(A);
+
+    m_values.resize(m_values_ptr[m_nsuper]);
+    m_diag.resize(m_n);
+
+    std::vector<Eigen::MatrixXd> update(m_nsuper);
+    size_t nfail = 0;
+
+    // independent subtrees in parallel
+    #pragma omp parallel for schedule(dynamic) reduction(+ : nfail)
+    for (size_t r = 0; r < m_roots.size(); ++r) {
+        for (size_t k = m_first[m_roots[r]]; k <= m_roots[r]; ++k) {
+            if (!this->front(C, k, update, false)) {
+                nfail++;
+            }
+        }
+    }
+
+    // remaining supernodes using parallel dense kernels
+    for (auto& k : m_top) {
+        if (!this->front(C, k, update, true)) {
+            nfail++;
+        }
+    }
+
+    m_info = nfail == 0 ? Eigen::Success : Eigen::NumericalIssue;
+}
+
+template <class T>
+inline void SupernodalLDLT::solve_in_place(T& x) const
+{
+    using Block = Eigen::Matrix<double, Eigen::Dynamic, T::ColsAtCompileTime>;
+
+    // forward substitution: "L * y = b"
+    for (size_t K = 0; K < m_nsuper; ++K) {
+        size_t f = m_super[K];
+        size_t nc = m_super[K + 1] - f;
+        size_t m = m_rows_ptr[K + 1] - m_rows_ptr[K];
+        const size_t* rows = &m_rows[m_rows_ptr[K]];
+        Eigen::Map<const Eigen::MatrixXd> L(&m_values[m_values_ptr[K]], m, nc);
+
+        L.topRows(nc).template triangularView<Eigen::UnitLower>().solveInPlace(
+            x.middleRows(f, nc));
+
+        if (m > nc) {
+            Block tmp = L.bottomRows(m - nc) * x.middleRows(f, nc);
+            for (size_t a = nc; a < m; ++a) {
+                x.row(rows[a]) -= tmp.row(a - nc);
+            }
+        }
+    }
+
+    // diagonal: "D * z = y"
+    x = m_diag.asDiagonal().inverse() * x;
+
+    // backward substitution: "L^T * x = z"
+    for (size_t K = m_nsuper; K-- > 0;) {
+        size_t f = m_super[K];
+        size_t nc = m_super[K + 1] - f;
+        size_t m = m_rows_ptr[K + 1] - m_rows_ptr[K];
+        const size_t* rows = &m_rows[m_rows_ptr[K]];
+        Eigen::Map<const Eigen::MatrixXd> L(&m_values[m_values_ptr[K]], m, nc);
+
+        if (m > nc) {
+            Block tmp(m - nc, x.cols());
+            for (size_t a = nc; a < m; ++a) {
+                tmp.row(a - nc) = x.row(rows[a]);
+            }
+            x.middleRows(f, nc).noalias() -= L.bottomRows(m - nc).transpose() * tmp;
+        }
+
+        L.topRows(nc).transpose().template triangularView<Eigen::UnitUpper>().solveInPlace(
+            x.middleRows(f, nc));
+    }
+}
+
+template <class Rhs>
+inline Eigen::Matrix<double, Eigen::Dynamic, Rhs::ColsAtCompileTime>
+SupernodalLDLT::solve(const Eigen::MatrixBase<Rhs>& b) const
+{
+    GOOSEFEM_ASSERT(static_cast<size_t>(b.rows()) == m_n);
+
+    Eigen::Matrix<double, Eigen::Dynamic, Rhs::ColsAtCompileTime> x = m_perm * b;
+    this->solve_in_place(x);
+    return m_perm.transpose() * x;
+}
+
+inline Eigen::ComputationInfo SupernodalLDLT::info() const
+{
+    return m_info;
+}
+
+inline Eigen::Index SupernodalLDLT::rows() const
+{
+    return static_cast<Eigen::Index>(m_n);
+}
+
+inline Eigen::Index SupernodalLDLT::cols() const
+{
+    return static_cast<Eigen::Index>(m_n);
+}
+
+inline size_t SupernodalLDLT::nsuper() const
+{
+    return m_nsuper;
+}
+
+inline size_t SupernodalLDLT::nnz() const
+{
+    size_t ret = 0;
+
+    for (size_t k = 0; k < m_nsuper; ++k) {
+        size_t nc = m_super[k + 1] - m_super[k];
+        size_t m = m_rows_ptr[k + 1] - m_rows_ptr[k];
+        ret += m * nc - nc * (nc - 1) / 2;
+    }
+
+    return ret;
+}
+
+inline const Eigen::VectorXd& SupernodalLDLT::vectorD() const
+{
+    return m_diag;
+}
+
+inline const Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int>&
+SupernodalLDLT::permutationP() const
+{
+    return m_perm;
+}
+
+} // namespace GooseFEM
+
+#endif
@@ -0,0 +1,142 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_TOPOLOGY_H
+#define GOOSEFEM_TOPOLOGY_H
+
+#include "config.h"
+
+namespace GooseFEM {
+
+/*
+  Mesh topology: connectivity, DOF-numbers, and (optionally) the partitioning of the DOFs in
+  unknown and prescribed DOFs. The object is immutable, such that one instance can be shared by
+  several "Vector", "VectorPartitioned", "Matrix", ... objects, e.g.:
+
+    auto topo = std::make_shared<const GooseFEM::Topology>(conn, dofs, iip);
+    GooseFEM::VectorPartitioned vector(topo);
+    GooseFEM::MatrixPartitioned K(topo);
+*/
+
+class Topology {
+public:
+    // Constructors. The arrays are stored as "index_type" (see GOOSEFEM_INDEX_TYPE): "size_t"
+    // arrays are converted, i.e. copied (which costs one temporary array of each). Use the rvalue
+    // overloads to move "index_type" arrays in without any copy. (If "index_type" is "size_t"
+    // these overloads are the ones taking "size_t" rvalues.)
+    // Optionally ("elementwise = true") the DOF-numbers per element are precomputed, see
+    // "elemdofs()", which avoids the double indirection "dofs(conn(e, m), i)" in element-level
+    // gather/scatter at the cost of one (or if partitioned two) extra [nelem, nne * ndim] arrays.
+    Topology() = default;
+
+    Topology(
+        const xt::xtensor<size_t, 2>& conn,
+        const xt::xtensor<size_t, 2>& dofs,
+        bool elementwise = false);
+
+    Topology(
+        xt::xtensor<index_type, 2>&& conn,
+        xt::xtensor<index_type, 2>&& dofs,
+        bool elementwise = false);
+
+    Topology(
+        const xt::xtensor<size_t, 2>& conn,
+        const xt::xtensor<size_t, 2>& dofs,
+        const xt::xtensor<size_t, 1>& iip,
+        bool elementwise = false);
+
+    Topology(
+        xt::xtensor<index_type, 2>&& conn,
+        xt::xtensor<index_type, 2>&& dofs,
+        xt::xtensor<index_type, 1>&& iip,
+        bool elementwise = false);
+
+    // Dimensions
+    size_t nelem() const; // number of elements
+    size_t nne() const;   // number of nodes per element
+    size_t nnode() const; // number of nodes
+    size_t ndim() const;  // number of dimensions
+    size_t ndof() const;  // number of DOFs
+    size_t nnu() const;   // number of unknown DOFs (== ndof if not partitioned)
+    size_t nnp() const;   // number of prescribed DOFs (== 0 if not partitioned)
+
+    // Check if the DOFs are partitioned in unknown and prescribed DOFs
+    bool partitioned() const;
+
+    // Check if the DOFs are numbered in partitioned order: "iiu == arange(nnu)" and
+    // "iip == nnu + arange(nnp)" (i.e. "dofs == part"), such that "dofval = [dofval_u, dofval_p]".
+    // Such numbering is obtained using "Mesh::Reorder({iiu, iip}).get(dofs)".
+    bool contiguous() const;
+
+    // Bookkeeping (references, the data is owned by this object)
+    const xt::xtensor<index_type, 2>& conn() const; // connectivity [nelem, nne]
+    const xt::xtensor<index_type, 2>& dofs() const; // DOF-numbers per node [nnode, ndim]
+
+    // Partitioning (only available if partitioned)
+    const xt::xtensor<index_type, 1>& iiu() const;  // unknown DOFs [nnu]
+    const xt::xtensor<index_type, 1>& iip() const;  // prescribed DOFs [nnp]
+    const xt::xtensor<index_type, 2>& part() const; // renumbered DOFs per node [nnode, ndim]
+
+    // Check if the DOF-numbers per element are precomputed (see constructor)
+    bool elementwise() const;
+
+    // DOF-numbers per element, flattened: "elemdofs(e, m * ndim + i) == dofs(conn(e, m), i)"
+    // (only available if "elementwise()")
+    const xt::xtensor<index_type, 2>& elemdofs() const; // [nelem, nne * ndim]
+
+    // Idem, using the renumbered DOFs "part" (only available if "elementwise()" and partitioned)
+    const xt::xtensor<index_type, 2>& elempart() const; // [nelem, nne * ndim]
+
+    // DOF-number of node "m" of element "e" in direction "i": "dofs(conn(e, m), i)" or
+    // "part(conn(e, m), i)", read from the precomputed arrays if "elementwise()"
+    index_type elemdofs(size_t e, size_t m, size_t i) const;
+    index_type elempart(size_t e, size_t m, size_t i) const;
+
+private:
+    // Set dimensions and derived bookkeeping
+    void init();
+
+    // Flatten DOF-numbers per node to DOF-numbers per element [nelem, nne * ndim]
+    xt::xtensor<index_type, 2> flatten(const xt::xtensor<index_type, 2>& dofs) const;
+
+private:
+    // Bookkeeping
+    xt::xtensor<index_type, 2> m_conn; // connectivity                      [nelem, nne ]
+    xt::xtensor<index_type, 2> m_dofs; // DOF-numbers per node              [nnode, ndim]
+    xt::xtensor<index_type, 1> m_iiu;  // DOF-numbers that are unknown      [nnu]
+    xt::xtensor<index_type, 1> m_iip;  // DOF-numbers that are prescribed   [nnp]
+
+    // DOFs per node, such that iiu = arange(nnu), iip = nnu + arange(nnp)
+    xt::xtensor<index_type, 2> m_part;
+
+    // DOFs per element (of "m_dofs" and "m_part" respectively), only if "m_elementwise"
+    xt::xtensor<index_type, 2> m_elemdofs; // [nelem, nne * ndim]
+    xt::xtensor<index_type, 2> m_elempart; // [nelem, nne * ndim]
+
+    // Dimensions
+    size_t m_nelem; // number of elements
+    size_t m_nne;   // number of nodes per element
+    size_t m_nnode; // number of nodes
+    size_t m_ndim;  // number of dimensions
+    size_t m_ndof;  // number of DOFs
+    size_t m_nnu;   // number of unknown DOFs
+    size_t m_nnp;   // number of prescribed DOFs
+
+    // Signal if the DOFs are partitioned
+    bool m_partitioned = false;
+
+    // Signal if the DOFs are numbered in partitioned order
+    bool m_contiguous = false;
+
+    // Signal if the DOFs per element are precomputed
+    bool m_elementwise = false;
+};
+
+} // namespace GooseFEM
+
+#include "Topology.hpp"
+
+#endif
@@ -0,0 +1,220 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_TOPOLOGY_HPP
+#define GOOSEFEM_TOPOLOGY_HPP
+
+#include "Mesh.h"
+#include "Topology.h"
+
+namespace GooseFEM {
+
+inline Topology::Topology(
+    const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 2>& dofs, bool elementwise)
+    : m_conn(conn), m_dofs(dofs), m_elementwise(elementwise)
+{
+    init();
+}
+
+inline Topology::Topology(
+    xt::xtensor<index_type, 2>&& conn, xt::xtensor<index_type, 2>&& dofs, bool elementwise)
+    : m_conn(std::move(conn)), m_dofs(std::move(dofs)), m_elementwise(elementwise)
+{
+    init();
+}
+
+inline Topology::Topology(
+    const xt::xtensor<size_t, 2>& conn,
+    const xt::xtensor<size_t, 2>& dofs,
+    const xt::xtensor<size_t, 1>& iip,
+    bool elementwise)
+    : m_conn(conn), m_dofs(dofs), m_iip(iip), m_partitioned(true), m_elementwise(elementwise)
+{
+    init();
+}
+
+inline Topology::Topology(
+    xt::xtensor<index_type, 2>&& conn,
+    xt::xtensor<index_type, 2>&& dofs,
+    xt::xtensor<index_type, 1>&& iip,
+    bool elementwise)
+    : m_conn(std::move(conn)),
+      m_dofs(std::move(dofs)),
+      m_iip(std::move(iip)),
+      m_partitioned(true),
+      m_elementwise(elementwise)
+{
+    init();
+}
+
+inline void Topology::init()
+{
+    m_nelem = m_conn.shape(0);
+    m_nne = m_conn.shape(1);
+    m_nnode = m_dofs.shape(0);
+    m_ndim = m_dofs.shape(1);
+
+    // all node and DOF numbers must be representable by "index_type"
+    GOOSEFEM_CHECK(m_nnode * m_ndim <= static_cast<size_t>(std::numeric_limits<index_type>::max()));
+
+    m_ndof = static_cast<size_t>(xt::amax(m_dofs)()) + 1;
+    m_nnu = m_ndof;
+    m_nnp = 0;
+
+    GOOSEFEM_ASSERT(static_cast<size_t>(xt::amax(m_conn)()) + 1 <= m_nnode);
+    GOOSEFEM_ASSERT(m_ndof <= m_nnode * m_ndim);
+
+    if (m_elementwise) {
+        m_elemdofs = this->flatten(m_dofs);
+    }
+
+    if (!m_partitioned) {
+        return;
+    }
+
+    m_iiu = xt::setdiff1d(m_dofs, m_iip);
+    m_nnp = m_iip.size();
+    m_nnu = m_iiu.size();
+    m_part = Mesh::Reorder({m_iiu, m_iip}).apply(m_dofs);
+
+    if (m_elementwise) {
+        m_elempart = this->flatten(m_part);
+    }
+
+    m_contiguous = xt::all(xt::equal(m_iiu, xt::arange<size_t>(m_nnu))) &&
+                   xt::all(xt::equal(m_iip, xt::arange<size_t>(m_nnu, m_nnu + m_nnp)));
+
+    GOOSEFEM_ASSERT(m_nnp == 0 || xt::amax(m_iip)() <= xt::amax(m_dofs)());
+}
+
+inline xt::xtensor<index_type, 2> Topology::flatten(const xt::xtensor<index_type, 2>& dofs) const
+{
+    xt::xtensor<index_type, 2> ret = xt::empty<index_type>({m_nelem, m_nne * m_ndim});
+
+    #pragma omp parallel for
+    for (size_t e = 0; e < m_nelem; ++e) {
+        for (size_t m = 0; m < m_nne; ++m) {
+            for (size_t i = 0; i < m_ndim; ++i) {
+                ret(e, m * m_ndim + i) = dofs(m_conn(e, m), i);
+            }
+        }
+    }
+
+    return ret;
+}
+
+inline size_t Topology::nelem() const
+{
+    return m_nelem;
+}
+
+inline size_t Topology::nne() const
+{
+    return m_nne;
+}
+
+inline size_t Topology::nnode() const
+{
+    return m_nnode;
+}
+
+inline size_t Topology::ndim() const
+{
+    return m_ndim;
+}
+
+inline size_t Topology::ndof() const
+{
+    return m_ndof;
+}
+
+inline size_t Topology::nnu() const
+{
+    return m_nnu;
+}
+
+inline size_t Topology::nnp() const
+{
+    return m_nnp;
+}
+
+inline bool Topology::partitioned() const
+{
+    return m_partitioned;
+}
+
+inline bool Topology::contiguous() const
+{
+    return m_contiguous;
+}
+
+inline const xt::xtensor<index_type, 2>& Topology::conn() const
+{
+    return m_conn;
+}
+
+inline const xt::xtensor<index_type, 2>& Topology::dofs() const
+{
+    return m_dofs;
+}
+
+inline const xt::xtensor<index_type, 1>& Topology::iiu() const
+{
+    GOOSEFEM_ASSERT(m_partitioned);
+    return m_iiu;
+}
+
+inline const xt::xtensor<index_type, 1>& Topology::iip() const
+{
+    GOOSEFEM_ASSERT(m_partitioned);
+    return m_iip;
+}
+
+inline const xt::xtensor<index_type, 2>& Topology::part() const
+{
+    GOOSEFEM_ASSERT(m_partitioned);
+    return m_part;
+}
+
+inline bool Topology::elementwise() const
+{
+    return m_elementwise;
+}
+
+inline const xt::xtensor<index_type, 2>& Topology::elemdofs() const
+{
+    GOOSEFEM_ASSERT(m_elementwise);
+    return m_elemdofs;
+}
+
+inline const xt::xtensor<index_type, 2>& Topology::elempart() const
+{
+    GOOSEFEM_ASSERT(m_elementwise);
+    GOOSEFEM_ASSERT(m_partitioned);
+    return m_elempart;
+}
+
+inline index_type Topology::elemdofs(size_t e, size_t m, size_t i) const
+{
+    if (m_elementwise) {
+        return m_elemdofs(e, m * m_ndim + i);
+    }
+    return m_dofs(m_conn(e, m), i);
+}
+
+inline index_type Topology::elempart(size_t e, size_t m, size_t i) const
+{
+    GOOSEFEM_ASSERT(m_partitioned);
+
+    if (m_elementwise) {
+        return m_elempart(e, m * m_ndim + i);
+    }
+    return m_part(m_conn(e, m), i);
+}
+
+} // namespace GooseFEM
+
+#endif
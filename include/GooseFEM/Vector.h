@@ -8,6 +8,7 @@
 #define GOOSEFEM_VECTOR_H
 
 #include "config.h"
+#include "Topology.h"
 
 namespace GooseFEM {
 
@@ -23,6 +24,14 @@ public:
     Vector() = default;
     Vector(const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 2>& dofs);
 
+    // Constructor: share the topology with other objects (no copy)
+    Vector(std::shared_ptr<const Topology> topology);
+
+    // View on a subset of elements, the topology is shared with this object (no copy).
+    // All "elemvec" of the subset have shape [elements.size(), nne, ndim],
+    // "nodevec" and "dofval" still refer to the full mesh.
+    Vector Subset(const xt::xtensor<size_t, 1>& elements) const;
+
     // Dimensions
     size_t nelem() const; // number of elements
     size_t nne() const;   // number of nodes per element
@@ -33,6 +42,9 @@ public:
     // DOF lists
     xt::xtensor<size_t, 2> dofs() const; // DOFs
 
+    // Topology (can be shared with other objects)
+    std::shared_ptr<const Topology> topology() const;
+
     // Copy nodevec to another nodevec
     void copy(const xt::xtensor<double, 2>& nodevec_src, xt::xtensor<double, 2>& nodevec_dest) const;
 
@@ -77,9 +89,16 @@ public:
     xt::xtensor<double, 3> AllocateElemmat(double val) const;
 
 private:
-    // Bookkeeping
-    xt::xtensor<size_t, 2> m_conn; // connectivity         [nelem, nne ]
-    xt::xtensor<size_t, 2> m_dofs; // DOF-numbers per node [nnode, ndim]
+    // Index of element "e" in the topology (only differs from "e" for a subset)
+    size_t elem(size_t e) const;
+
+private:
+    // Bookkeeping: connectivity and DOF-numbers (shared with subsets and other objects)
+    std::shared_ptr<const Topology> m_topo;
+
+    // Subset
+    bool m_subset = false;         // "true" if this object is a subset
+    xt::xtensor<size_t, 1> m_elem; // element numbers in the topology [nelem]
 
     // Dimensions
     size_t m_nelem; // number of elements
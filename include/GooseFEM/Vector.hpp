@@ -12,16 +12,38 @@
 namespace GooseFEM {
 
 inline Vector::Vector(const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 2>& dofs)
-    : m_conn(conn), m_dofs(dofs)
+    : Vector(std::make_shared<const Topology>(conn, dofs))
 {
-    m_nelem = m_conn.shape(0);
-    m_nne = m_conn.shape(1);
-    m_nnode = m_dofs.shape(0);
-    m_ndim = m_dofs.shape(1);
-    m_ndof = xt::amax(m_dofs)() + 1;
+}
+
+inline Vector::Vector(std::shared_ptr<const Topology> topology) : m_topo(std::move(topology))
+{
+    m_nelem = m_topo->nelem();
+    m_nne = m_topo->nne();
+    m_nnode = m_topo->nnode();
+    m_ndim = m_topo->ndim();
+    m_ndof = m_topo->ndof();
+}
+
+inline Vector Vector::Subset(const xt::xtensor<size_t, 1>& elements) const
+{
+    GOOSEFEM_ASSERT(elements.size() == 0 || xt::amax(elements)() < m_nelem);
 
-    GOOSEFEM_ASSERT(xt::amax(m_conn)() + 1 <= m_nnode);
-    GOOSEFEM_ASSERT(m_ndof <= m_nnode * m_ndim);
+    Vector ret = *this;
+    ret.m_subset = true;
+    ret.m_nelem = elements.size();
+    ret.m_elem = xt::empty<size_t>({elements.size()});
+
+    for (size_t e = 0; e < elements.size(); ++e) {
+        ret.m_elem(e) = this->elem(elements(e));
+    }
+
+    return ret;
+}
+
+inline size_t Vector::elem(size_t e) const
+{
+    return m_subset ? m_elem(e) : e;
 }
 
 inline size_t Vector::nelem() const
@@ -51,7 +73,12 @@ inline size_t Vector::ndof() const
 
 inline xt::xtensor<size_t, 2> Vector::dofs() const
 {
-    return m_dofs;
+    return m_topo->dofs();
+}
+
+inline std::shared_ptr<const Topology> Vector::topology() const
+{
+    return m_topo;
 }
 
 inline void
@@ -71,10 +98,12 @@ Vector::asDofs(const xt::xtensor<double, 2>& nodevec, xt::xtensor<double, 1>& do
 
     dofval.fill(0.0);
 
+    const auto& dofs = m_topo->dofs();
+
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            dofval(m_dofs(m, i)) = nodevec(m, i);
+            dofval(dofs(m, i)) = nodevec(m, i);
         }
     }
 }
@@ -87,11 +116,13 @@ Vector::asDofs(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 1>& do
 
     dofval.fill(0.0);
 
+    const auto& topo = *m_topo;
+
     #pragma omp parallel for
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                dofval(m_dofs(m_conn(e, m), i)) = elemvec(e, m, i);
+                dofval(topo.elemdofs(this->elem(e), m, i)) = elemvec(e, m, i);
             }
         }
     }
@@ -103,10 +134,12 @@ Vector::asNode(const xt::xtensor<double, 1>& dofval, xt::xtensor<double, 2>& nod
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& dofs = m_topo->dofs();
+
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            nodevec(m, i) = dofval(m_dofs(m, i));
+            nodevec(m, i) = dofval(dofs(m, i));
         }
     }
 }
@@ -119,11 +152,13 @@ Vector::asNode(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 2>& no
 
     nodevec.fill(0.0);
 
+    const auto& conn = m_topo->conn();
+
     #pragma omp parallel for
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                nodevec(m_conn(e, m), i) = elemvec(e, m, i);
+                nodevec(conn(this->elem(e), m), i) = elemvec(e, m, i);
             }
         }
     }
@@ -135,11 +170,13 @@ Vector::asElement(const xt::xtensor<double, 1>& dofval, xt::xtensor<double, 3>&
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
 
+    const auto& topo = *m_topo;
+
     #pragma omp parallel for
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                elemvec(e, m, i) = dofval(m_dofs(m_conn(e, m), i));
+                elemvec(e, m, i) = dofval(topo.elemdofs(this->elem(e), m, i));
             }
         }
     }
@@ -151,11 +188,13 @@ Vector::asElement(const xt::xtensor<double, 2>& nodevec, xt::xtensor<double, 3>&
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
 
+    const auto& conn = m_topo->conn();
+
     #pragma omp parallel for
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                elemvec(e, m, i) = nodevec(m_conn(e, m), i);
+                elemvec(e, m, i) = nodevec(conn(this->elem(e), m), i);
             }
         }
     }
@@ -169,9 +208,11 @@ Vector::assembleDofs(const xt::xtensor<double, 2>& nodevec, xt::xtensor<double,
 
     dofval.fill(0.0);
 
+    const auto& dofs = m_topo->dofs();
+
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            dofval(m_dofs(m, i)) += nodevec(m, i);
+            dofval(dofs(m, i)) += nodevec(m, i);
         }
     }
 }
@@ -184,10 +225,12 @@ Vector::assembleDofs(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double,
 
     dofval.fill(0.0);
 
+    const auto& topo = *m_topo;
+
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                dofval(m_dofs(m_conn(e, m), i)) += elemvec(e, m, i);
+                dofval(topo.elemdofs(this->elem(e), m, i)) += elemvec(e, m, i);
             }
         }
     }
@@ -8,6 +8,7 @@
 #define GOOSEFEM_VECTORPARTITIONED_H
 
 #include "config.h"
+#include "Topology.h"
 
 namespace GooseFEM {
 
@@ -29,6 +30,9 @@ public:
         const xt::xtensor<size_t, 2>& dofs,
         const xt::xtensor<size_t, 1>& iip);
 
+    // Constructor: share the topology with other objects (no copy), it must be partitioned
+    VectorPartitioned(std::shared_ptr<const Topology> topology);
+
     // Dimensions
     size_t nelem() const; // number of elements
     size_t nne() const;   // number of nodes per element
@@ -43,6 +47,22 @@ public:
     xt::xtensor<size_t, 1> iiu() const;  // unknown    DOFs
     xt::xtensor<size_t, 1> iip() const;  // prescribed DOFs
 
+    // Topology (can be shared with other objects)
+    std::shared_ptr<const Topology> topology() const;
+
+    // Check if "dofval" is stored in partitioned order, "dofval = [dofval_u, dofval_p]",
+    // see "Topology::contiguous()". In that case "View_u" and "View_p" can be used.
+    bool contiguous() const;
+
+    // View on "dofval_u" / "dofval_p" as part of "dofval" (no copy), requires "contiguous()"
+    // (a view on a temporary would dangle, use "AsDofs_u" / "AsDofs_p" instead)
+    auto View_u(xt::xtensor<double, 1>& dofval) const;
+    auto View_u(const xt::xtensor<double, 1>& dofval) const;
+    auto View_p(xt::xtensor<double, 1>& dofval) const;
+    auto View_p(const xt::xtensor<double, 1>& dofval) const;
+    void View_u(xt::xtensor<double, 1>&& dofval) const = delete;
+    void View_p(xt::xtensor<double, 1>&& dofval) const = delete;
+
     // Copy (part of) nodevec/dofval to another nodevec/dofval
     void copy(
         const xt::xtensor<double, 2>& nodevec_src, xt::xtensor<double, 2>& nodevec_dest) const;
@@ -153,14 +173,8 @@ public:
     xt::xtensor<double, 3> AllocateElemmat(double val) const;
 
 private:
-    // Bookkeeping
-    xt::xtensor<size_t, 2> m_conn; // connectivity                    [nelem, nne ]
-    xt::xtensor<size_t, 2> m_dofs; // DOF-numbers per node            [nnode, ndim]
-    xt::xtensor<size_t, 1> m_iiu;  // DOF-numbers that are unknown    [nnu]
-    xt::xtensor<size_t, 1> m_iip;  // DOF-numbers that are prescribed [nnp]
-
-    // DOFs per node, such that iiu = arange(nnu), iip = nnu + arange(nnp)
-    xt::xtensor<size_t, 2> m_part;
+    // Bookkeeping: connectivity, DOF-numbers, and partitioning (shared with other objects)
+    std::shared_ptr<const Topology> m_topo;
 
     // Dimensions
     size_t m_nelem; // number of elements
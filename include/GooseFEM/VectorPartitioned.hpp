@@ -16,21 +16,22 @@ inline VectorPartitioned::VectorPartitioned(
     const xt::xtensor<size_t, 2>& conn,
     const xt::xtensor<size_t, 2>& dofs,
     const xt::xtensor<size_t, 1>& iip)
-    : m_conn(conn), m_dofs(dofs), m_iip(iip)
+    : VectorPartitioned(std::make_shared<const Topology>(conn, dofs, iip))
 {
-    m_nelem = m_conn.shape(0);
-    m_nne = m_conn.shape(1);
-    m_nnode = m_dofs.shape(0);
-    m_ndim = m_dofs.shape(1);
-    m_iiu = xt::setdiff1d(m_dofs, m_iip);
-    m_ndof = xt::amax(m_dofs)() + 1;
-    m_nnp = m_iip.size();
-    m_nnu = m_iiu.size();
-    m_part = Mesh::Reorder({m_iiu, m_iip}).get(m_dofs);
+}
+
+inline VectorPartitioned::VectorPartitioned(std::shared_ptr<const Topology> topology)
+    : m_topo(std::move(topology))
+{
+    GOOSEFEM_CHECK(m_topo->partitioned());
 
-    GOOSEFEM_ASSERT(xt::amax(m_conn)() + 1 <= m_nnode);
-    GOOSEFEM_ASSERT(xt::amax(m_iip)() <= xt::amax(m_dofs)());
-    GOOSEFEM_ASSERT(m_ndof <= m_nnode * m_ndim);
+    m_nelem = m_topo->nelem();
+    m_nne = m_topo->nne();
+    m_nnode = m_topo->nnode();
+    m_ndim = m_topo->ndim();
+    m_ndof = m_topo->ndof();
+    m_nnu = m_topo->nnu();
+    m_nnp = m_topo->nnp();
 }
 
 inline size_t VectorPartitioned::nelem() const
@@ -70,17 +71,55 @@ inline size_t VectorPartitioned::nnp() const
 
 inline xt::xtensor<size_t, 2> VectorPartitioned::dofs() const
 {
-    return m_dofs;
+    return m_topo->dofs();
+}
+
+inline std::shared_ptr<const Topology> VectorPartitioned::topology() const
+{
+    return m_topo;
+}
+
+inline bool VectorPartitioned::contiguous() const
+{
+    return m_topo->contiguous();
+}
+
+inline auto VectorPartitioned::View_u(xt::xtensor<double, 1>& dofval) const
+{
+    GOOSEFEM_ASSERT(m_topo->contiguous());
+    GOOSEFEM_ASSERT(dofval.size() == m_ndof);
+    return xt::view(dofval, xt::range(0, m_nnu));
+}
+
+inline auto VectorPartitioned::View_u(const xt::xtensor<double, 1>& dofval) const
+{
+    GOOSEFEM_ASSERT(m_topo->contiguous());
+    GOOSEFEM_ASSERT(dofval.size() == m_ndof);
+    return xt::view(dofval, xt::range(0, m_nnu));
+}
+
+inline auto VectorPartitioned::View_p(xt::xtensor<double, 1>& dofval) const
+{
+    GOOSEFEM_ASSERT(m_topo->contiguous());
+    GOOSEFEM_ASSERT(dofval.size() == m_ndof);
+    return xt::view(dofval, xt::range(m_nnu, m_ndof));
+}
+
+inline auto VectorPartitioned::View_p(const xt::xtensor<double, 1>& dofval) const
+{
+    GOOSEFEM_ASSERT(m_topo->contiguous());
+    GOOSEFEM_ASSERT(dofval.size() == m_ndof);
+    return xt::view(dofval, xt::range(m_nnu, m_ndof));
 }
 
 inline xt::xtensor<size_t, 1> VectorPartitioned::iiu() const
 {
-    return m_iiu;
+    return m_topo->iiu();
 }
 
 inline xt::xtensor<size_t, 1> VectorPartitioned::iip() const
 {
-    return m_iip;
+    return m_topo->iip();
 }
 
 inline void VectorPartitioned::copy(
@@ -98,10 +137,12 @@ inline void VectorPartitioned::copy_u(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec_src, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(nodevec_dest, {m_nnode, m_ndim}));
 
+    const auto& part = m_topo->part();
+
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) < m_nnu) {
+            if (part(m, i) < m_nnu) {
                 nodevec_dest(m, i) = nodevec_src(m, i);
             }
         }
@@ -114,10 +155,12 @@ inline void VectorPartitioned::copy_p(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec_src, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(nodevec_dest, {m_nnode, m_ndim}));
 
+    const auto& part = m_topo->part();
+
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) >= m_nnu) {
+            if (part(m, i) >= m_nnu) {
                 nodevec_dest(m, i) = nodevec_src(m, i);
             }
         }
@@ -133,16 +176,25 @@ inline void VectorPartitioned::asDofs(
     GOOSEFEM_ASSERT(dofval_p.size() == m_nnp);
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    if (m_topo->contiguous()) {
+        std::copy(dofval_u.cbegin(), dofval_u.cend(), dofval.begin());
+        std::copy(dofval_p.cbegin(), dofval_p.cend(), dofval.begin() + m_nnu);
+        return;
+    }
+
+    const auto& iiu = m_topo->iiu();
+    const auto& iip = m_topo->iip();
+
     dofval.fill(0.0);
 
     #pragma omp parallel for
     for (size_t d = 0; d < m_nnu; ++d) {
-        dofval(m_iiu(d)) = dofval_u(d);
+        dofval(iiu(d)) = dofval_u(d);
     }
 
     #pragma omp parallel for
     for (size_t d = 0; d < m_nnp; ++d) {
-        dofval(m_iip(d)) = dofval_p(d);
+        dofval(iip(d)) = dofval_p(d);
     }
 }
 
@@ -152,12 +204,14 @@ inline void VectorPartitioned::asDofs(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    const auto& dofs = m_topo->dofs();
+
     dofval.fill(0.0);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            dofval(m_dofs(m, i)) = nodevec(m, i);
+            dofval(dofs(m, i)) = nodevec(m, i);
         }
     }
 }
@@ -168,9 +222,16 @@ inline void VectorPartitioned::asDofs_u(
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
     GOOSEFEM_ASSERT(dofval_u.size() == m_nnu);
 
+    if (m_topo->contiguous()) {
+        std::copy(dofval.cbegin(), dofval.cbegin() + m_nnu, dofval_u.begin());
+        return;
+    }
+
+    const auto& iiu = m_topo->iiu();
+
     #pragma omp parallel for
     for (size_t d = 0; d < m_nnu; ++d) {
-        dofval_u(d) = dofval(m_iiu(d));
+        dofval_u(d) = dofval(iiu(d));
     }
 }
 
@@ -180,13 +241,15 @@ inline void VectorPartitioned::asDofs_u(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(dofval_u.size() == m_nnu);
 
+    const auto& part = m_topo->part();
+
     dofval_u.fill(0.0);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) < m_nnu) {
-                dofval_u(m_part(m, i)) = nodevec(m, i);
+            if (part(m, i) < m_nnu) {
+                dofval_u(part(m, i)) = nodevec(m, i);
             }
         }
     }
@@ -198,9 +261,16 @@ inline void VectorPartitioned::asDofs_p(
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
     GOOSEFEM_ASSERT(dofval_p.size() == m_nnp);
 
+    if (m_topo->contiguous()) {
+        std::copy(dofval.cbegin() + m_nnu, dofval.cend(), dofval_p.begin());
+        return;
+    }
+
+    const auto& iip = m_topo->iip();
+
     #pragma omp parallel for
     for (size_t d = 0; d < m_nnp; ++d) {
-        dofval_p(d) = dofval(m_iip(d));
+        dofval_p(d) = dofval(iip(d));
     }
 }
 
@@ -210,13 +280,15 @@ inline void VectorPartitioned::asDofs_p(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(dofval_p.size() == m_nnp);
 
+    const auto& part = m_topo->part();
+
     dofval_p.fill(0.0);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) >= m_nnu) {
-                dofval_p(m_part(m, i) - m_nnu) = nodevec(m, i);
+            if (part(m, i) >= m_nnu) {
+                dofval_p(part(m, i) - m_nnu) = nodevec(m, i);
             }
         }
     }
@@ -228,13 +300,15 @@ inline void VectorPartitioned::asDofs(
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    const auto& topo = *m_topo;
+
     dofval.fill(0.0);
 
     #pragma omp parallel for
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                dofval(m_dofs(m_conn(e, m), i)) = elemvec(e, m, i);
+                dofval(topo.elemdofs(e, m, i)) = elemvec(e, m, i);
             }
         }
     }
@@ -246,14 +320,16 @@ inline void VectorPartitioned::asDofs_u(
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(dofval_u.size() == m_nnu);
 
+    const auto& topo = *m_topo;
+
     dofval_u.fill(0.0);
 
     #pragma omp parallel for
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                if (m_part(m_conn(e, m), i) < m_nnu) {
-                    dofval_u(m_part(m_conn(e, m), i)) = elemvec(e, m, i);
+                if (topo.elempart(e, m, i) < m_nnu) {
+                    dofval_u(topo.elempart(e, m, i)) = elemvec(e, m, i);
                 }
             }
         }
@@ -266,14 +342,16 @@ inline void VectorPartitioned::asDofs_p(
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(dofval_p.size() == m_nnp);
 
+    const auto& topo = *m_topo;
+
     dofval_p.fill(0.0);
 
     #pragma omp parallel for
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                if (m_part(m_conn(e, m), i) >= m_nnu) {
-                    dofval_p(m_part(m_conn(e, m), i) - m_nnu) = elemvec(e, m, i);
+                if (topo.elempart(e, m, i) >= m_nnu) {
+                    dofval_p(topo.elempart(e, m, i) - m_nnu) = elemvec(e, m, i);
                 }
             }
         }
@@ -286,10 +364,12 @@ inline void VectorPartitioned::asNode(
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& dofs = m_topo->dofs();
+
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            nodevec(m, i) = dofval(m_dofs(m, i));
+            nodevec(m, i) = dofval(dofs(m, i));
         }
     }
 }
@@ -303,14 +383,16 @@ inline void VectorPartitioned::asNode(
     GOOSEFEM_ASSERT(dofval_p.size() == m_nnp);
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& part = m_topo->part();
+
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) < m_nnu) {
-                nodevec(m, i) = dofval_u(m_part(m, i));
+            if (part(m, i) < m_nnu) {
+                nodevec(m, i) = dofval_u(part(m, i));
             }
             else {
-                nodevec(m, i) = dofval_p(m_part(m, i) - m_nnu);
+                nodevec(m, i) = dofval_p(part(m, i) - m_nnu);
             }
         }
     }
@@ -322,13 +404,15 @@ inline void VectorPartitioned::asNode(
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& conn = m_topo->conn();
+
     nodevec.fill(0.0);
 
     #pragma omp parallel for
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                nodevec(m_conn(e, m), i) = elemvec(e, m, i);
+                nodevec(conn(e, m), i) = elemvec(e, m, i);
             }
         }
     }
@@ -340,11 +424,13 @@ inline void VectorPartitioned::asElement(
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
 
+    const auto& topo = *m_topo;
+
     #pragma omp parallel for
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                elemvec(e, m, i) = dofval(m_dofs(m_conn(e, m), i));
+                elemvec(e, m, i) = dofval(topo.elemdofs(e, m, i));
             }
         }
     }
@@ -359,15 +445,17 @@ inline void VectorPartitioned::asElement(
     GOOSEFEM_ASSERT(dofval_p.size() == m_nnp);
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
 
+    const auto& topo = *m_topo;
+
     #pragma omp parallel for
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                if (m_part(m_conn(e, m), i) < m_nnu) {
-                    elemvec(e, m, i) = dofval_u(m_part(m_conn(e, m), i));
+                if (topo.elempart(e, m, i) < m_nnu) {
+                    elemvec(e, m, i) = dofval_u(topo.elempart(e, m, i));
                 }
                 else {
-                    elemvec(e, m, i) = dofval_p(m_part(m_conn(e, m), i) - m_nnu);
+                    elemvec(e, m, i) = dofval_p(topo.elempart(e, m, i) - m_nnu);
                 }
             }
         }
@@ -380,11 +468,13 @@ inline void VectorPartitioned::asElement(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
 
+    const auto& conn = m_topo->conn();
+
     #pragma omp parallel for
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                elemvec(e, m, i) = nodevec(m_conn(e, m), i);
+                elemvec(e, m, i) = nodevec(conn(e, m), i);
             }
         }
     }
@@ -396,11 +486,13 @@ inline void VectorPartitioned::assembleDofs(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    const auto& dofs = m_topo->dofs();
+
     dofval.fill(0.0);
 
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            dofval(m_dofs(m, i)) += nodevec(m, i);
+            dofval(dofs(m, i)) += nodevec(m, i);
         }
     }
 }
@@ -411,12 +503,14 @@ inline void VectorPartitioned::assembleDofs_u(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(dofval_u.size() == m_nnu);
 
+    const auto& part = m_topo->part();
+
     dofval_u.fill(0.0);
 
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) < m_nnu) {
-                dofval_u(m_part(m, i)) += nodevec(m, i);
+            if (part(m, i) < m_nnu) {
+                dofval_u(part(m, i)) += nodevec(m, i);
             }
         }
     }
@@ -428,12 +522,14 @@ inline void VectorPartitioned::assembleDofs_p(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(dofval_p.size() == m_nnp);
 
+    const auto& part = m_topo->part();
+
     dofval_p.fill(0.0);
 
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) >= m_nnu) {
-                dofval_p(m_part(m, i) - m_nnu) += nodevec(m, i);
+            if (part(m, i) >= m_nnu) {
+                dofval_p(part(m, i) - m_nnu) += nodevec(m, i);
             }
         }
     }
@@ -445,12 +541,14 @@ inline void VectorPartitioned::assembleDofs(
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    const auto& topo = *m_topo;
+
     dofval.fill(0.0);
 
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                dofval(m_dofs(m_conn(e, m), i)) += elemvec(e, m, i);
+                dofval(topo.elemdofs(e, m, i)) += elemvec(e, m, i);
             }
         }
     }
@@ -462,13 +560,15 @@ inline void VectorPartitioned::assembleDofs_u(
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(dofval_u.size() == m_nnu);
 
+    const auto& topo = *m_topo;
+
     dofval_u.fill(0.0);
 
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                if (m_part(m_conn(e, m), i) < m_nnu) {
-                    dofval_u(m_part(m_conn(e, m), i)) += elemvec(e, m, i);
+                if (topo.elempart(e, m, i) < m_nnu) {
+                    dofval_u(topo.elempart(e, m, i)) += elemvec(e, m, i);
                 }
             }
         }
@@ -481,13 +581,15 @@ inline void VectorPartitioned::assembleDofs_p(
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(dofval_p.size() == m_nnp);
 
+    const auto& topo = *m_topo;
+
     dofval_p.fill(0.0);
 
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                if (m_part(m_conn(e, m), i) >= m_nnu) {
-                    dofval_p(m_part(m_conn(e, m), i) - m_nnu) += elemvec(e, m, i);
+                if (topo.elempart(e, m, i) >= m_nnu) {
+                    dofval_p(topo.elempart(e, m, i) - m_nnu) += elemvec(e, m, i);
                 }
             }
         }
@@ -8,6 +8,7 @@
 #define GOOSEFEM_VECTORPARTITIONEDTYINGS_H
 
 #include "config.h"
+#include "Topology.h"
 
 #include <Eigen/Eigen>
 #include <Eigen/Sparse>
@@ -34,6 +35,13 @@ public:
         const Eigen::SparseMatrix<double>& Cdp,
         const Eigen::SparseMatrix<double>& Cdi);
 
+    // Constructor: share the topology with other objects (no copy)
+    VectorPartitionedTyings(
+        std::shared_ptr<const Topology> topology,
+        const Eigen::SparseMatrix<double>& Cdu,
+        const Eigen::SparseMatrix<double>& Cdp,
+        const Eigen::SparseMatrix<double>& Cdi);
+
     // Dimensions
     size_t nelem() const; // number of elements
     size_t nne() const;   // number of nodes per element
@@ -52,6 +60,9 @@ public:
     xt::xtensor<size_t, 1> iii() const;  // independent DOFs
     xt::xtensor<size_t, 1> iid() const;  // dependent DOFs
 
+    // Topology (can be shared with other objects)
+    std::shared_ptr<const Topology> topology() const;
+
     // Copy (part of) nodevec/dofval to another nodevec/dofval
     void copy_p(
         const xt::xtensor<double, 1>& dofval_src, xt::xtensor<double, 1>& dofval_dest) const; // "iip"  updated
@@ -93,11 +104,10 @@ public:
 
 private:
     // Bookkeeping
-    xt::xtensor<size_t, 2> m_conn; // connectivity [nelem, nne]
-    xt::xtensor<size_t, 2> m_dofs; // DOF-numbers per node  [nnode, ndim]
-    xt::xtensor<size_t, 1> m_iiu;  // unknown DOFs [nnu]
-    xt::xtensor<size_t, 1> m_iip;  // prescribed DOFs [nnp]
-    xt::xtensor<size_t, 1> m_iid;  // dependent DOFs [nnd]
+    std::shared_ptr<const Topology> m_topo; // connectivity and DOF-numbers (shared)
+    xt::xtensor<index_type, 1> m_iiu;  // unknown DOFs [nnu]
+    xt::xtensor<index_type, 1> m_iip;  // prescribed DOFs [nnp]
+    xt::xtensor<index_type, 1> m_iid;  // dependent DOFs [nnd]
 
     // Dimensions
     size_t m_nelem; // number of elements
@@ -17,7 +17,16 @@ inline VectorPartitionedTyings::VectorPartitionedTyings(
     const Eigen::SparseMatrix<double>& Cdu,
     const Eigen::SparseMatrix<double>& Cdp,
     const Eigen::SparseMatrix<double>& Cdi)
-    : m_conn(conn), m_dofs(dofs), m_Cdu(Cdu), m_Cdp(Cdp), m_Cdi(Cdi)
+    : VectorPartitionedTyings(std::make_shared<const Topology>(conn, dofs), Cdu, Cdp, Cdi)
+{
+}
+
+inline VectorPartitionedTyings::VectorPartitionedTyings(
+    std::shared_ptr<const Topology> topology,
+    const Eigen::SparseMatrix<double>& Cdu,
+    const Eigen::SparseMatrix<double>& Cdp,
+    const Eigen::SparseMatrix<double>& Cdi)
+    : m_topo(std::move(topology)), m_Cdu(Cdu), m_Cdp(Cdp), m_Cdi(Cdi)
 {
     GOOSEFEM_ASSERT(Cdu.rows() == Cdp.rows());
     GOOSEFEM_ASSERT(Cdi.rows() == Cdp.rows());
@@ -30,17 +39,17 @@ inline VectorPartitionedTyings::VectorPartitionedTyings(
     m_iiu = xt::arange<size_t>(m_nnu);
     m_iip = xt::arange<size_t>(m_nnu, m_nnu + m_nnp);
     m_iid = xt::arange<size_t>(m_nni, m_nni + m_nnd);
-    m_nelem = m_conn.shape(0);
-    m_nne = m_conn.shape(1);
-    m_nnode = m_dofs.shape(0);
-    m_ndim = m_dofs.shape(1);
+    m_nelem = m_topo->nelem();
+    m_nne = m_topo->nne();
+    m_nnode = m_topo->nnode();
+    m_ndim = m_topo->ndim();
     m_Cud = m_Cdu.transpose();
     m_Cpd = m_Cdp.transpose();
     m_Cid = m_Cdi.transpose();
 
     GOOSEFEM_ASSERT(static_cast<size_t>(m_Cdi.cols()) == m_nni);
     GOOSEFEM_ASSERT(m_ndof <= m_nnode * m_ndim);
-    GOOSEFEM_ASSERT(m_ndof == xt::amax(m_dofs)() + 1);
+    GOOSEFEM_ASSERT(m_ndof == m_topo->ndof());
 }
 
 inline size_t VectorPartitionedTyings::nelem() const
@@ -90,7 +99,12 @@ inline size_t VectorPartitionedTyings::nnd() const
 
 inline xt::xtensor<size_t, 2> VectorPartitionedTyings::dofs() const
 {
-    return m_dofs;
+    return m_topo->dofs();
+}
+
+inline std::shared_ptr<const Topology> VectorPartitionedTyings::topology() const
+{
+    return m_topo;
 }
 
 inline xt::xtensor<size_t, 1> VectorPartitionedTyings::iiu() const
@@ -133,13 +147,15 @@ inline void VectorPartitionedTyings::asDofs_i(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(dofval_i.size() == m_nni);
 
+    const auto& dofs = m_topo->dofs();
+
     dofval_i.fill(0.0);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_dofs(m, i) < m_nni) {
-                dofval_i(m_dofs(m, i)) = nodevec(m, i);
+            if (dofs(m, i) < m_nni) {
+                dofval_i(dofs(m, i)) = nodevec(m, i);
             }
         }
     }
@@ -163,10 +179,12 @@ inline void VectorPartitionedTyings::asNode(
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& dofs = m_topo->dofs();
+
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            nodevec(m, i) = dofval(m_dofs(m, i));
+            nodevec(m, i) = dofval(dofs(m, i));
         }
     }
 }
@@ -177,11 +195,13 @@ inline void VectorPartitionedTyings::asElement(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
 
+    const auto& conn = m_topo->conn();
+
     #pragma omp parallel for
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                elemvec(e, m, i) = nodevec(m_conn(e, m), i);
+                elemvec(e, m, i) = nodevec(conn(e, m), i);
             }
         }
     }
@@ -193,12 +213,14 @@ inline void VectorPartitionedTyings::assembleDofs(
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    const auto& topo = *m_topo;
+
     dofval.fill(0.0);
 
     for (size_t e = 0; e < m_nelem; ++e) {
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                dofval(m_dofs(m_conn(e, m), i)) += elemvec(e, m, i);
+                dofval(topo.elemdofs(e, m, i)) += elemvec(e, m, i);
             }
         }
     }
@@ -259,13 +281,15 @@ VectorPartitionedTyings::Eigen_asDofs_d(const xt::xtensor<double, 2>& nodevec) c
 {
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& dofs = m_topo->dofs();
+
     Eigen::VectorXd dofval_d(m_nnd, 1);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_dofs(m, i) >= m_nni) {
-                dofval_d(m_dofs(m, i) - m_nni) = nodevec(m, i);
+            if (dofs(m, i) >= m_nni) {
+                dofval_d(dofs(m, i) - m_nni) = nodevec(m, i);
             }
         }
     }
@@ -10,15 +10,22 @@
 #define _USE_MATH_DEFINES // to use "M_PI" from "math.h"
 
 #include <algorithm>
+#include <array>
 #include <assert.h>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <math.h>
 #include <memory>
 #include <numeric>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 #include <xtensor/xadapt.hpp>
@@ -40,6 +47,16 @@ using namespace xt::placeholders;
 
 #define UNUSED(p) ((void)(p))
 
+// Storage type of index arrays (connectivity, DOF-numbers, partitioning) stored internally.
+// The API always uses "size_t". Define before including GooseFEM to change, e.g. to "size_t".
+#ifndef GOOSEFEM_INDEX_TYPE
+#define GOOSEFEM_INDEX_TYPE uint32_t
+#endif
+
+namespace GooseFEM {
+using index_type = GOOSEFEM_INDEX_TYPE;
+} // namespace GooseFEM
+
 #ifdef GOOSEFEM_ENABLE_ASSERT
 #define GOOSEFEM_ASSERT(expr) GOOSEFEM_ASSERT_IMPL(expr, __FILE__, __LINE__)
 #define GOOSEFEM_ASSERT_IMPL(expr, file, line) \
@@ -32,6 +32,13 @@ void init_ElementHex8(py::module& m)
             &GooseFEM::Element::Hex8::Quadrature::update_x,
             "Update the nodal positions")
 
+        .def(
+            "Subset",
+            &GooseFEM::Element::Hex8::Quadrature::Subset,
+            "View on a subset of elements (sharing the geometry)",
+            py::arg("elements"),
+            py::keep_alive<0, 1>())
+
         .def("nelem", &GooseFEM::Element::Hex8::Quadrature::nelem, "Number of elements")
 
         .def("nne", &GooseFEM::Element::Hex8::Quadrature::nne, "Number of nodes per element")
@@ -32,6 +32,13 @@ void init_ElementQuad4Axisymmetric(py::module& m)
             &GooseFEM::Element::Quad4::QuadratureAxisymmetric::update_x,
             "Update the nodal positions")
 
+        .def(
+            "Subset",
+            &GooseFEM::Element::Quad4::QuadratureAxisymmetric::Subset,
+            "View on a subset of elements (sharing the geometry)",
+            py::arg("elements"),
+            py::keep_alive<0, 1>())
+
         .def(
             "nelem", &GooseFEM::Element::Quad4::QuadratureAxisymmetric::nelem, "Number of elements")
 
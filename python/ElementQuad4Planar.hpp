@@ -32,6 +32,13 @@ void init_ElementQuad4Planar(py::module& m)
             &GooseFEM::Element::Quad4::QuadraturePlanar::update_x,
             "Update the nodal positions")
 
+        .def(
+            "Subset",
+            &GooseFEM::Element::Quad4::QuadraturePlanar::Subset,
+            "View on a subset of elements (sharing the geometry)",
+            py::arg("elements"),
+            py::keep_alive<0, 1>())
+
         .def("nelem", &GooseFEM::Element::Quad4::QuadraturePlanar::nelem, "Number of elements")
 
         .def("nne", &GooseFEM::Element::Quad4::QuadraturePlanar::nne, "Number of nodes per element")
@@ -31,9 +31,9 @@ void init_MeshHex8(py::module& m)
 
         .def("ndim", &GooseFEM::Mesh::Hex8::Regular::ndim)
 
-        .def("coor", &GooseFEM::Mesh::Hex8::Regular::coor)
+        .def("coor", py::overload_cast<>(&GooseFEM::Mesh::Hex8::Regular::coor, py::const_))
 
-        .def("conn", &GooseFEM::Mesh::Hex8::Regular::conn)
+        .def("conn", py::overload_cast<>(&GooseFEM::Mesh::Hex8::Regular::conn, py::const_))
 
         .def("getElementType", &GooseFEM::Mesh::Hex8::Regular::getElementType)
 
@@ -326,9 +326,9 @@ void init_MeshHex8(py::module& m)
 
         .def("nelz", &GooseFEM::Mesh::Hex8::FineLayer::nelz)
 
-        .def("coor", &GooseFEM::Mesh::Hex8::FineLayer::coor)
+        .def("coor", py::overload_cast<>(&GooseFEM::Mesh::Hex8::FineLayer::coor, py::const_))
 
-        .def("conn", &GooseFEM::Mesh::Hex8::FineLayer::conn)
+        .def("conn", py::overload_cast<>(&GooseFEM::Mesh::Hex8::FineLayer::conn, py::const_))
 
         .def("getElementType", &GooseFEM::Mesh::Hex8::FineLayer::getElementType)
 
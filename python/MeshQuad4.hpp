@@ -24,8 +24,8 @@ void init_MeshQuad4(py::module& m)
             py::arg("ny"),
             py::arg("h") = 1.)
 
-        .def("coor", &GooseFEM::Mesh::Quad4::Regular::coor)
-        .def("conn", &GooseFEM::Mesh::Quad4::Regular::conn)
+        .def("coor", py::overload_cast<>(&GooseFEM::Mesh::Quad4::Regular::coor, py::const_))
+        .def("conn", py::overload_cast<>(&GooseFEM::Mesh::Quad4::Regular::conn, py::const_))
         .def("nelem", &GooseFEM::Mesh::Quad4::Regular::nelem)
         .def("nnode", &GooseFEM::Mesh::Quad4::Regular::nnode)
         .def("nne", &GooseFEM::Mesh::Quad4::Regular::nne)
@@ -77,8 +77,8 @@ void init_MeshQuad4(py::module& m)
             py::arg("coor"),
             py::arg("conn"))
 
-        .def("coor", &GooseFEM::Mesh::Quad4::FineLayer::coor)
-        .def("conn", &GooseFEM::Mesh::Quad4::FineLayer::conn)
+        .def("coor", py::overload_cast<>(&GooseFEM::Mesh::Quad4::FineLayer::coor, py::const_))
+        .def("conn", py::overload_cast<>(&GooseFEM::Mesh::Quad4::FineLayer::conn, py::const_))
         .def("nelem", &GooseFEM::Mesh::Quad4::FineLayer::nelem)
         .def("nnode", &GooseFEM::Mesh::Quad4::FineLayer::nnode)
         .def("nne", &GooseFEM::Mesh::Quad4::FineLayer::nne)
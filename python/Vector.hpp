@@ -21,6 +21,12 @@ void init_Vector(py::module& m)
             py::arg("conn"),
             py::arg("dofs"))
 
+        .def(
+            "Subset",
+            &GooseFEM::Vector::Subset,
+            "View on a subset of elements (sharing the connectivity)",
+            py::arg("elements"))
+
         .def("nelem", &GooseFEM::Vector::nelem, "Number of element")
 
         .def("nne", &GooseFEM::Vector::nne, "Number of nodes per element")
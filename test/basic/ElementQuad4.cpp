@@ -165,4 +165,54 @@ TEST_CASE("GooseFEM::ElementQuad4", "ElementQuad4.h")
         REQUIRE(Fi.size() == vec.ndof());
         REQUIRE(xt::allclose(Fi, 0.));
     }
+
+    SECTION("Subset")
+    {
+        GooseFEM::Mesh::Quad4::FineLayer mesh(9, 9);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofsPeriodic());
+        GooseFEM::Element::Quad4::Quadrature quad(vec.AsElement(mesh.coor()));
+
+        xt::xtensor<size_t, 1> elem = mesh.elementsMiddleLayer();
+        xt::xtensor<size_t, 2> conn = xt::view(mesh.conn(), xt::keep(elem));
+
+        GooseFEM::Vector vec_sub = vec.Subset(elem);
+        GooseFEM::Element::Quad4::Quadrature quad_sub = quad.Subset(elem);
+        GooseFEM::Vector vec_copy(conn, mesh.dofsPeriodic());
+        GooseFEM::Element::Quad4::Quadrature quad_copy(vec_copy.AsElement(mesh.coor()));
+
+        xt::xtensor<double, 2> disp = xt::random::rand<double>(mesh.coor().shape());
+        xt::xtensor<double, 3> ue = vec_sub.AsElement(disp);
+        xt::xtensor<double, 4> eps = quad_sub.SymGradN_vector(ue);
+
+        REQUIRE(quad_sub.nelem() == elem.size());
+        REQUIRE(xt::has_shape(quad_sub.AllocateQtensor<2>(), eps.shape()));
+        REQUIRE(xt::allclose(quad_sub.dV(), quad_copy.dV()));
+        REQUIRE(xt::allclose(quad_sub.GradN(), quad_copy.GradN()));
+        REQUIRE(xt::allclose(eps, quad_copy.SymGradN_vector(ue)));
+        REQUIRE(xt::allclose(eps, xt::view(quad.SymGradN_vector(vec.AsElement(disp)), xt::keep(elem))));
+        REQUIRE(xt::allclose(
+            vec_sub.AssembleDofs(quad_sub.Int_gradN_dot_tensor2_dV(eps)),
+            vec_copy.AssembleDofs(quad_copy.Int_gradN_dot_tensor2_dV(eps))));
+
+        // update of the full object is seen by the subset
+        xt::xtensor<double, 2> coor = mesh.coor() + 0.1 * disp;
+        quad.update_x(vec.AsElement(coor));
+        quad_copy.update_x(vec_copy.AsElement(coor));
+
+        REQUIRE(xt::allclose(quad_sub.dV(), quad_copy.dV()));
+        REQUIRE(xt::allclose(quad_sub.GradN(), quad_copy.GradN()));
+
+        // nested subset
+        xt::xtensor<size_t, 1> nested = {0, 1};
+        auto dV_nested = xt::view(quad_copy.dV(), xt::keep(nested));
+        REQUIRE(xt::allclose(quad_sub.Subset(nested).dV(), dV_nested));
+
+        // an ordinary copy is independent
+        GooseFEM::Element::Quad4::Quadrature quad_ref = quad;
+        xt::xtensor<double, 2> dV_ref = quad.dV();
+        quad_ref.update_x(vec.AsElement(mesh.coor()));
+
+        REQUIRE(xt::allclose(quad.dV(), dV_ref));
+        REQUIRE(!xt::allclose(quad_ref.dV(), dV_ref));
+    }
 }
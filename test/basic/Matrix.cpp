@@ -94,4 +94,929 @@ TEST_CASE("GooseFEM::Matrix", "Matrix.h")
         REQUIRE(xt::allclose(b, K.Dot(x)));
         REQUIRE(xt::allclose(x, Solver.Solve(K, b)));
     }
+
+    SECTION("solve - SparseSolver")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(4, 4);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        size_t nnode = mesh.nnode();
+
+        xt::xtensor<double, 3> a = xt::empty<double>({nelem, nne * ndim, nne * ndim});
+        xt::xtensor<double, 1> b = xt::random::rand<double>({nnode * ndim});
+
+        // symmetric positive definite (diagonally dominant) element matrices
+        for (size_t e = 0; e < nelem; ++e) {
+            xt::xtensor<double, 2> ae = xt::random::rand<double>({nne * ndim, nne * ndim});
+            ae = (ae + xt::transpose(ae)) / 2.0 + double(nne * ndim) * xt::eye<double>(nne * ndim);
+            xt::view(a, e, xt::all(), xt::all()) = ae;
+        }
+
+        GooseFEM::Matrix A(mesh.conn(), mesh.dofs());
+        A.assemble(a);
+        xt::xtensor<double, 1> C = A.Dot(b);
+
+        REQUIRE(GooseFEM::SparseSolver::has("SimplicialLDLT"));
+        REQUIRE(GooseFEM::SparseSolver::has("ConjugateGradient"));
+
+        for (auto& name : GooseFEM::SparseSolver::available()) {
+            GooseFEM::MatrixSolver<GooseFEM::SparseSolver> Solver;
+            Solver.set_solver(GooseFEM::SparseSolver(name));
+            xt::xtensor<double, 1> B = Solver.Solve(A, C);
+
+            REQUIRE(Solver.solver().name() == name);
+            REQUIRE(Solver.solver().info() == Eigen::Success);
+            REQUIRE(xt::allclose(B, b, 1e-5, 1e-8));
+        }
+    }
+
+    SECTION("solve - SupernodalLDLT")
+    {
+        GooseFEM::Mesh::Hex8::Regular mesh(6, 6, 6);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        size_t nnode = mesh.nnode();
+
+        xt::xtensor<double, 3> a = xt::empty<double>({nelem, nne * ndim, nne * ndim});
+        xt::xtensor<double, 2> b = xt::random::rand<double>({nnode, ndim});
+
+        for (size_t e = 0; e < nelem; ++e) {
+            xt::xtensor<double, 2> ae = xt::random::rand<double>({nne * ndim, nne * ndim});
+            ae = (ae + xt::transpose(ae)) / 2.0 + double(nne * ndim) * xt::eye<double>(nne * ndim);
+            xt::view(a, e, xt::all(), xt::all()) = ae;
+        }
+
+        GooseFEM::Matrix A(mesh.conn(), mesh.dofs());
+        A.assemble(a);
+        xt::xtensor<double, 2> C = A.Dot(b);
+
+        GooseFEM::MatrixSolver<GooseFEM::SupernodalLDLT> Solver;
+        xt::xtensor<double, 2> B = Solver.Solve(A, C);
+
+        REQUIRE(Solver.solver().info() == Eigen::Success);
+        REQUIRE(Solver.solver().nsuper() < nnode * ndim);
+        REQUIRE(xt::allclose(B, b));
+
+        // new values, same sparsity pattern
+        a *= 2.0;
+        A.assemble(a);
+        B = Solver.Solve(A, C);
+
+        REQUIRE(xt::allclose(B, b / 2.0));
+    }
+
+    SECTION("solve - MixedPrecision")
+    {
+        GooseFEM::Mesh::Hex8::Regular mesh(4, 4, 4);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        size_t nnode = mesh.nnode();
+
+        xt::xtensor<double, 3> a = xt::empty<double>({nelem, nne * ndim, nne * ndim});
+        xt::xtensor<double, 2> b = xt::random::rand<double>({nnode, ndim});
+
+        for (size_t e = 0; e < nelem; ++e) {
+            xt::xtensor<double, 2> ae = xt::random::rand<double>({nne * ndim, nne * ndim});
+            ae = (ae + xt::transpose(ae)) / 2.0 + double(nne * ndim) * xt::eye<double>(nne * ndim);
+            xt::view(a, e, xt::all(), xt::all()) = ae;
+        }
+
+        GooseFEM::Matrix A(mesh.conn(), mesh.dofs());
+        A.assemble(a);
+        xt::xtensor<double, 2> C = A.Dot(b);
+
+        GooseFEM::MatrixSolver<GooseFEM::MixedPrecision<>> Solver;
+        Solver.solver().setTolerance(1e-14);
+        xt::xtensor<double, 2> B = Solver.Solve(A, C);
+
+        REQUIRE(Solver.solver().info() == Eigen::Success);
+        REQUIRE(Solver.solver().iterations() > 1);
+        REQUIRE(Solver.solver().iterations() < 6);
+        REQUIRE(Solver.solver().error() < 1e-14);
+        REQUIRE(xt::allclose(B, b, 1e-12, 1e-12));
+    }
+
+    SECTION("MatrixPartitionedSolver - PCG, warm start")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(10, 10);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        auto dofs = mesh.dofs();
+        xt::xtensor<size_t, 1> iip = xt::flatten(xt::view(dofs, xt::keep(mesh.nodesBottomEdge())));
+
+        xt::xtensor<double, 3> a = xt::empty<double>({nelem, nne * ndim, nne * ndim});
+
+        for (size_t e = 0; e < nelem; ++e) {
+            xt::xtensor<double, 2> ae = xt::random::rand<double>({nne * ndim, nne * ndim});
+            ae = (ae + xt::transpose(ae)) / 2.0 + double(nne * ndim) * xt::eye<double>(nne * ndim);
+            xt::view(a, e, xt::all(), xt::all()) = ae;
+        }
+
+        GooseFEM::MatrixPartitioned A(mesh.conn(), dofs, iip);
+        A.assemble(a);
+
+        xt::xtensor<double, 1> x = xt::random::rand<double>({A.ndof()});
+        xt::xtensor<double, 1> b = A.Dot(x);
+        xt::xtensor<double, 1> x0 = x;
+        xt::view(x0, xt::keep(A.iiu())) = 0.0;
+
+        GooseFEM::MatrixPartitionedSolver<GooseFEM::PCG<>> Jacobi;
+        GooseFEM::MatrixPartitionedSolver<GooseFEM::PCG<Eigen::IncompleteCholesky<double>>> IC;
+        Jacobi.solver().setTolerance(1e-12);
+        IC.solver().setTolerance(1e-12);
+
+        xt::xtensor<double, 1> y = Jacobi.Solve(A, b, x0);
+        REQUIRE(Jacobi.solver().info() == Eigen::Success);
+        REQUIRE(Jacobi.solver().iterations() > 0);
+        REQUIRE(xt::allclose(y, x));
+
+        auto niter = Jacobi.solver().iterations();
+
+        REQUIRE(xt::allclose(IC.Solve(A, b, x0), x));
+        REQUIRE(IC.solver().iterations() <= niter);
+
+        // warm start: starting from the solution, (almost) no iterations are needed
+        Jacobi.solve(A, b, y);
+        REQUIRE(Jacobi.solver().iterations() < niter);
+        REQUIRE(xt::allclose(y, x));
+
+        // modified Newton: the previous factorization is used as preconditioner
+        GooseFEM::MatrixPartitionedSolver<GooseFEM::PCG<GooseFEM::FactorizationPreconditioner<>>>
+            Factor;
+        Factor.solver().setTolerance(1e-12);
+
+        REQUIRE(xt::allclose(Factor.Solve(A, b, x0), x));
+
+        A.assemble(1.1 * a);
+        b = A.Dot(x);
+
+        REQUIRE(xt::allclose(Factor.Solve(A, b, x0), x));
+        REQUIRE(Factor.solver().preconditioner().nfactor() == 1);
+        REQUIRE(Factor.solver().iterations() > 0);
+
+        // accessing the solver does not trigger a new factorization, "refactorize()" does
+        Factor.solver().preconditioner().refresh();
+
+        REQUIRE(xt::allclose(Factor.Solve(A, b, x0), x));
+        REQUIRE(Factor.solver().preconditioner().nfactor() == 1);
+
+        Factor.refactorize();
+
+        REQUIRE(xt::allclose(Factor.Solve(A, b, x0), x));
+        REQUIRE(Factor.solver().preconditioner().nfactor() == 2);
+        REQUIRE(Factor.solver().iterations() <= 1);
+    }
+
+    SECTION("MatrixPartitionedSolver - PCG, AMG")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(20, 20);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        auto dofs = mesh.dofs();
+        xt::xtensor<size_t, 1> iip = xt::flatten(xt::view(dofs, xt::keep(mesh.nodesBottomEdge())));
+
+        xt::xtensor<double, 3> a = xt::empty<double>({nelem, nne * ndim, nne * ndim});
+
+        for (size_t e = 0; e < nelem; ++e) {
+            xt::xtensor<double, 2> ae = xt::random::rand<double>({nne * ndim, nne * ndim});
+            ae = (ae + xt::transpose(ae)) / 2.0 + double(nne * ndim) * xt::eye<double>(nne * ndim);
+            xt::view(a, e, xt::all(), xt::all()) = ae;
+        }
+
+        GooseFEM::MatrixPartitioned A(mesh.conn(), dofs, iip);
+        A.assemble(a);
+
+        xt::xtensor<double, 1> x = xt::random::rand<double>({A.ndof()});
+        xt::xtensor<double, 1> b = A.Dot(x);
+        xt::xtensor<double, 1> x0 = x;
+        xt::view(x0, xt::keep(A.iiu())) = 0.0;
+
+        GooseFEM::MatrixPartitionedSolver<GooseFEM::PCG<GooseFEM::AMG>> Solver;
+        Solver.solver().setTolerance(1e-12);
+        Solver.solver().preconditioner().setCoarseSize(50);
+        Solver.solver().preconditioner().setRigidBodyModes(mesh.coor(), A.dofs(), A.iiu());
+
+        REQUIRE(xt::allclose(Solver.Solve(A, b, x0), x));
+        REQUIRE(Solver.solver().info() == Eigen::Success);
+        REQUIRE(Solver.solver().preconditioner().nlevel() > 1);
+        REQUIRE(Solver.solver().preconditioner().size(1) < A.nnu());
+    }
+
+    SECTION("MatrixPartitionedSolver - PCG, AMG, periodic")
+    {
+        // homogeneous periodic mesh (origin fixed): the highest modes are (nearly) orthogonal to
+        // any smooth vector, the smoother has to be based on the correct spectral radius
+
+        GooseFEM::Mesh::Quad4::Regular mesh(16, 16);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        auto dofs = mesh.dofsPeriodic();
+        xt::xtensor<size_t, 1> iip = xt::view(dofs, mesh.nodesOrigin(), xt::all());
+
+        xt::xtensor<double, 2> L = {
+            {4.0, -1.0, -2.0, -1.0},
+            {-1.0, 4.0, -1.0, -2.0},
+            {-2.0, -1.0, 4.0, -1.0},
+            {-1.0, -2.0, -1.0, 4.0}};
+
+        xt::xtensor<double, 3> a = xt::zeros<double>({nelem, nne * ndim, nne * ndim});
+
+        for (size_t e = 0; e < nelem; ++e) {
+            for (size_t m = 0; m < nne; ++m) {
+                for (size_t n = 0; n < nne; ++n) {
+                    for (size_t i = 0; i < ndim; ++i) {
+                        a(e, m * ndim + i, n * ndim + i) = L(m, n) / 6.0;
+                    }
+                }
+            }
+        }
+
+        GooseFEM::MatrixPartitioned A(mesh.conn(), dofs, iip);
+        A.assemble(a);
+
+        xt::xtensor<double, 1> x = xt::random::rand<double>({A.ndof()});
+        xt::xtensor<double, 1> b = A.Dot(x);
+        xt::xtensor<double, 1> x0 = x;
+        xt::view(x0, xt::keep(A.iiu())) = 0.0;
+
+        GooseFEM::MatrixPartitionedSolver<GooseFEM::PCG<GooseFEM::AMG>> Solver;
+        Solver.solver().setTolerance(1e-12);
+        Solver.solver().preconditioner().setCoarseSize(50);
+        Solver.solver().preconditioner().setRigidBodyModes(mesh.coor(), dofs, A.iiu());
+
+        REQUIRE(xt::allclose(Solver.Solve(A, b, x0), x));
+        REQUIRE(Solver.solver().info() == Eigen::Success);
+        REQUIRE(Solver.solver().iterations() < 30);
+        REQUIRE(Solver.solver().preconditioner().nlevel() > 1);
+
+        // the preconditioner is positive definite, also for the highest (checkerboard) mode
+        // (with an even number of elements the periodic images have the same sign)
+        xt::xtensor<double, 1> checkerboard = xt::empty<double>({A.ndof()});
+
+        for (size_t m = 0; m < mesh.nnode(); ++m) {
+            size_t ix = m % (mesh.nelx() + 1);
+            size_t iy = m / (mesh.nelx() + 1);
+            for (size_t i = 0; i < ndim; ++i) {
+                checkerboard(dofs(m, i)) = (ix + iy) % 2 == 0 ? 1.0 : -1.0;
+            }
+        }
+
+        auto iiu = A.iiu();
+        Eigen::VectorXd r(A.nnu());
+
+        for (size_t d = 0; d < A.nnu(); ++d) {
+            r(d) = checkerboard(iiu(d));
+        }
+
+        REQUIRE(r.dot(Solver.solver().preconditioner().solve(r)) > 0.0);
+
+        for (size_t i = 0; i < 5; ++i) {
+            Eigen::VectorXd q = Eigen::VectorXd::Random(A.nnu());
+            REQUIRE(q.dot(Solver.solver().preconditioner().solve(q)) > 0.0);
+        }
+    }
+
+    SECTION("MatrixPartitionedSolver - PCG, Multigrid, periodic")
+    {
+        // hierarchy of three periodic meshes, with the origin fixed
+
+        GooseFEM::Mesh::Quad4::Regular mesh2(3, 3);
+        GooseFEM::Mesh::Quad4::Map::RefineRegular map1(mesh2, 2, 2);
+        GooseFEM::Mesh::Quad4::Map::RefineRegular map0(map1.getFineMesh(), 2, 2);
+        GooseFEM::Mesh::Quad4::Regular mesh1 = map1.getFineMesh();
+        GooseFEM::Mesh::Quad4::Regular mesh = map0.getFineMesh();
+
+        auto unknown = [](const GooseFEM::Mesh::Quad4::Regular& m) -> xt::xtensor<size_t, 1> {
+            auto dofs = m.dofsPeriodic();
+            xt::xtensor<size_t, 1> iip = xt::view(dofs, m.nodesOrigin(), xt::all());
+            return xt::setdiff1d(xt::arange<size_t>(xt::amax(dofs)() + 1), iip);
+        };
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        auto dofs = mesh.dofsPeriodic();
+        xt::xtensor<size_t, 1> iip = xt::view(dofs, mesh.nodesOrigin(), xt::all());
+
+        xt::xtensor<double, 3> a = xt::empty<double>({nelem, nne * ndim, nne * ndim});
+
+        for (size_t e = 0; e < nelem; ++e) {
+            xt::xtensor<double, 2> ae = xt::random::rand<double>({nne * ndim, nne * ndim});
+            ae = (ae + xt::transpose(ae)) / 2.0 + double(nne * ndim) * xt::eye<double>(nne * ndim);
+            xt::view(a, e, xt::all(), xt::all()) = ae;
+        }
+
+        GooseFEM::MatrixPartitioned A(mesh.conn(), dofs, iip);
+        A.assemble(a);
+
+        REQUIRE(xt::all(xt::equal(A.iiu(), unknown(mesh))));
+
+        std::vector<Eigen::SparseMatrix<double>> P = {
+            GooseFEM::prolongation(
+                map0, mesh1.dofsPeriodic(), unknown(mesh1), dofs, unknown(mesh)),
+            GooseFEM::prolongation(
+                map1, mesh2.dofsPeriodic(), unknown(mesh2), mesh1.dofsPeriodic(), unknown(mesh1))};
+
+        REQUIRE(static_cast<size_t>(P[0].rows()) == A.nnu());
+
+        xt::xtensor<double, 1> x = xt::random::rand<double>({A.ndof()});
+        xt::xtensor<double, 1> b = A.Dot(x);
+        xt::xtensor<double, 1> x0 = x;
+        xt::view(x0, xt::keep(A.iiu())) = 0.0;
+
+        GooseFEM::MatrixPartitionedSolver<GooseFEM::PCG<GooseFEM::Multigrid>> Solver;
+        Solver.solver().setTolerance(1e-12);
+        Solver.solver().preconditioner().setProlongators(P);
+
+        REQUIRE(xt::allclose(Solver.Solve(A, b, x0), x));
+        REQUIRE(Solver.solver().info() == Eigen::Success);
+        REQUIRE(Solver.solver().preconditioner().nlevel() == 3);
+        REQUIRE(Solver.solver().preconditioner().size(2) == unknown(mesh2).size());
+    }
+
+    SECTION("MatrixPartitionedSolver - PCG, Multigrid, Hex8")
+    {
+        // linear elasticity on a hierarchy of two meshes, with the bottom fixed
+
+        GooseFEM::Mesh::Hex8::Regular mesh1(2, 2, 2);
+        GooseFEM::Mesh::Hex8::Map::RefineRegular map0(mesh1, 2, 2, 2);
+        GooseFEM::Mesh::Hex8::Regular mesh = map0.getFineMesh();
+
+        auto unknown = [](const GooseFEM::Mesh::Hex8::Regular& m) -> xt::xtensor<size_t, 1> {
+            auto dofs = m.dofs();
+            xt::xtensor<size_t, 1> iip = xt::flatten(xt::view(dofs, xt::keep(m.nodesBottom())));
+            return xt::setdiff1d(dofs, iip);
+        };
+
+        auto dofs = mesh.dofs();
+        xt::xtensor<size_t, 1> iip = xt::flatten(xt::view(dofs, xt::keep(mesh.nodesBottom())));
+
+        GooseFEM::Vector vector(mesh.conn(), dofs);
+        GooseFEM::Element::Hex8::Quadrature quad(vector.AsElement(mesh.coor()));
+
+        double K = 1.0;
+        double G = 0.5;
+        xt::xtensor<double, 6> C =
+            xt::empty<double>({mesh.nelem(), quad.nip(), 3ul, 3ul, 3ul, 3ul});
+
+        for (size_t i = 0; i < 3; ++i) {
+            for (size_t j = 0; j < 3; ++j) {
+                for (size_t k = 0; k < 3; ++k) {
+                    for (size_t l = 0; l < 3; ++l) {
+                        double c = (K - 2.0 * G / 3.0) * double(i == j && k == l) +
+                                   G * double(i == k && j == l) + G * double(i == l && j == k);
+                        xt::view(C, xt::all(), xt::all(), i, j, k, l) = c;
+                    }
+                }
+            }
+        }
+
+        GooseFEM::MatrixPartitioned A(mesh.conn(), dofs, iip);
+        A.assemble(quad.Int_gradN_dot_tensor4_dot_gradNT_dV(C));
+
+        REQUIRE(xt::all(xt::equal(A.iiu(), unknown(mesh))));
+
+        std::vector<Eigen::SparseMatrix<double>> P = {GooseFEM::prolongation(
+            map0, mesh1.dofs(), unknown(mesh1), dofs, unknown(mesh))};
+
+        xt::xtensor<double, 1> u = xt::zeros<double>({A.ndof()});
+        xt::xtensor<double, 1> f = xt::random::randn<double>({A.ndof()});
+        xt::view(u, xt::keep(iip)) = xt::random::randn<double>({iip.size()});
+
+        GooseFEM::MatrixPartitionedSolver<> Direct;
+        xt::xtensor<double, 1> x = Direct.Solve(A, f, u);
+
+        GooseFEM::MatrixPartitionedSolver<GooseFEM::PCG<GooseFEM::Multigrid>> Solver;
+        Solver.solver().setTolerance(1e-12);
+        Solver.solver().preconditioner().setProlongators(P);
+
+        REQUIRE(xt::allclose(Solver.Solve(A, f, u), x));
+        REQUIRE(Solver.solver().info() == Eigen::Success);
+        REQUIRE(Solver.solver().iterations() < 30);
+        REQUIRE(Solver.solver().preconditioner().nlevel() == 2);
+        REQUIRE(Solver.solver().preconditioner().size(1) == unknown(mesh1).size());
+    }
+
+    SECTION("MatrixPartitionedSolver - PCG, FFTPreconditioner, periodic")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(6, 5);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        auto dofs = mesh.dofsPeriodic();
+        xt::xtensor<size_t, 1> iip = xt::view(dofs, mesh.nodesOrigin(), xt::all());
+
+        // reference element: Laplacian of each component
+
+        xt::xtensor<double, 2> L = {
+            {4.0, -1.0, -2.0, -1.0},
+            {-1.0, 4.0, -1.0, -2.0},
+            {-2.0, -1.0, 4.0, -1.0},
+            {-1.0, -2.0, -1.0, 4.0}};
+
+        xt::xtensor<double, 2> Ke = xt::zeros<double>({nne * ndim, nne * ndim});
+
+        for (size_t m = 0; m < nne; ++m) {
+            for (size_t n = 0; n < nne; ++n) {
+                for (size_t i = 0; i < ndim; ++i) {
+                    Ke(m * ndim + i, n * ndim + i) = L(m, n) / 6.0;
+                }
+            }
+        }
+
+        // heterogeneous: "a_e = c_e * Ke" with "1 <= c_e <= 2"
+
+        xt::xtensor<double, 1> c = 1.0 + xt::random::rand<double>({nelem});
+        xt::xtensor<double, 3> a = xt::empty<double>({nelem, nne * ndim, nne * ndim});
+
+        for (size_t e = 0; e < nelem; ++e) {
+            xt::view(a, e, xt::all(), xt::all()) = c(e) * Ke;
+        }
+
+        GooseFEM::MatrixPartitioned A(mesh.conn(), dofs, iip);
+        A.assemble(a);
+
+        xt::xtensor<double, 1> x = xt::random::rand<double>({A.ndof()});
+        xt::xtensor<double, 1> b = A.Dot(x);
+        xt::xtensor<double, 1> x0 = x;
+        xt::view(x0, xt::keep(A.iiu())) = 0.0;
+
+        GooseFEM::MatrixPartitionedSolver<GooseFEM::PCG<GooseFEM::FFTPreconditioner>> Solver;
+        Solver.solver().setTolerance(1e-12);
+        Solver.solver().preconditioner().setReference(mesh, dofs, A.iiu(), 1.5 * Ke);
+
+        REQUIRE(xt::allclose(Solver.Solve(A, b, x0), x));
+        REQUIRE(Solver.solver().info() == Eigen::Success);
+        REQUIRE(Solver.solver().iterations() < 30);
+        REQUIRE(Solver.solver().preconditioner().shape() == std::vector<size_t>{6, 5});
+    }
+
+    SECTION("MatrixPartitionedSolver - PCG, FFTPreconditioner, periodic, homogeneous")
+    {
+        // the preconditioner is the exact inverse (one prescribed node)
+
+        GooseFEM::Mesh::Quad4::Regular mesh(6, 5);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        auto dofs = mesh.dofsPeriodic();
+        xt::xtensor<size_t, 1> iip = xt::view(dofs, mesh.nodesOrigin(), xt::all());
+
+        xt::xtensor<double, 2> L = {
+            {4.0, -1.0, -2.0, -1.0},
+            {-1.0, 4.0, -1.0, -2.0},
+            {-2.0, -1.0, 4.0, -1.0},
+            {-1.0, -2.0, -1.0, 4.0}};
+
+        xt::xtensor<double, 2> Ke = xt::zeros<double>({nne * ndim, nne * ndim});
+
+        for (size_t m = 0; m < nne; ++m) {
+            for (size_t n = 0; n < nne; ++n) {
+                for (size_t i = 0; i < ndim; ++i) {
+                    Ke(m * ndim + i, n * ndim + i) = L(m, n) / 6.0;
+                }
+            }
+        }
+
+        xt::xtensor<double, 3> a = xt::empty<double>({nelem, nne * ndim, nne * ndim});
+
+        for (size_t e = 0; e < nelem; ++e) {
+            xt::view(a, e, xt::all(), xt::all()) = Ke;
+        }
+
+        GooseFEM::MatrixPartitioned A(mesh.conn(), dofs, iip);
+        A.assemble(a);
+
+        xt::xtensor<double, 1> x = xt::random::rand<double>({A.ndof()});
+        xt::xtensor<double, 1> b = A.Dot(x);
+        xt::xtensor<double, 1> x0 = x;
+        xt::view(x0, xt::keep(A.iiu())) = 0.0;
+
+        GooseFEM::MatrixPartitionedSolver<GooseFEM::PCG<GooseFEM::FFTPreconditioner>> Solver;
+        Solver.solver().setTolerance(1e-12);
+        Solver.solver().preconditioner().setReference(mesh, dofs, A.iiu(), Ke);
+
+        REQUIRE(xt::allclose(Solver.Solve(A, b, x0), x));
+        REQUIRE(Solver.solver().info() == Eigen::Success);
+        REQUIRE(Solver.solver().iterations() <= 2);
+    }
+
+    SECTION("FFTPreconditioner - detail::FFT")
+    {
+        // compare to the naive transform: radix-2 (8) and Bluestein (5, 6, 7)
+
+        for (size_t n : std::vector<size_t>{1, 5, 6, 7, 8}) {
+            GooseFEM::detail::FFT fft(n);
+            REQUIRE(fft.size() == n);
+
+            xt::xtensor<double, 2> r = xt::random::randn<double>({n, size_t(2)});
+            std::vector<std::complex<double>> x(n);
+            std::vector<std::complex<double>> work;
+
+            for (size_t j = 0; j < n; ++j) {
+                x[j] = std::complex<double>(r(j, 0), r(j, 1));
+            }
+
+            std::vector<std::complex<double>> X = x;
+            fft.forward(X.data(), work);
+
+            for (size_t k = 0; k < n; ++k) {
+                std::complex<double> Xk = 0.0;
+                for (size_t j = 0; j < n; ++j) {
+                    Xk += x[j] * std::polar(1.0, -2.0 * M_PI * double(j * k % n) / double(n));
+                }
+                REQUIRE(std::abs(X[k] - Xk) < 1e-12 * double(n));
+            }
+
+            // the inverse is unnormalized
+            fft.inverse(X.data(), work);
+
+            for (size_t k = 0; k < n; ++k) {
+                REQUIRE(std::abs(X[k] / double(n) - x[k]) < 1e-12);
+            }
+        }
+    }
+
+    SECTION("MatrixPartitionedTyingsSolver - multiple right-hand sides")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(5, 5);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        auto conn = mesh.conn();
+
+        GooseFEM::Tyings::Control control(mesh.coor(), mesh.dofs());
+        auto coor = control.coor();
+        auto dofs = control.dofs();
+        auto control_dofs = control.controlDofs();
+        auto control_nodes = control.controlNodes();
+
+        xt::xtensor<size_t, 1> iip = xt::concatenate(xt::xtuple(
+            xt::reshape_view(control_dofs, {ndim * ndim}),
+            xt::reshape_view(xt::view(dofs, xt::keep(mesh.nodesOrigin()), xt::all()), {ndim})));
+
+        GooseFEM::Tyings::Periodic tyings(coor, dofs, control_dofs, mesh.nodesPeriodic(), iip);
+        dofs = tyings.dofs();
+
+        xt::xtensor<double, 3> a = xt::empty<double>({nelem, nne * ndim, nne * ndim});
+
+        for (size_t e = 0; e < nelem; ++e) {
+            xt::xtensor<double, 2> ae = xt::random::rand<double>({nne * ndim, nne * ndim});
+            ae = (ae + xt::transpose(ae)) / 2.0 + double(nne * ndim) * xt::eye<double>(nne * ndim);
+            xt::view(a, e, xt::all(), xt::all()) = ae;
+        }
+
+        GooseFEM::MatrixPartitionedTyings A(conn, dofs, tyings.Cdu(), tyings.Cdp());
+        A.assemble(a);
+
+        // load cases: each component of the control displacement
+
+        size_t nrhs = ndim * ndim;
+        xt::xtensor<double, 3> b = xt::random::rand<double>({nrhs, coor.shape(0), ndim});
+        xt::xtensor<double, 3> x = xt::zeros<double>({nrhs, coor.shape(0), ndim});
+
+        for (size_t i = 0; i < ndim; ++i) {
+            for (size_t j = 0; j < ndim; ++j) {
+                x(i * ndim + j, control_nodes(i), j) = 1.0;
+            }
+        }
+
+        GooseFEM::MatrixPartitionedTyingsSolver<> Solver;
+        xt::xtensor<double, 3> y = Solver.Solve(A, b, x);
+
+        for (size_t k = 0; k < nrhs; ++k) {
+            xt::xtensor<double, 2> b_k = xt::view(b, k);
+            xt::xtensor<double, 2> x_k = xt::view(x, k);
+            REQUIRE(xt::allclose(xt::view(y, k), Solver.Solve(A, b_k, x_k)));
+        }
+
+        xt::xtensor<double, 2> b_u = xt::random::rand<double>({nrhs, A.nnu()});
+        xt::xtensor<double, 2> b_d = xt::zeros<double>({nrhs, A.nnd()});
+        xt::xtensor<double, 2> x_p = xt::random::rand<double>({nrhs, A.nnp()});
+        xt::xtensor<double, 2> x_u = Solver.Solve_u(A, b_u, b_d, x_p);
+
+        for (size_t k = 0; k < nrhs; ++k) {
+            xt::xtensor<double, 1> b_u_k = xt::view(b_u, k);
+            xt::xtensor<double, 1> b_d_k = xt::view(b_d, k);
+            xt::xtensor<double, 1> x_p_k = xt::view(x_p, k);
+            REQUIRE(xt::allclose(xt::view(x_u, k), Solver.Solve_u(A, b_u_k, b_d_k, x_p_k)));
+        }
+
+        // forces on the dependent DOFs: equal to the solve of the equivalent "nodevec"
+
+        b_d = xt::random::rand<double>({nrhs, A.nnd()});
+        x_u = Solver.Solve_u(A, b_u, b_d, x_p);
+
+        xt::xtensor<double, 3> b_node = xt::zeros<double>({nrhs, coor.shape(0), ndim});
+        xt::xtensor<double, 3> x_node = xt::zeros<double>({nrhs, coor.shape(0), ndim});
+
+        for (size_t k = 0; k < nrhs; ++k) {
+            for (size_t m = 0; m < coor.shape(0); ++m) {
+                for (size_t i = 0; i < ndim; ++i) {
+                    size_t d = dofs(m, i);
+                    if (d < A.nnu()) {
+                        b_node(k, m, i) = b_u(k, d);
+                    }
+                    else if (d < A.nni()) {
+                        x_node(k, m, i) = x_p(k, d - A.nnu());
+                    }
+                    else {
+                        b_node(k, m, i) = b_d(k, d - A.nni());
+                    }
+                }
+            }
+        }
+
+        y = Solver.Solve(A, b_node, x_node);
+
+        for (size_t k = 0; k < nrhs; ++k) {
+            for (size_t m = 0; m < coor.shape(0); ++m) {
+                for (size_t i = 0; i < ndim; ++i) {
+                    if (dofs(m, i) < A.nnu()) {
+                        REQUIRE(std::abs(y(k, m, i) - x_u(k, dofs(m, i))) < 1e-10);
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("MatrixPartitionedTyingsSolver - equilibrium")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(5, 5);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        auto conn = mesh.conn();
+
+        GooseFEM::Tyings::Control control(mesh.coor(), mesh.dofs());
+        auto coor = control.coor();
+        auto dofs = control.dofs();
+        auto control_dofs = control.controlDofs();
+
+        xt::xtensor<size_t, 1> iip = xt::concatenate(xt::xtuple(
+            xt::reshape_view(control_dofs, {ndim * ndim}),
+            xt::reshape_view(xt::view(dofs, xt::keep(mesh.nodesOrigin()), xt::all()), {ndim})));
+
+        GooseFEM::Tyings::Periodic tyings(coor, dofs, control_dofs, mesh.nodesPeriodic(), iip);
+        dofs = tyings.dofs();
+
+        xt::xtensor<double, 3> a = xt::empty<double>({nelem, nne * ndim, nne * ndim});
+
+        for (size_t e = 0; e < nelem; ++e) {
+            xt::xtensor<double, 2> ae = xt::random::rand<double>({nne * ndim, nne * ndim});
+            ae = (ae + xt::transpose(ae)) / 2.0 + double(nne * ndim) * xt::eye<double>(nne * ndim);
+            xt::view(a, e, xt::all(), xt::all()) = ae;
+        }
+
+        GooseFEM::MatrixPartitionedTyings A(conn, dofs, tyings.Cdu(), tyings.Cdp());
+        A.assemble(a);
+
+        GooseFEM::Matrix K(conn, dofs);
+        K.assemble(a);
+
+        GooseFEM::Vector vector(conn, dofs);
+        xt::xtensor<double, 1> b = xt::random::rand<double>({A.ndof()});
+        xt::xtensor<double, 1> x = xt::random::rand<double>({A.ndof()});
+
+        GooseFEM::MatrixPartitionedTyingsSolver<> Solver;
+        x = vector.AsDofs(Solver.Solve(A, vector.AsNode(b), vector.AsNode(x)));
+
+        // the tied displacement: the residual vanishes on the independent unknown DOFs
+        // (including the contribution of the dependent DOFs): "r_u + C_du^T * r_d = 0"
+
+        xt::xtensor<double, 1> r = K.Dot(x) - b;
+        Eigen::Map<Eigen::VectorXd> R(r.data(), r.size());
+        Eigen::VectorXd R_u = R.head(A.nnu()) + tyings.Cdu().transpose() * R.tail(A.nnd());
+
+        REQUIRE(R_u.norm() < 1e-10 * R.norm());
+
+        // the dependent DOFs follow from the independent DOFs
+
+        Eigen::Map<Eigen::VectorXd> X(x.data(), x.size());
+        Eigen::VectorXd X_d =
+            tyings.Cdu() * X.head(A.nnu()) + tyings.Cdp() * X.segment(A.nnu(), A.nnp());
+
+        REQUIRE((X.tail(A.nnd()) - X_d).norm() < 1e-10 * X_d.norm());
+    }
+
+    SECTION("MatrixPartitioned - dot, contiguous")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(5, 5);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        auto dofs = mesh.dofs();
+
+        // prescribed DOFs in the middle of the numbering
+        xt::xtensor<size_t, 1> iip = xt::concatenate(xt::xtuple(
+            xt::flatten(xt::view(dofs, xt::keep(mesh.nodesTopEdge()), xt::all())),
+            xt::flatten(xt::view(dofs, xt::keep(mesh.nodesLeftEdge()), 0))));
+        iip = xt::unique(iip);
+
+        GooseFEM::Mesh::Reorder reorder({xt::setdiff1d(dofs, iip), iip});
+        xt::xtensor<size_t, 2> dofs_c = reorder.get(dofs);
+        xt::xtensor<size_t, 1> iip_c = reorder.apply(iip);
+
+        xt::xtensor<double, 3> a = xt::random::rand<double>({nelem, nne * ndim, nne * ndim});
+
+        GooseFEM::MatrixPartitioned A(mesh.conn(), dofs, iip);
+        GooseFEM::MatrixPartitioned C(mesh.conn(), dofs_c, iip_c);
+        A.assemble(a);
+        C.assemble(a);
+
+        REQUIRE(!A.topology()->contiguous());
+        REQUIRE(C.topology()->contiguous());
+        REQUIRE(C.nnp() > 0);
+        REQUIRE(C.nnu() > 0);
+
+        // dense reference, assembled directly from the element matrices
+        auto conn = mesh.conn();
+        xt::xtensor<double, 2> K = xt::zeros<double>({C.ndof(), C.ndof()});
+
+        for (size_t e = 0; e < nelem; ++e) {
+            for (size_t m = 0; m < nne; ++m) {
+                for (size_t i = 0; i < ndim; ++i) {
+                    for (size_t n = 0; n < nne; ++n) {
+                        for (size_t j = 0; j < ndim; ++j) {
+                            K(dofs_c(conn(e, m), i), dofs_c(conn(e, n), j)) +=
+                                a(e, m * ndim + i, n * ndim + j);
+                        }
+                    }
+                }
+            }
+        }
+
+        REQUIRE(xt::allclose(C.Todense(), K));
+
+        xt::xtensor<double, 1> x = xt::random::rand<double>({C.ndof()});
+        xt::xtensor<double, 1> b = xt::zeros<double>({C.ndof()});
+
+        for (size_t i = 0; i < K.shape(0); ++i) {
+            for (size_t j = 0; j < K.shape(1); ++j) {
+                b(i) += K(i, j) * x(j);
+            }
+        }
+
+        REQUIRE(xt::allclose(C.Dot(x), b));
+
+        // same product in the original numbering (not contiguous)
+        xt::xtensor<double, 1> x_a = xt::empty<double>({A.ndof()});
+        xt::xtensor<double, 1> b_a = xt::empty<double>({A.ndof()});
+
+        for (size_t m = 0; m < mesh.nnode(); ++m) {
+            for (size_t i = 0; i < ndim; ++i) {
+                x_a(dofs(m, i)) = x(dofs_c(m, i));
+                b_a(dofs(m, i)) = b(dofs_c(m, i));
+            }
+        }
+
+        REQUIRE(xt::allclose(A.Dot(x_a), b_a));
+    }
+
+    SECTION("MatrixPartitionedSolver - LowRankUpdate")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(10, 10);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        auto dofs = mesh.dofs();
+        xt::xtensor<size_t, 1> iip = xt::flatten(xt::view(dofs, xt::keep(mesh.nodesBottomEdge())));
+
+        xt::xtensor<double, 3> a = xt::empty<double>({nelem, nne * ndim, nne * ndim});
+
+        for (size_t e = 0; e < nelem; ++e) {
+            xt::xtensor<double, 2> ae = xt::random::rand<double>({nne * ndim, nne * ndim});
+            ae = (ae + xt::transpose(ae)) / 2.0 + double(nne * ndim) * xt::eye<double>(nne * ndim);
+            xt::view(a, e, xt::all(), xt::all()) = ae;
+        }
+
+        GooseFEM::MatrixPartitioned A(mesh.conn(), dofs, iip);
+        A.assemble(a);
+
+        xt::xtensor<double, 1> x = xt::random::rand<double>({A.ndof()});
+        xt::xtensor<double, 1> x0 = x;
+        xt::view(x0, xt::keep(A.iiu())) = 0.0;
+
+        GooseFEM::MatrixPartitionedSolver<GooseFEM::LowRankUpdate<>> Solver;
+        Solver.solver().setMaxRank(50);
+
+        REQUIRE(xt::allclose(Solver.Solve(A, A.Dot(x), x0), x));
+        REQUIRE(Solver.solver().nfactor() == 1);
+
+        // no element changes: no correction
+
+        A.assemble(a);
+
+        REQUIRE(xt::allclose(Solver.Solve(A, A.Dot(x), x0), x));
+        REQUIRE(Solver.solver().nfactor() == 1);
+        REQUIRE(Solver.solver().rank() == 0);
+
+        // a few elements change: correction of the factorization
+
+        for (size_t e : {12, 13, 57}) {
+            xt::view(a, e, xt::all(), xt::all()) *= 0.5;
+        }
+
+        A.assemble(a);
+
+        REQUIRE(xt::allclose(Solver.Solve(A, A.Dot(x), x0), x));
+        REQUIRE(Solver.solver().nfactor() == 1);
+        REQUIRE(Solver.solver().rank() > 0);
+        REQUIRE(Solver.solver().rank() <= 3 * nne * ndim);
+
+        // the elements change back: no correction
+
+        for (size_t e : {12, 13, 57}) {
+            xt::view(a, e, xt::all(), xt::all()) *= 2.0;
+        }
+
+        A.assemble(a);
+
+        REQUIRE(xt::allclose(Solver.Solve(A, A.Dot(x), x0), x));
+        REQUIRE(Solver.solver().nfactor() == 1);
+        REQUIRE(Solver.solver().rank() == 0);
+
+        // many elements change: factorization
+
+        a *= 2.0;
+        A.assemble(a);
+
+        REQUIRE(xt::allclose(Solver.Solve(A, A.Dot(x), x0), x));
+        REQUIRE(Solver.solver().nfactor() == 2);
+        REQUIRE(Solver.solver().rank() == 0);
+    }
+
+    SECTION("MatrixPartitionedSolver - LowRankUpdate, maxRank")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(10, 10);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        auto dofs = mesh.dofs();
+        xt::xtensor<size_t, 1> iip = xt::flatten(xt::view(dofs, xt::keep(mesh.nodesBottomEdge())));
+
+        xt::xtensor<double, 3> a = xt::empty<double>({nelem, nne * ndim, nne * ndim});
+
+        for (size_t e = 0; e < nelem; ++e) {
+            xt::xtensor<double, 2> ae = xt::random::rand<double>({nne * ndim, nne * ndim});
+            ae = (ae + xt::transpose(ae)) / 2.0 + double(nne * ndim) * xt::eye<double>(nne * ndim);
+            xt::view(a, e, xt::all(), xt::all()) = ae;
+        }
+
+        GooseFEM::MatrixPartitioned A(mesh.conn(), dofs, iip);
+        A.assemble(a);
+
+        xt::xtensor<double, 1> x = xt::random::rand<double>({A.ndof()});
+        xt::xtensor<double, 1> x0 = x;
+        xt::view(x0, xt::keep(A.iiu())) = 0.0;
+
+        GooseFEM::MatrixPartitionedSolver<GooseFEM::LowRankUpdate<>> Solver;
+        Solver.solver().setMaxRank(50);
+
+        REQUIRE(Solver.solver().maxRank() == 50);
+        REQUIRE(xt::allclose(Solver.Solve(A, A.Dot(x), x0), x));
+        REQUIRE(Solver.solver().nfactor() == 1);
+
+        // one element at a time changes (and changes back): only the last is in the correction,
+        // but the DOFs affected before still count towards "maxRank"
+        // (the elements do not share nodes, and have no prescribed DOFs: 8 DOFs each)
+
+        std::vector<size_t> elems = {22, 25, 28, 52, 55, 58, 82};
+
+        for (size_t i = 0; i < elems.size(); ++i) {
+            xt::xtensor<double, 3> b = a;
+            xt::view(b, elems[i], xt::all(), xt::all()) *= 0.5;
+            A.assemble(b);
+
+            REQUIRE(xt::allclose(Solver.Solve(A, A.Dot(x), x0), x));
+
+            if (8 * (i + 1) <= Solver.solver().maxRank()) {
+                REQUIRE(Solver.solver().nfactor() == 1);
+                REQUIRE(Solver.solver().rank() == nne * ndim);
+            }
+            else {
+                REQUIRE(Solver.solver().nfactor() == 2);
+                REQUIRE(Solver.solver().rank() == 0);
+            }
+        }
+    }
 }
@@ -25,6 +25,35 @@ TEST_CASE("GooseFEM::Mesh", "Mesh.h")
         REQUIRE(xt::all(xt::equal(xt::view(overlap, 1, xt::all()), overlap_b)));
     }
 
+    SECTION("SpatialHash")
+    {
+        xt::xtensor<double, 2> coor_a = xt::random::rand<double>({100, 2});
+        xt::xtensor<double, 2> coor_b = xt::random::rand<double>({200, 2});
+        xt::view(coor_b, xt::range(0, 50), xt::all()) = xt::view(coor_a, xt::range(50, 100), xt::all());
+        xt::view(coor_b, xt::range(150, 200), xt::all()) = xt::view(coor_a, xt::range(0, 50), xt::all());
+
+        std::vector<size_t> ret_a;
+        std::vector<size_t> ret_b;
+
+        for (size_t i = 0; i < coor_a.shape(0); ++i) {
+            for (size_t j = 0; j < coor_b.shape(0); ++j) {
+                if (xt::all(xt::isclose(xt::view(coor_b, j), xt::view(coor_a, i), 1e-5, 1e-8))) {
+                    ret_a.push_back(i);
+                    ret_b.push_back(j);
+                }
+            }
+        }
+
+        GooseFEM::Mesh::SpatialHash index(coor_b, 0.1);
+        auto overlap = index.overlapping(coor_a);
+
+        REQUIRE(index.size() == coor_b.shape(0));
+        REQUIRE(overlap.shape(1) == ret_a.size());
+        REQUIRE(xt::all(xt::equal(xt::view(overlap, 0, xt::all()), xt::adapt(ret_a))));
+        REQUIRE(xt::all(xt::equal(xt::view(overlap, 1, xt::all()), xt::adapt(ret_b))));
+        REQUIRE(xt::all(xt::equal(GooseFEM::Mesh::overlapping(coor_a, coor_b), overlap)));
+    }
+
     SECTION("ManualStitch")
     {
         GooseFEM::Mesh::Quad4::Regular mesh(5, 5, 1.0);
@@ -98,6 +127,23 @@ TEST_CASE("GooseFEM::Mesh", "Mesh.h")
         REQUIRE(xt::all(xt::equal(stitch.elemset({eset, eset}), xt::arange<size_t>(2 * 5 * 5))));
     }
 
+    SECTION("Stitch - many")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(5, 5, 1.0);
+        GooseFEM::Mesh::Stitch stitch;
+
+        for (size_t i = 0; i < 10; ++i) {
+            auto coor = mesh.coor();
+            xt::view(coor, xt::all(), 1) += 5.0 * static_cast<double>(i);
+            stitch.push_back(coor, mesh.conn());
+        }
+
+        GooseFEM::Mesh::Quad4::Regular res(5, 50, 1.0);
+
+        REQUIRE(xt::allclose(stitch.coor(), res.coor()));
+        REQUIRE(xt::all(xt::equal(stitch.conn(), res.conn())));
+    }
+
     SECTION("edgesize")
     {
         GooseFEM::Mesh::Quad4::Regular mesh(2, 2, 10.0);
@@ -150,6 +196,237 @@ TEST_CASE("GooseFEM::Mesh", "Mesh.h")
         REQUIRE(tonode[15] == std::vector<size_t>{8});
     }
 
+    SECTION("Elem2Node")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+        auto conn = mesh.conn();
+        auto tonode = GooseFEM::Mesh::elem2node(conn);
+        GooseFEM::Mesh::Elem2Node csr(conn);
+
+        xt::xtensor<size_t, 1> offsets =
+            {0, 1, 3, 5, 6, 8, 12, 16, 18, 20, 24, 28, 30, 31, 33, 35, 36};
+
+        REQUIRE(csr.nnode() == 16);
+        REQUIRE(csr.size() == conn.size());
+        REQUIRE(xt::all(xt::equal(csr.offsets(), offsets)));
+
+        for (size_t n = 0; n < csr.nnode(); ++n) {
+            REQUIRE(csr.coordination(n) == tonode[n].size());
+            for (size_t i = csr.offsets()(n); i < csr.offsets()(n + 1); ++i) {
+                REQUIRE(csr.elem()(i) == tonode[n][i - csr.offsets()(n)]);
+                REQUIRE(conn(csr.elem()(i), csr.local()(i)) == n);
+            }
+        }
+    }
+
+    SECTION("Elem2Elem - Quad4")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+        GooseFEM::Mesh::Elem2Elem edge(mesh.conn(), GooseFEM::Mesh::Adjacency::Edge);
+        GooseFEM::Mesh::Elem2Elem node(mesh.conn(), GooseFEM::Mesh::Adjacency::Node);
+
+        auto row = [](const GooseFEM::Mesh::Elem2Elem& graph, size_t e) {
+            auto& offsets = graph.offsets();
+            auto& elem = graph.elem();
+            return std::vector<size_t>(elem.cbegin() + offsets(e), elem.cbegin() + offsets(e + 1));
+        };
+
+        REQUIRE(edge.nelem() == 9);
+        REQUIRE(edge.size() == 24);
+        REQUIRE(row(edge, 0) == std::vector<size_t>{1, 3});
+        REQUIRE(row(edge, 4) == std::vector<size_t>{1, 3, 5, 7});
+        REQUIRE(row(edge, 5) == std::vector<size_t>{2, 4, 8});
+
+        REQUIRE(node.size() == 40);
+        REQUIRE(row(node, 0) == std::vector<size_t>{1, 3, 4});
+        REQUIRE(row(node, 4) == std::vector<size_t>{0, 1, 2, 3, 5, 6, 7, 8});
+        REQUIRE(node.degree(5) == 5);
+    }
+
+    SECTION("Elem2Elem - Tri3")
+    {
+        xt::xtensor<size_t, 2> conn = {
+            {0, 1, 2},
+            {1, 3, 2},
+            {3, 4, 5}};
+
+        GooseFEM::Mesh::Elem2Elem edge(conn, GooseFEM::Mesh::Adjacency::Edge);
+        GooseFEM::Mesh::Elem2Elem node(conn, GooseFEM::Mesh::Adjacency::Node);
+
+        xt::xtensor<size_t, 1> edge_offsets = {0, 1, 2, 2};
+        xt::xtensor<size_t, 1> edge_elem = {1, 0};
+        xt::xtensor<size_t, 1> node_offsets = {0, 1, 3, 4};
+        xt::xtensor<size_t, 1> node_elem = {1, 0, 2, 1};
+
+        REQUIRE(xt::all(xt::equal(edge.offsets(), edge_offsets)));
+        REQUIRE(xt::all(xt::equal(edge.elem(), edge_elem)));
+        REQUIRE(xt::all(xt::equal(node.offsets(), node_offsets)));
+        REQUIRE(xt::all(xt::equal(node.elem(), node_elem)));
+    }
+
+    SECTION("Elem2Elem - Hex8")
+    {
+        GooseFEM::Mesh::Hex8::Regular mesh(2, 2, 2);
+        auto conn = mesh.conn();
+
+        GooseFEM::Mesh::Elem2Elem face(conn, GooseFEM::Mesh::Adjacency::Face);
+        GooseFEM::Mesh::Elem2Elem edge(conn, GooseFEM::Mesh::Adjacency::Edge);
+        GooseFEM::Mesh::Elem2Elem node(conn, GooseFEM::Mesh::Adjacency::Node);
+
+        for (size_t e = 0; e < 8; ++e) {
+            REQUIRE(face.degree(e) == 3);
+            REQUIRE(edge.degree(e) == 6);
+            REQUIRE(node.degree(e) == 7);
+        }
+
+        xt::xtensor<size_t, 1> face_elem = {1, 2, 4};
+        xt::xtensor<size_t, 1> edge_elem = {1, 2, 3, 4, 5, 6};
+
+        REQUIRE(xt::all(xt::equal(xt::view(face.elem(), xt::range(0, 3)), face_elem)));
+        REQUIRE(xt::all(xt::equal(xt::view(edge.elem(), xt::range(0, 6)), edge_elem)));
+    }
+
+    SECTION("Coloring")
+    {
+        auto check = [](const xt::xtensor<size_t, 2>& conn,
+                        const GooseFEM::Mesh::Coloring& coloring) {
+            GooseFEM::Mesh::Elem2Elem graph(conn, GooseFEM::Mesh::Adjacency::Node);
+            auto& color = coloring.color();
+            REQUIRE(coloring.nelem() == conn.shape(0));
+            REQUIRE(coloring.offsets()(coloring.ncolor()) == conn.shape(0));
+            for (size_t e = 0; e < graph.nelem(); ++e) {
+                for (size_t i = graph.offsets()(e); i < graph.offsets()(e + 1); ++i) {
+                    REQUIRE(color(e) != color(graph.elem()(i)));
+                }
+            }
+            for (size_t c = 0; c < coloring.ncolor(); ++c) {
+                for (size_t i = coloring.offsets()(c); i < coloring.offsets()(c + 1); ++i) {
+                    REQUIRE(color(coloring.elem()(i)) == c);
+                }
+            }
+        };
+
+        GooseFEM::Mesh::Quad4::Regular quad(6, 4);
+        GooseFEM::Mesh::Quad4::FineLayer layer(27, 27);
+        GooseFEM::Mesh::Hex8::Regular hex(4, 4, 4);
+
+        check(quad.conn(), GooseFEM::Mesh::coloring(quad.conn()));
+        check(layer.conn(), GooseFEM::Mesh::coloring(layer.conn()));
+        check(hex.conn(), GooseFEM::Mesh::coloring(hex.conn()));
+        check(quad.conn(), quad.coloring());
+        check(hex.conn(), hex.coloring());
+
+        REQUIRE(GooseFEM::Mesh::coloring(quad.conn()).ncolor() == 4);
+        REQUIRE(quad.coloring().ncolor() == 4);
+        REQUIRE(hex.coloring().ncolor() == 8);
+
+        for (size_t c = 0; c < 4; ++c) {
+            REQUIRE(quad.coloring().size(c) == 6);
+        }
+
+        for (size_t c = 0; c < 8; ++c) {
+            REQUIRE(hex.coloring().size(c) == 8);
+        }
+    }
+
+    SECTION("Partition")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(8, 8);
+        auto coor = mesh.coor();
+        auto conn = mesh.conn();
+        auto elmat = mesh.elementgrid();
+
+        GooseFEM::Mesh::Partition partition(coor, conn, 4);
+
+        REQUIRE(partition.npart() == 4);
+        REQUIRE(partition.interface().size() == 17);
+
+        for (size_t p = 0; p < 4; ++p) {
+            auto elem = partition.elem(p);
+            auto nodemap = partition.nodemap(p);
+            auto local = partition.conn(p);
+            REQUIRE(partition.size(p) == 16);
+            REQUIRE(nodemap.size() == 25);
+            REQUIRE(partition.interface(p).size() == 9);
+            for (size_t i = 0; i < elem.size(); ++i) {
+                for (size_t m = 0; m < conn.shape(1); ++m) {
+                    REQUIRE(nodemap(local(i, m)) == conn(elem(i), m));
+                }
+            }
+        }
+
+        REQUIRE(xt::all(xt::equal(
+            partition.elem(0),
+            xt::flatten(xt::view(elmat, xt::range(0, 4), xt::range(0, 4))))));
+    }
+
+    SECTION("Partition - unbalanced")
+    {
+        GooseFEM::Mesh::Hex8::Regular mesh(4, 5, 3);
+        GooseFEM::Mesh::Partition partition(mesh.coor(), mesh.conn(), 7);
+
+        size_t n = 0;
+
+        for (size_t p = 0; p < 7; ++p) {
+            REQUIRE(partition.size(p) >= 8);
+            REQUIRE(partition.size(p) <= 9);
+            n += partition.size(p);
+        }
+
+        REQUIRE(n == mesh.nelem());
+        REQUIRE(partition.offsets()(7) == mesh.nelem());
+    }
+
+    SECTION("Hex8::Regular - lazy")
+    {
+        GooseFEM::Mesh::Hex8::Regular mesh(3, 4, 5, 2.0);
+        auto coor = mesh.coor();
+        auto conn = mesh.conn();
+
+        REQUIRE(xt::allclose(mesh.coor(0, mesh.nnode()), coor));
+        REQUIRE(xt::all(xt::equal(mesh.conn(0, mesh.nelem()), conn)));
+        REQUIRE(xt::all(xt::equal(mesh.conn(7, 19), xt::view(conn, xt::range(7, 19), xt::all()))));
+
+        for (size_t n = 0; n < mesh.nnode(); ++n) {
+            auto x = mesh.coor(n);
+            for (size_t i = 0; i < mesh.ndim(); ++i) {
+                ISCLOSE(x[i], coor(n, i));
+            }
+        }
+
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            auto nodes = mesh.element_nodes(e);
+            for (size_t m = 0; m < mesh.nne(); ++m) {
+                REQUIRE(nodes[m] == conn(e, m));
+            }
+        }
+
+        REQUIRE(mesh.node(0, 0, 0) == mesh.nodesOrigin());
+        REQUIRE(mesh.element(2, 3, 4) == mesh.nelem() - 1);
+    }
+
+    SECTION("Hex8::FineLayer - blocks")
+    {
+        GooseFEM::Mesh::Hex8::FineLayer mesh(9, 17, 27);
+        auto coor = mesh.coor();
+        auto conn = mesh.conn();
+        size_t nnode = mesh.nnode();
+        size_t nelem = mesh.nelem();
+
+        REQUIRE(xt::allclose(mesh.coor(0, nnode), coor));
+        REQUIRE(xt::all(xt::equal(mesh.conn(0, nelem), conn)));
+
+        for (size_t i = 0; i < nnode; i += 97) {
+            size_t j = std::min(i + 131, nnode);
+            REQUIRE(xt::allclose(mesh.coor(i, j), xt::view(coor, xt::range(i, j), xt::all())));
+        }
+
+        for (size_t i = 0; i < nelem; i += 89) {
+            size_t j = std::min(i + 113, nelem);
+            REQUIRE(xt::all(xt::equal(mesh.conn(i, j), xt::view(conn, xt::range(i, j), xt::all()))));
+        }
+    }
+
     SECTION("elemmap2nodemap")
     {
         GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
@@ -365,4 +642,43 @@ TEST_CASE("GooseFEM::Mesh", "Mesh.h")
             REQUIRE(xt::all(xt::equal(nodeval_r2, xt::view(nodeval, xt::keep(nodemap)))));
         }
     }
+
+    SECTION("Permutation - FineLayer::roll")
+    {
+        GooseFEM::Mesh::Quad4::FineLayer mesh(6, 18);
+        size_t nelem = mesh.nelem();
+        size_t nnode = mesh.nnode();
+
+        xt::xtensor<double, 1> elemvar = xt::random::rand<double>({nelem});
+        xt::xtensor<double, 3> qpvar = xt::random::rand<double>({nelem, size_t(4), size_t(2)});
+        xt::xtensor<int, 2> ivar = xt::random::randint<int>({nelem, size_t(3)});
+        xt::xtensor<double, 2> nodevar = xt::random::rand<double>({nnode, size_t(2)});
+
+        auto elemmap = mesh.roll(2);
+        auto nodemap = GooseFEM::Mesh::elemmap2nodemap(elemmap, mesh.coor(), mesh.conn());
+
+        xt::xtensor<double, 1> elemvar_r = xt::view(elemvar, xt::keep(elemmap));
+        xt::xtensor<double, 3> qpvar_r = xt::view(qpvar, xt::keep(elemmap));
+        xt::xtensor<int, 2> ivar_r = xt::view(ivar, xt::keep(elemmap));
+        xt::xtensor<double, 2> nodevar_r = xt::view(nodevar, xt::keep(nodemap));
+
+        // compose "roll(1)" twice
+        auto r1 = mesh.rollElem(1);
+        auto perm = r1.compose(r1);
+        REQUIRE(xt::all(xt::equal(perm.index(), elemmap)));
+
+        perm.apply(elemvar, qpvar, ivar);
+        REQUIRE(xt::allclose(elemvar, elemvar_r));
+        REQUIRE(xt::allclose(qpvar, qpvar_r));
+        REQUIRE(xt::all(xt::equal(ivar, ivar_r)));
+
+        auto nperm = mesh.rollNode(2);
+        nperm.apply(nodevar);
+        REQUIRE(xt::allclose(nodevar, nodevar_r));
+
+        // undo
+        perm.inverse().apply(qpvar);
+        xt::xtensor<double, 3> qpvar_u = xt::view(qpvar_r, xt::keep(perm.inverse().index()));
+        REQUIRE(xt::allclose(qpvar, qpvar_u));
+    }
 }
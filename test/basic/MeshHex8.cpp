@@ -0,0 +1,129 @@
+
+#include <catch2/catch.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xmath.hpp>
+#include <GooseFEM/GooseFEM.h>
+
+TEST_CASE("GooseFEM::MeshHex8", "MeshHex8.h")
+{
+    SECTION("Regular - lazy")
+    {
+        // "h" not exactly representable: the output should nevertheless be identical
+        GooseFEM::Mesh::Hex8::Regular mesh(3, 2, 4, 0.1);
+        auto coor = mesh.coor();
+        auto conn = mesh.conn();
+
+        REQUIRE(xt::all(xt::equal(mesh.coor(0, mesh.nnode()), coor)));
+        REQUIRE(xt::all(xt::equal(mesh.coor(4, 10), xt::view(coor, xt::range(4, 10), xt::all()))));
+        REQUIRE(xt::all(xt::equal(mesh.conn(0, mesh.nelem()), conn)));
+
+        for (size_t n = 0; n < mesh.nnode(); ++n) {
+            auto x = mesh.coor(n);
+            for (size_t i = 0; i < 3; ++i) {
+                REQUIRE(x[i] == coor(n, i));
+            }
+        }
+
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            auto nodes = mesh.element_nodes(e);
+            for (size_t m = 0; m < mesh.nne(); ++m) {
+                REQUIRE(nodes[m] == conn(e, m));
+            }
+        }
+    }
+
+    SECTION("Map::RefineRegular")
+    {
+        GooseFEM::Mesh::Hex8::Regular mesh(3, 2, 2);
+
+        GooseFEM::Mesh::Hex8::Map::RefineRegular refine(mesh, 2, 3, 2);
+
+        REQUIRE(refine.getFineMesh().nelem() == 12 * mesh.nelem());
+
+        xt::xtensor<double, 1> a = xt::random::rand<double>({mesh.nelem()});
+        auto a_ = refine.mapToCoarse(refine.mapToFine(a));
+
+        REQUIRE(xt::allclose(a, xt::mean(a_, {1})));
+
+        xt::xtensor<double, 2> b =
+            xt::random::rand<double>(std::array<size_t, 2>{mesh.nelem(), 8ul});
+        auto b_ = refine.mapToCoarse(refine.mapToFine(b));
+
+        REQUIRE(xt::allclose(xt::mean(b, {1}), xt::mean(b_, {1})));
+
+        xt::xtensor<double, 4> c =
+            xt::random::rand<double>(std::array<size_t, 4>{mesh.nelem(), 8ul, 3ul, 3ul});
+        auto c_ = refine.mapToCoarse(refine.mapToFine(c));
+
+        REQUIRE(xt::allclose(xt::mean(c, {1}), xt::mean(c_, {1})));
+    }
+
+    SECTION("Map::RefineRegular - mapToFine")
+    {
+        GooseFEM::Mesh::Hex8::Regular mesh(3, 2, 2);
+
+        GooseFEM::Mesh::Hex8::Map::RefineRegular refine(mesh, 2, 3, 2);
+
+        xt::xtensor<double, 2> b =
+            xt::random::rand<double>(std::array<size_t, 2>{mesh.nelem(), 8ul});
+        auto b_ = refine.mapToFine(b);
+        auto map = refine.getMap();
+
+        for (size_t i = 0; i < map.shape(0); ++i) {
+            for (size_t j = 0; j < map.shape(1); ++j) {
+                REQUIRE(xt::all(xt::equal(xt::view(b_, map(i, j)), xt::view(b, i))));
+            }
+        }
+    }
+
+    SECTION("Map::RefineRegular - prolongation")
+    {
+        // the prolongation reproduces a linear field exactly
+
+        GooseFEM::Mesh::Hex8::Regular mesh(3, 2, 2);
+
+        std::array<size_t, 3> n = {2, 3, 2};
+        GooseFEM::Mesh::Hex8::Map::RefineRegular refine(mesh, n[0], n[1], n[2]);
+        GooseFEM::Mesh::Hex8::Regular fine = refine.getFineMesh();
+
+        auto coor = mesh.coor();
+        auto dofs = mesh.dofs();
+        auto coor_fine = fine.coor();
+        auto dofs_fine = fine.dofs();
+
+        xt::xtensor<double, 2> grad = xt::random::randn<double>({3ul, 3ul});
+        xt::xtensor<double, 1> offset = xt::random::randn<double>({3ul});
+
+        Eigen::VectorXd u(mesh.nnode() * 3);
+        Eigen::VectorXd u_fine(fine.nnode() * 3);
+
+        for (size_t m = 0; m < mesh.nnode(); ++m) {
+            for (size_t i = 0; i < 3; ++i) {
+                u(dofs(m, i)) = offset(i);
+                for (size_t d = 0; d < 3; ++d) {
+                    u(dofs(m, i)) += grad(i, d) * coor(m, d);
+                }
+            }
+        }
+
+        // the fine mesh has the element size of the coarse mesh
+        for (size_t m = 0; m < fine.nnode(); ++m) {
+            for (size_t i = 0; i < 3; ++i) {
+                u_fine(dofs_fine(m, i)) = offset(i);
+                for (size_t d = 0; d < 3; ++d) {
+                    u_fine(dofs_fine(m, i)) += grad(i, d) * coor_fine(m, d) / double(n[d]);
+                }
+            }
+        }
+
+        Eigen::SparseMatrix<double> P = GooseFEM::prolongation(refine, dofs, dofs_fine);
+
+        REQUIRE(static_cast<size_t>(P.rows()) == fine.nnode() * 3);
+        REQUIRE(static_cast<size_t>(P.cols()) == mesh.nnode() * 3);
+        REQUIRE((P * u - u_fine).norm() < 1e-10 * u_fine.norm());
+
+        // partition of unity
+        Eigen::VectorXd one = P * Eigen::VectorXd::Ones(P.cols());
+        REQUIRE(one.isApprox(Eigen::VectorXd::Ones(P.rows())));
+    }
+}
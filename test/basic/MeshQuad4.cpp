@@ -133,6 +133,36 @@ TEST_CASE("GooseFEM::MeshQuad4", "MeshQuad4.h")
         REQUIRE(xt::all(xt::equal(dofsPeriodic, dofsPeriodic_)));
     }
 
+    SECTION("Regular - lazy")
+    {
+        // "h" not exactly representable: the output should nevertheless be identical
+        GooseFEM::Mesh::Quad4::Regular mesh(5, 3, 0.1);
+        auto coor = mesh.coor();
+        auto conn = mesh.conn();
+
+        REQUIRE(xt::all(xt::equal(mesh.coor(0, mesh.nnode()), coor)));
+        REQUIRE(xt::all(xt::equal(mesh.coor(4, 10), xt::view(coor, xt::range(4, 10), xt::all()))));
+        REQUIRE(xt::all(xt::equal(mesh.conn(0, mesh.nelem()), conn)));
+        REQUIRE(xt::all(xt::equal(mesh.conn(3, 7), xt::view(conn, xt::range(3, 7), xt::all()))));
+
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            auto nodes = mesh.element_nodes(e);
+            for (size_t m = 0; m < mesh.nne(); ++m) {
+                REQUIRE(nodes[m] == conn(e, m));
+            }
+        }
+
+        for (size_t n = 0; n < mesh.nnode(); ++n) {
+            auto x = mesh.coor(n);
+            REQUIRE(x[0] == coor(n, 0));
+            REQUIRE(x[1] == coor(n, 1));
+        }
+
+        REQUIRE(mesh.node(0, 0) == mesh.nodesBottomLeftCorner());
+        REQUIRE(mesh.node(5, 3) == mesh.nodesTopRightCorner());
+        REQUIRE(mesh.element(4, 2) == mesh.elementgrid()(2, 4));
+    }
+
     SECTION("FineLayer")
     {
         xt::xtensor<double, 2> coor_ = {
@@ -319,6 +349,46 @@ TEST_CASE("GooseFEM::MeshQuad4", "MeshQuad4.h")
         REQUIRE(xt::all(xt::equal(dofsPeriodic, dofsPeriodic_)));
     }
 
+    SECTION("Regular - cache")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(5, 3);
+        GooseFEM::Mesh::Quad4::Regular ref(5, 3);
+
+        const auto& coor = mesh.coor();
+        const auto& dofsPeriodic = mesh.dofsPeriodic();
+
+        REQUIRE(&coor == &mesh.coor());
+        REQUIRE(&dofsPeriodic == &mesh.dofsPeriodic());
+
+        mesh.clear_cache();
+
+        REQUIRE(xt::allclose(mesh.coor(), ref.coor()));
+        REQUIRE(xt::all(xt::equal(mesh.conn(), ref.conn())));
+        REQUIRE(xt::all(xt::equal(mesh.dofsPeriodic(), ref.dofsPeriodic())));
+    }
+
+    SECTION("FineLayer - blocks")
+    {
+        GooseFEM::Mesh::Quad4::FineLayer mesh(27, 27);
+        auto coor = mesh.coor();
+        auto conn = mesh.conn();
+        size_t nnode = mesh.nnode();
+        size_t nelem = mesh.nelem();
+
+        REQUIRE(xt::allclose(mesh.coor(0, nnode), coor));
+        REQUIRE(xt::all(xt::equal(mesh.conn(0, nelem), conn)));
+
+        for (size_t i = 0; i < nnode; i += 17) {
+            size_t j = std::min(i + 23, nnode);
+            REQUIRE(xt::allclose(mesh.coor(i, j), xt::view(coor, xt::range(i, j), xt::all())));
+        }
+
+        for (size_t i = 0; i < nelem; i += 13) {
+            size_t j = std::min(i + 29, nelem);
+            REQUIRE(xt::all(xt::equal(mesh.conn(i, j), xt::view(conn, xt::range(i, j), xt::all()))));
+        }
+    }
+
     SECTION("FineLayer::elementgrid_ravel - uniform")
     {
         GooseFEM::Mesh::Quad4::FineLayer mesh(5, 5);
@@ -671,4 +741,44 @@ TEST_CASE("GooseFEM::MeshQuad4", "MeshQuad4.h")
 
         REQUIRE(xt::allclose(c, c_));
     }
+
+    SECTION("Map::RefineRegular - mapToFine")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(5, 4);
+
+        GooseFEM::Mesh::Quad4::Map::RefineRegular refine(mesh, 5, 3);
+
+        xt::xtensor<double, 2> b =
+            xt::random::rand<double>(std::array<size_t, 2>{mesh.nelem(), 4ul});
+        auto b_ = refine.mapToFine(b);
+        auto map = refine.getMap();
+
+        for (size_t i = 0; i < map.shape(0); ++i) {
+            for (size_t j = 0; j < map.shape(1); ++j) {
+                REQUIRE(xt::all(xt::equal(xt::view(b_, map(i, j)), xt::view(b, i))));
+            }
+        }
+    }
+
+    SECTION("Map::FineLayer2Regular - refinement")
+    {
+        GooseFEM::Mesh::Quad4::FineLayer mesh(6, 18);
+
+        GooseFEM::Mesh::Quad4::Map::FineLayer2Regular map(mesh);
+        auto regular = map.getRegularMesh();
+        auto elem = map.getMap();
+        auto frac = map.getMapFraction();
+
+        xt::xtensor<double, 2> b =
+            xt::random::rand<double>(std::array<size_t, 2>{mesh.nelem(), 4ul});
+        xt::xtensor<double, 2> b_ = xt::zeros<double>({regular.nelem(), size_t(4)});
+
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            for (size_t i = 0; i < elem[e].size(); ++i) {
+                xt::view(b_, elem[e][i]) += frac[e][i] * xt::view(b, e);
+            }
+        }
+
+        REQUIRE(xt::allclose(map.mapToRegular(b), b_));
+    }
 }
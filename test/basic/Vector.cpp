@@ -166,4 +166,35 @@ TEST_CASE("GooseFEM::Vector", "Vector.h")
         ISCLOSE(F(6), 0);
         ISCLOSE(F(7), 0);
     }
+
+    SECTION("Subset")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+        GooseFEM::Vector vector(mesh.conn(), mesh.dofsPeriodic());
+
+        xt::xtensor<size_t, 1> elem = {1, 4, 8};
+        xt::xtensor<size_t, 2> conn = xt::view(mesh.conn(), xt::keep(elem));
+
+        GooseFEM::Vector sub = vector.Subset(elem);
+        GooseFEM::Vector copy(conn, mesh.dofsPeriodic());
+
+        xt::xtensor<double, 2> u = xt::random::rand<double>({mesh.nnode(), mesh.ndim()});
+        xt::xtensor<double, 1> U = vector.AsDofs(u);
+        xt::xtensor<double, 3> ue = sub.AsElement(U);
+
+        REQUIRE(sub.nelem() == elem.size());
+        REQUIRE(sub.ndof() == vector.ndof());
+        REQUIRE(xt::has_shape(sub.AllocateElemvec(), ue.shape()));
+        REQUIRE(xt::allclose(ue, copy.AsElement(U)));
+        REQUIRE(xt::allclose(ue, xt::view(vector.AsElement(U), xt::keep(elem))));
+        REQUIRE(xt::allclose(sub.AsElement(u), copy.AsElement(u)));
+        REQUIRE(xt::allclose(sub.AssembleDofs(ue), copy.AssembleDofs(ue)));
+        REQUIRE(xt::allclose(sub.AssembleNode(ue), copy.AssembleNode(ue)));
+
+        xt::xtensor<size_t, 1> nested = {0, 2};
+        xt::xtensor<size_t, 1> elem_nested = {1, 8};
+        xt::xtensor<double, 3> ve = vector.Subset(elem_nested).AsElement(U);
+
+        REQUIRE(xt::allclose(sub.Subset(nested).AsElement(U), ve));
+    }
 }
@@ -65,4 +65,117 @@ TEST_CASE("GooseFEM::VectorPartitioned", "VectorPartitioned.h")
         vector.copy_p(u, v);
         REQUIRE(xt::allclose(u, v));
     }
+
+    SECTION("Topology")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(9, 9);
+
+        auto dofs = mesh.dofs();
+        auto nodesTop = mesh.nodesTopEdge();
+        auto nodesBottom = mesh.nodesBottomEdge();
+
+        size_t ni = nodesBottom.size();
+        xt::xtensor<size_t, 1> iip = xt::empty<size_t>({2 * ni});
+        xt::view(iip, xt::range(0 * ni, 1 * ni)) = xt::view(dofs, xt::keep(nodesTop), 1);
+        xt::view(iip, xt::range(1 * ni, 2 * ni)) = xt::view(dofs, xt::keep(nodesBottom), 1);
+
+        auto topo = std::make_shared<const GooseFEM::Topology>(mesh.conn(), dofs, iip);
+        GooseFEM::VectorPartitioned vector(topo);
+        GooseFEM::VectorPartitioned ref(mesh.conn(), dofs, iip);
+        GooseFEM::MatrixDiagonalPartitioned M(topo);
+
+        REQUIRE(vector.topology() == M.topology());
+        REQUIRE(vector.nnu() == ref.nnu());
+        REQUIRE(vector.nnp() == ref.nnp());
+        REQUIRE(xt::all(xt::equal(vector.iiu(), ref.iiu())));
+        REQUIRE(xt::all(xt::equal(vector.iip(), ref.iip())));
+
+        xt::xtensor<double, 2> u = xt::random::randn<double>({mesh.nnode(), mesh.ndim()});
+        REQUIRE(xt::allclose(vector.AsDofs_u(u), ref.AsDofs_u(u)));
+        REQUIRE(xt::allclose(vector.AsDofs_p(u), ref.AsDofs_p(u)));
+        REQUIRE(xt::allclose(vector.AsElement(u), ref.AsElement(u)));
+
+        // precomputed DOF-numbers per element (optional)
+
+        auto elem = std::make_shared<const GooseFEM::Topology>(mesh.conn(), dofs, iip, true);
+        GooseFEM::VectorPartitioned velem(elem);
+
+        REQUIRE(!topo->elementwise());
+        REQUIRE(elem->elementwise());
+
+        auto conn = mesh.conn();
+        auto part = topo->part();
+        auto elemdofs = elem->elemdofs();
+        auto elempart = elem->elempart();
+
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            for (size_t m = 0; m < mesh.nne(); ++m) {
+                for (size_t i = 0; i < mesh.ndim(); ++i) {
+                    REQUIRE(elemdofs(e, m * mesh.ndim() + i) == dofs(conn(e, m), i));
+                    REQUIRE(elempart(e, m * mesh.ndim() + i) == part(conn(e, m), i));
+                    REQUIRE(elem->elemdofs(e, m, i) == dofs(conn(e, m), i));
+                    REQUIRE(elem->elempart(e, m, i) == part(conn(e, m), i));
+                    REQUIRE(topo->elemdofs(e, m, i) == dofs(conn(e, m), i));
+                    REQUIRE(topo->elempart(e, m, i) == part(conn(e, m), i));
+                }
+            }
+        }
+
+        xt::xtensor<double, 3> ue = vector.AsElement(u);
+        REQUIRE(xt::all(xt::equal(velem.AsElement(u), ue)));
+        REQUIRE(xt::all(xt::equal(velem.AsDofs_u(ue), vector.AsDofs_u(ue))));
+        REQUIRE(xt::all(xt::equal(velem.AssembleDofs(ue), vector.AssembleDofs(ue))));
+
+        // "index_type" arrays are moved in (no copy)
+        xt::xtensor<GooseFEM::index_type, 2> conn_i = mesh.conn();
+        xt::xtensor<GooseFEM::index_type, 2> dofs_i = dofs;
+        xt::xtensor<GooseFEM::index_type, 1> iip_i = iip;
+        const GooseFEM::index_type* ptr_conn = conn_i.data();
+        const GooseFEM::index_type* ptr_dofs = dofs_i.data();
+        const GooseFEM::index_type* ptr_iip = iip_i.data();
+
+        GooseFEM::Topology moved(std::move(conn_i), std::move(dofs_i), std::move(iip_i));
+
+        REQUIRE(moved.conn().data() == ptr_conn);
+        REQUIRE(moved.dofs().data() == ptr_dofs);
+        REQUIRE(moved.iip().data() == ptr_iip);
+        REQUIRE(xt::all(xt::equal(moved.iiu(), topo->iiu())));
+    }
+
+    SECTION("contiguous")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(9, 9);
+
+        auto dofs = mesh.dofs();
+        auto nodesTop = mesh.nodesTopEdge();
+        auto nodesBottom = mesh.nodesBottomEdge();
+
+        size_t ni = nodesBottom.size();
+        xt::xtensor<size_t, 1> iip = xt::empty<size_t>({2 * ni});
+        xt::view(iip, xt::range(0 * ni, 1 * ni)) = xt::view(dofs, xt::keep(nodesTop), 1);
+        xt::view(iip, xt::range(1 * ni, 2 * ni)) = xt::view(dofs, xt::keep(nodesBottom), 1);
+        iip = xt::sort(iip);
+
+        xt::xtensor<size_t, 1> iiu = xt::setdiff1d(dofs, iip);
+        GooseFEM::Mesh::Reorder reorder({iiu, iip});
+
+        GooseFEM::VectorPartitioned ref(mesh.conn(), dofs, iip);
+        GooseFEM::VectorPartitioned vector(mesh.conn(), reorder.get(dofs), reorder.apply(iip));
+
+        REQUIRE(!ref.contiguous());
+        REQUIRE(vector.contiguous());
+
+        xt::xtensor<double, 2> u = xt::random::randn<double>({mesh.nnode(), mesh.ndim()});
+        xt::xtensor<double, 1> u_dofs = vector.AsDofs(u);
+
+        REQUIRE(xt::allclose(vector.View_u(u_dofs), ref.AsDofs_u(u)));
+        REQUIRE(xt::allclose(vector.View_p(u_dofs), ref.AsDofs_p(u)));
+        REQUIRE(xt::allclose(vector.AsDofs_u(u_dofs), ref.AsDofs_u(u)));
+        REQUIRE(xt::allclose(vector.AsDofs_p(u_dofs), ref.AsDofs_p(u)));
+        REQUIRE(xt::allclose(vector.AsNode(vector.AsDofs(ref.AsDofs_u(u), ref.AsDofs_p(u))), u));
+
+        vector.View_p(u_dofs) = 0.0;
+        REQUIRE(xt::all(xt::equal(vector.AsDofs_p(u_dofs), 0.0)));
+        REQUIRE(xt::allclose(vector.AsDofs_u(u_dofs), ref.AsDofs_u(u)));
+    }
 }
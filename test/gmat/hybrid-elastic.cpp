@@ -334,4 +334,94 @@ TEST_CASE("hybrid-elastic", "GooseFEM.h")
         }
     }
 
+    SECTION("Vector/Quadrature - Subset")
+    {
+        size_t N = 5;
+        GooseFEM::Mesh::Quad4::Regular mesh(N, N);
+        size_t nelem = mesh.nelem();
+        xt::xtensor<size_t, 1> elem_a = xt::arange<size_t>(N, 2 * N);
+        xt::xtensor<size_t, 1> elem_b = xt::concatenate(xt::xtuple(
+            xt::arange<size_t>(N),
+            xt::arange<size_t>(2 * N, nelem)));
+        size_t nelem_a = elem_a.size();
+        size_t nelem_b = elem_b.size();
+
+        auto dofs = mesh.dofsPeriodic();
+        auto conn = mesh.conn();
+        xt::xtensor<size_t, 2> conn_a = xt::view(conn, xt::keep(elem_a), xt::all());
+        xt::xtensor<size_t, 2> conn_b = xt::view(conn, xt::keep(elem_b), xt::all());
+
+        GooseFEM::Vector vector(conn, dofs);
+        GooseFEM::Vector vector_a(conn_a, dofs);
+        GooseFEM::Vector vector_b(conn_b, dofs);
+        GooseFEM::Vector sub_a = vector.Subset(elem_a);
+        GooseFEM::Vector sub_b = vector.Subset(elem_b);
+
+        auto coor = mesh.coor();
+
+        GooseFEM::Element::Quad4::QuadraturePlanar quad(vector.AsElement(coor));
+        GooseFEM::Element::Quad4::QuadraturePlanar quad_a(vector_a.AsElement(coor));
+        GooseFEM::Element::Quad4::QuadraturePlanar quad_b(vector_b.AsElement(coor));
+        GooseFEM::Element::Quad4::QuadraturePlanar qsub_a = quad.Subset(elem_a);
+        GooseFEM::Element::Quad4::QuadraturePlanar qsub_b = quad.Subset(elem_b);
+        size_t nip = quad.nip();
+
+        GMatElastic::Cartesian3d::Array<2> mat_a({nelem_a, nip}, 3.0, 4.0);
+        GMatElastic::Cartesian3d::Array<2> mat_b({nelem_b, nip}, 5.0, 6.0);
+
+        REQUIRE(qsub_a.nelem() == nelem_a);
+        REQUIRE(qsub_b.nelem() == nelem_b);
+        REQUIRE(xt::allclose(qsub_a.dV(), quad_a.dV()));
+        REQUIRE(xt::allclose(qsub_b.dV(), quad_b.dV()));
+        REQUIRE(xt::allclose(qsub_a.GradN(), quad_a.GradN()));
+        REQUIRE(xt::allclose(qsub_b.GradN(), quad_b.GradN()));
+
+        for (size_t iter = 0; iter < 10; ++iter) {
+
+            xt::xtensor<double, 2> disp = xt::random::rand<double>(coor.shape());
+
+            xt::xtensor<double, 3> ue_a = vector_a.AsElement(disp);
+            xt::xtensor<double, 3> ue_b = vector_b.AsElement(disp);
+
+            REQUIRE(xt::allclose(sub_a.AsElement(disp), ue_a));
+            REQUIRE(xt::allclose(sub_b.AsElement(disp), ue_b));
+
+            auto Eps_a = quad_a.SymGradN_vector(ue_a);
+            auto Eps_b = quad_b.SymGradN_vector(ue_b);
+
+            REQUIRE(xt::allclose(qsub_a.SymGradN_vector(ue_a), Eps_a));
+            REQUIRE(xt::allclose(qsub_b.SymGradN_vector(ue_b), Eps_b));
+
+            mat_a.setStrain(Eps_a);
+            mat_b.setStrain(Eps_b);
+
+            auto Sig_a = mat_a.Stress();
+            auto Sig_b = mat_b.Stress();
+            auto C_a = mat_a.Tangent();
+            auto C_b = mat_b.Tangent();
+
+            REQUIRE(xt::allclose(
+                sub_a.AssembleDofs(qsub_a.Int_gradN_dot_tensor2_dV(Sig_a)),
+                vector_a.AssembleDofs(quad_a.Int_gradN_dot_tensor2_dV(Sig_a))));
+            REQUIRE(xt::allclose(
+                sub_b.AssembleDofs(qsub_b.Int_gradN_dot_tensor2_dV(Sig_b)),
+                vector_b.AssembleDofs(quad_b.Int_gradN_dot_tensor2_dV(Sig_b))));
+            REQUIRE(xt::allclose(
+                qsub_a.Int_gradN_dot_tensor4_dot_gradNT_dV(C_a),
+                quad_a.Int_gradN_dot_tensor4_dot_gradNT_dV(C_a)));
+            REQUIRE(xt::allclose(
+                qsub_b.Int_gradN_dot_tensor4_dot_gradNT_dV(C_b),
+                quad_b.Int_gradN_dot_tensor4_dot_gradNT_dV(C_b)));
+
+            // deform: update the full objects, the subsets follow
+            xt::xtensor<double, 2> x = coor + 0.01 * disp;
+            quad.update_x(vector.AsElement(x));
+            quad_a.update_x(vector_a.AsElement(x));
+            quad_b.update_x(vector_b.AsElement(x));
+
+            REQUIRE(xt::allclose(qsub_a.dV(), quad_a.dV()));
+            REQUIRE(xt::allclose(qsub_b.dV(), quad_b.dV()));
+        }
+    }
+
 }